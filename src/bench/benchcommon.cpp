@@ -0,0 +1,259 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "benchcommon.h"
+
+#include "lgui/layout/flowlayout.h"
+#include "lgui/layout/hboxlayout.h"
+#include "lgui/layout/relativelayout.h"
+#include "lgui/layout/simpletablelayout.h"
+#include "lgui/layout/vboxlayout.h"
+#include "lgui/platform/events.h"
+#include "lgui/widgets/checkbox.h"
+#include "lgui/widgets/labels/textlabel.h"
+#include "lgui/widgets/pushbutton.h"
+#include "lgui/widgets/textfield.h"
+
+#include <cmath>
+
+const char* corpus_name(Corpus c) {
+    switch (c) {
+        case Corpus::Prose: return "prose";
+        case Corpus::LongWords: return "long_words";
+        case Corpus::Utf8: return "utf8";
+        case Corpus::ShortLines: return "short_lines";
+    }
+    return "";
+}
+
+static int rnd(BenchRng& rng, int lo, int hi) {
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+static void append_word(std::string& out, BenchRng& rng, int min_len, int max_len, bool utf8) {
+    static const char* const non_ascii[] = {"\xc3\xa4", "\xc3\xb6", "\xc3\x9f", "\xc3\xa9", "\xd0\xb6",
+                                            "\xce\xbb", "\xe6\x97\xa5", "\xe6\x9c\xac", "\xe2\x82\xac",
+                                            "\xf0\x9f\x98\x80"};
+    int len = rnd(rng, min_len, max_len);
+    for (int i = 0; i < len; ++i) {
+        if (utf8 && rnd(rng, 0, 2) == 0)
+            out += non_ascii[rnd(rng, 0, 9)];
+        else
+            out += char('a' + rnd(rng, 0, 25));
+    }
+}
+
+static void append_paragraph(std::string& out, BenchRng& rng, bool utf8) {
+    int sentences = rnd(rng, 3, 6);
+    for (int s = 0; s < sentences; ++s) {
+        int words = rnd(rng, 5, 20);
+        for (int w = 0; w < words; ++w) {
+            append_word(out, rng, 1, 12, utf8);
+            out += (w == words - 1) ? ". " : (rnd(rng, 0, 9) == 0 ? ", " : " ");
+        }
+    }
+    out.back() = '\n';
+}
+
+std::string make_corpus(Corpus c, size_t bytes, unsigned seed) {
+    BenchRng rng(seed);
+    std::string out;
+    out.reserve(bytes + 256);
+    while (out.size() < bytes) {
+        switch (c) {
+            case Corpus::Prose:
+            case Corpus::Utf8:
+                append_paragraph(out, rng, c == Corpus::Utf8);
+                break;
+            case Corpus::LongWords:
+                append_word(out, rng, 20, 80, false);
+                out += ' ';
+                break;
+            case Corpus::ShortLines: {
+                int words = rnd(rng, 1, 4);
+                for (int w = 0; w < words; ++w) {
+                    append_word(out, rng, 1, 8, false);
+                    out += (w == words - 1) ? '\n' : ' ';
+                }
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+std::string make_document(int lines, unsigned seed) {
+    BenchRng rng(seed);
+    std::string out;
+    for (int l = 0; l < lines; ++l) {
+        int words = rnd(rng, 2, 16);
+        for (int w = 0; w < words; ++w) {
+            append_word(out, rng, 1, 12, false);
+            out += (w == words - 1) ? '\n' : ' ';
+        }
+    }
+    if (!out.empty())
+        out.pop_back();
+    return out;
+}
+
+static lgui::ExternalEvent make_event(lgui::ExternalEvent::EventType type) {
+    lgui::advance_time(0.001);
+    lgui::ExternalEvent e{};
+    e.type = type;
+    e.timestamp = lgui::get_time();
+    return e;
+}
+
+void push_key_char(lgui::GUI& gui, lgui::KeyCode code, int unichar, int modifiers) {
+    lgui::ExternalEvent e = make_event(lgui::ExternalEvent::EVENT_KEY_CHAR);
+    e.key.code = code;
+    e.key.unichar = unichar;
+    e.key.modifiers = modifiers;
+    gui.push_external_event(e);
+}
+
+void push_mouse(lgui::GUI& gui, lgui::ExternalEvent::EventType type, int x, int y, int button) {
+    lgui::ExternalEvent e = make_event(type);
+    e.mouse.x = x;
+    e.mouse.y = y;
+    e.mouse.button = button;
+    gui.push_external_event(e);
+}
+
+void push_timer_tick(lgui::GUI& gui) {
+    static int64_t count = 0;
+    lgui::ExternalEvent e = make_event(lgui::ExternalEvent::EVENT_TIMER_TICK);
+    e.timer.count = count++;
+    gui.push_external_event(e);
+}
+
+const char* tree_layout_name(TreeLayout tl) {
+    switch (tl) {
+        case TreeLayout::Flow: return "flow";
+        case TreeLayout::SimpleTable: return "simple_table";
+        case TreeLayout::Relative: return "relative";
+        case TreeLayout::NestedBoxes: return "nested_boxes";
+    }
+    return "";
+}
+
+static lgui::Widget& make_leaf(WidgetTree& tree, int idx) {
+    std::string caption = std::to_string(idx);
+    lgui::Widget* w = nullptr;
+    switch (idx % 4) {
+        case 0: w = new lgui::PushButton("Button " + caption); break;
+        case 1: w = new lgui::CheckBox("Check " + caption); break;
+        case 2: w = new lgui::TextLabel("Label " + caption); break;
+        default: w = new lgui::TextField("Text " + caption); break;
+    }
+    tree.widgets.emplace_back(w);
+    return *w;
+}
+
+template<class L>
+static L& make_layout(WidgetTree& tree) {
+    L* l = new L;
+    tree.layouts.emplace_back(l);
+    return *l;
+}
+
+static lgui::Container& make_container(WidgetTree& tree, lgui::Layout& layout) {
+    auto* c = new lgui::Container;
+    tree.widgets.emplace_back(c);
+    c->set_layout(&layout);
+    return *c;
+}
+
+std::unique_ptr<WidgetTree> make_widget_tree(TreeLayout tl, int n) {
+    std::unique_ptr<WidgetTree> tree(new WidgetTree);
+    tree->widgets.reserve(n + n / 4);
+    switch (tl) {
+        case TreeLayout::Flow: {
+            auto& flow = make_layout<lgui::FlowLayout>(*tree);
+            for (int i = 0; i < n; ++i)
+                flow.add_item(make_leaf(*tree, i));
+            tree->root.set_layout(&flow);
+            break;
+        }
+        case TreeLayout::SimpleTable: {
+            auto& table = make_layout<lgui::SimpleTableLayout>(*tree);
+            int cols = std::max(1, int(std::ceil(std::sqrt(n))));
+            table.resize(cols, (n + cols - 1) / cols);
+            for (int i = 0; i < n; ++i)
+                table.add_item(i % cols, i / cols, make_leaf(*tree, i));
+            tree->root.set_layout(&table);
+            break;
+        }
+        case TreeLayout::Relative: {
+            using Constraint = lgui::RelativeLayout::Constraint;
+            auto& rel = make_layout<lgui::RelativeLayout>(*tree);
+            // Rows of 10, each item placed relative to its left or upper neighbor.
+            std::vector<lgui::Widget*> items;
+            for (int i = 0; i < n; ++i) {
+                lgui::Widget& w = make_leaf(*tree, i);
+                if (i == 0)
+                    rel.add_item(w, {{Constraint::AlignParentLeft}, {Constraint::AlignParentTop}});
+                else if (i % 10 == 0)
+                    rel.add_item(w, {{Constraint::AlignLeft, *items[i - 10]}, {Constraint::Below, *items[i - 10]}});
+                else
+                    rel.add_item(w, {{Constraint::RightOf, *items[i - 1]}, {Constraint::AlignTop, *items[i - 1]}});
+                items.push_back(&w);
+            }
+            tree->root.set_layout(&rel);
+            break;
+        }
+        case TreeLayout::NestedBoxes: {
+            auto& outer = make_layout<lgui::VBoxLayout>(*tree);
+            for (int i = 0; i < n; ) {
+                auto& hbox = make_layout<lgui::HBoxLayout>(*tree);
+                for (int col = 0; col < 2 && i < n; ++col) {
+                    auto& vbox = make_layout<lgui::VBoxLayout>(*tree);
+                    for (int row = 0; row < 4 && i < n; ++row, ++i)
+                        vbox.add_item(make_leaf(*tree, i));
+                    hbox.add_item(make_container(*tree, vbox), 1);
+                }
+                outer.add_item(make_container(*tree, hbox));
+            }
+            tree->root.set_layout(&outer);
+            break;
+        }
+    }
+    return tree;
+}
@@ -0,0 +1,99 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_BENCH_BENCHCOMMON_H
+#define LGUI_BENCH_BENCHCOMMON_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lgui/gui.h"
+#include "lgui/platform/font.h"
+#include "lgui/platform/keycodes.h"
+#include "lgui/layout/layout.h"
+#include "lgui/widgets/container.h"
+
+/** The font the style has been set up with (see lguibench.cpp). */
+const lgui::Font& bench_font();
+
+/** A random number generator with a fixed seed, so every run generates the same data. */
+using BenchRng = std::mt19937;
+
+/** Generated text corpora. All are deterministic for a given `seed`. */
+enum class Corpus {
+    Prose,     /**< words of 1-12 letters, punctuation, a paragraph every few sentences */
+    LongWords, /**< few spaces; many words wider than the wrap width */
+    Utf8,      /**< prose mixing 2-, 3- and 4-byte code points */
+    ShortLines /**< many short lines, no wrapping needed */
+};
+const char* corpus_name(Corpus c);
+std::string make_corpus(Corpus c, size_t bytes, unsigned seed = 1);
+
+/** A document of `lines` lines of prose, each a paragraph of its own. */
+std::string make_document(int lines, unsigned seed = 1);
+
+/** Feed an event of a given type to the GUI, timestamped with the headless clock, which is advanced by one
+ *  millisecond for each event. */
+void push_key_char(lgui::GUI& gui, lgui::KeyCode code, int unichar, int modifiers = 0);
+void push_mouse(lgui::GUI& gui, lgui::ExternalEvent::EventType type, int x, int y, int button = 0);
+void push_timer_tick(lgui::GUI& gui);
+
+/** A container with a generated widget tree: `n` leaf widgets of mixed types arranged by a layout. The tree
+ *  owns the widgets and layouts below `root`. */
+struct WidgetTree {
+    // Declared in this order so that root goes first and the layouts last.
+    std::vector<std::unique_ptr<lgui::Layout>> layouts;
+    std::vector<std::unique_ptr<lgui::Widget>> widgets;
+    lgui::Container root;
+};
+
+enum class TreeLayout {
+    Flow,
+    SimpleTable,
+    Relative,
+    NestedBoxes /**< groups of 8 leaves: containers in a VBox, each with an HBox of two containers with a
+                     VBox of 4 leaves */
+};
+const char* tree_layout_name(TreeLayout tl);
+std::unique_ptr<WidgetTree> make_widget_tree(TreeLayout tl, int n);
+
+#endif // LGUI_BENCH_BENCHCOMMON_H
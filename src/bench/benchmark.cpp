@@ -0,0 +1,165 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+
+#include "lgui/platform/error.h"
+
+int Bench::no_samples = 10;
+double Bench::min_sample_ms = 20.0;
+
+static double run_ns(const std::function<void()>& op, int64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < iterations; ++i)
+        op();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+void Bench::set_counter(const std::string& name, double value) {
+    for (auto& c : mcounters) {
+        if (c.first == name) {
+            c.second = value;
+            return;
+        }
+    }
+    mcounters.emplace_back(name, value);
+}
+
+void Bench::measure(const std::function<void()>& op) {
+    ASSERT(msamples.empty());
+    // Find an iteration count that makes a sample last at least min_sample_ms; this also warms up caches.
+    int64_t iterations = 1;
+    double ns = run_ns(op, iterations);
+    while (ns < min_sample_ms * 1e6 && iterations < (int64_t(1) << 40)) {
+        double factor = ns > 0 ? std::min(10.0, 1.5 * min_sample_ms * 1e6 / ns) : 10.0;
+        iterations = std::max(iterations + 1, int64_t(iterations * factor));
+        ns = run_ns(op, iterations);
+    }
+    for (int i = 0; i < no_samples; ++i)
+        msamples.push_back({iterations, run_ns(op, iterations) / iterations});
+}
+
+void BenchmarkRegistry::add(const std::string& name, Function f) {
+    mbenchmarks.emplace_back(name, std::move(f));
+}
+
+void BenchmarkRegistry::run(const std::string& filter, std::ostream& log) {
+    mresults.clear();
+    for (const auto& b : mbenchmarks) {
+        if (!filter.empty() && b.first.find(filter) == std::string::npos)
+            continue;
+        log << b.first << "... " << std::flush;
+        Bench bench(b.first);
+        b.second(bench);
+        if (bench.samples().empty()) {
+            lgui::warning("Benchmark %s didn't measure anything", b.first.c_str());
+            continue;
+        }
+        double best = bench.samples().front().ns_per_iteration;
+        for (const auto& s : bench.samples())
+            best = std::min(best, s.ns_per_iteration);
+        log << best / 1000.0 << " us" << std::endl;
+        mresults.push_back(std::move(bench));
+    }
+}
+
+void BenchmarkRegistry::list(std::ostream& os) const {
+    for (const auto& b : mbenchmarks)
+        os << b.first << "\n";
+}
+
+static void write_json_string(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) >= 0x20)
+            os << c;
+    }
+    os << '"';
+}
+
+void BenchmarkRegistry::write_json(std::ostream& os) const {
+    os << "{\n  \"backend\": \"headless\",\n";
+    os << "  \"samples\": " << Bench::no_samples << ",\n";
+    os << "  \"min_sample_ms\": " << Bench::min_sample_ms << ",\n";
+    os << "  \"benchmarks\": [";
+    bool first = true;
+    for (const Bench& b : mresults) {
+        std::vector<double> ns;
+        for (const auto& s : b.samples())
+            ns.push_back(s.ns_per_iteration);
+        std::sort(ns.begin(), ns.end());
+        double mean = 0.0, var = 0.0;
+        for (double v : ns)
+            mean += v;
+        mean /= ns.size();
+        for (double v : ns)
+            var += (v - mean) * (v - mean);
+        double median = ns.size() % 2 ? ns[ns.size() / 2] : (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]) / 2;
+
+        os << (first ? "\n" : ",\n") << "    {\"name\": ";
+        first = false;
+        write_json_string(os, b.name());
+        os << ", \"iterations\": " << b.samples().front().iterations
+           << ", \"min_ns\": " << ns.front() << ", \"median_ns\": " << median
+           << ", \"mean_ns\": " << mean << ", \"max_ns\": " << ns.back()
+           << ", \"stddev_ns\": " << std::sqrt(var / ns.size());
+        if (b.items() > 0)
+            os << ", \"items\": " << b.items() << ", \"items_per_second\": " << b.items() * 1e9 / median;
+        if (!b.counters().empty()) {
+            os << ", \"counters\": {";
+            for (size_t i = 0; i < b.counters().size(); ++i) {
+                if (i > 0)
+                    os << ", ";
+                write_json_string(os, b.counters()[i].first);
+                os << ": " << b.counters()[i].second;
+            }
+            os << "}";
+        }
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
@@ -0,0 +1,115 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_BENCH_BENCHMARK_H
+#define LGUI_BENCH_BENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** The state passed to a benchmark function. The function does its (untimed) setup, then calls measure() once
+ *  with the operation to time. The operation is run repeatedly; it should leave the state it works on as it
+ *  found it, so that every run does the same work. */
+class Bench {
+    public:
+        explicit Bench(const std::string& name)
+                : mname(name), mitems(0) {}
+
+        const std::string& name() const { return mname; }
+
+        /** Set the number of items (bytes, widgets, events, ...) processed by one run of the operation. Used
+         *  to report a throughput. */
+        void set_items(int64_t items) { mitems = items; }
+        int64_t items() const { return mitems; }
+
+        /** Attach a value describing the work done by one run, e.g. the number of draw commands. */
+        void set_counter(const std::string& name, double value);
+        const std::vector<std::pair<std::string, double>>& counters() const { return mcounters; }
+
+        /** Time `op`. Must be called exactly once. */
+        void measure(const std::function<void()>& op);
+
+        struct Sample {
+            int64_t iterations;
+            double ns_per_iteration;
+        };
+        const std::vector<Sample>& samples() const { return msamples; }
+
+        /** Configuration shared by all benchmarks. */
+        static int no_samples;
+        static double min_sample_ms;
+
+    private:
+        std::string mname;
+        int64_t mitems;
+        std::vector<std::pair<std::string, double>> mcounters;
+        std::vector<Sample> msamples;
+};
+
+/** A list of named benchmark functions that can be run and have their results written as JSON. */
+class BenchmarkRegistry {
+    public:
+        using Function = std::function<void(Bench&)>;
+
+        void add(const std::string& name, Function f);
+
+        /** Run all benchmarks whose name contains `filter` (all if it is empty), in the order they were added.
+         *  Progress is printed to `log`. */
+        void run(const std::string& filter, std::ostream& log);
+
+        void list(std::ostream& os) const;
+
+        /** Write the results of the last run. */
+        void write_json(std::ostream& os) const;
+
+    private:
+        std::vector<std::pair<std::string, Function>> mbenchmarks;
+        std::vector<Bench> mresults;
+};
+
+void add_text_benchmarks(BenchmarkRegistry& reg);
+void add_layout_benchmarks(BenchmarkRegistry& reg);
+void add_event_benchmarks(BenchmarkRegistry& reg);
+void add_draw_benchmarks(BenchmarkRegistry& reg);
+
+#endif // LGUI_BENCH_BENCHMARK_H
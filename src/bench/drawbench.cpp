@@ -0,0 +1,243 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "benchmark.h"
+#include "benchcommon.h"
+
+#include "lgui/profiler.h"
+#include "lgui/renderthread.h"
+#include "lgui/platform/error.h"
+#include "lgui/platform/graphics.h"
+#include "lgui/platform/headless/hldevice.h"
+#include "lgui/widgets/labels/textlabel.h"
+
+enum class FrameMode {
+    Full, IdleDamageTracking, DrawListReplay
+};
+
+static const char* frame_mode_name(FrameMode mode) {
+    switch (mode) {
+        case FrameMode::Full:
+            return "full";
+        case FrameMode::IdleDamageTracking:
+            return "idle_damage_tracking";
+        case FrameMode::DrawListReplay:
+            return "draw_list_replay";
+    }
+    return "?";
+}
+
+// When the library is instrumented, report the profiler's counters for the frame just drawn: how many widgets
+// had their draw() methods run and how many commands were replayed from draw lists instead.
+static void set_profile_counters(Bench& b) {
+#ifdef LGUI_ENABLE_PROFILING
+    lgui::Profiler& profiler = lgui::Profiler::instance();
+    profiler.next_frame();
+    const lgui::Profiler::Frame& f = profiler.frame(profiler.frames_recorded() - 1);
+    for (auto counter : {lgui::Profiler::WidgetsDrawn, lgui::Profiler::DrawListCommands,
+                         lgui::Profiler::DrawListsRecorded})
+        b.set_counter(lgui::Profiler::counter_name(counter), double(f.counters[counter]));
+#else
+    (void) b;
+#endif
+}
+
+static void add_frame(BenchmarkRegistry& reg, TreeLayout tl, int n, FrameMode mode) {
+    std::string name = std::string("draw/frame/") + tree_layout_name(tl) + "/" + std::to_string(n) + "/" +
+                       frame_mode_name(mode);
+    reg.add(name, [tl, n, mode](Bench& b) {
+        lgui::HLDevice& device = lgui::HLDevice::get();
+        device.set_display_size(1024, 576);
+        device.set_recording(false);
+        lgui::Graphics gfx;
+        lgui::GUI gui;
+        gui.set_damage_tracking(mode == FrameMode::IdleDamageTracking);
+        auto tree = make_widget_tree(tl, n);
+        tree->root.set_size(1024, 576);
+        // The whole tree is static, so every frame replays the commands recorded by the first one.
+        tree->root.set_cache_as_draw_list(mode == FrameMode::DrawListReplay);
+        gui.push_top_widget(tree->root);
+        auto frame = [&]() {
+            // With damage tracking, the GUI clears the damaged area itself.
+            if (!gui.is_damage_tracking_enabled())
+                gfx.clear(lgui::rgb(0, 0, 0));
+            gui.draw_widgets(gfx);
+            gfx.flip();
+        };
+        // With damage tracking, only the first frame draws anything; the benchmark shows the cost of finding
+        // out that there is nothing to do.
+        frame();
+        b.measure(frame);
+
+        device.reset();
+        frame();
+        const lgui::HLDrawStats& s = device.stats();
+        b.set_counter("draw_commands", s.total_commands());
+        b.set_counter("draw_calls", s.draw_calls);
+        b.set_counter("invisible_commands", s.invisible);
+        b.set_counter("pixels", double(s.pixels));
+        set_profile_counters(b);
+
+        gui.pop_top_widget();
+        device.reset();
+        device.set_recording(true);
+    });
+}
+
+// A label inside a tree cached as a layer or a draw list changes its text to one of the same width every frame,
+// with damage tracking enabled: the cost of redrawing the cache for a small change. That the new text is drawn
+// at all is checked by lgui_check.
+static void add_label_repaint(BenchmarkRegistry& reg, bool draw_list) {
+    std::string name = std::string("draw/label_repaint/") + (draw_list ? "draw_list" : "layer");
+    reg.add(name, [draw_list](Bench& b) {
+        lgui::HLDevice& device = lgui::HLDevice::get();
+        device.set_display_size(1024, 576);
+        device.set_recording(false);
+        lgui::Graphics gfx;
+        lgui::GUI gui;
+        gui.set_damage_tracking(true);
+        auto tree = make_widget_tree(TreeLayout::Flow, 100);
+        tree->root.set_size(1024, 576);
+        if (draw_list)
+            tree->root.set_cache_as_draw_list(true);
+        else
+            tree->root.set_cache_as_layer(true);
+        // Every fourth leaf, starting with the third one, is a label.
+        auto* label = dynamic_cast<lgui::TextLabel*>(tree->widgets[2].get());
+        ASSERT(label);
+        gui.push_top_widget(tree->root);
+        const std::string texts[2] = {"Label 2", "Lebal 2"}; // same letters, same width
+        int current = 0;
+        auto frame = [&]() {
+            current = 1 - current;
+            label->set_text(texts[current]);
+            gui.draw_widgets(gfx);
+            gfx.flip();
+        };
+        frame();
+        b.measure(frame);
+
+        device.reset();
+        frame();
+        int text_commands = device.stats().commands[lgui::HLDrawCommand::Text];
+        b.set_counter("text_commands", text_commands);
+        set_profile_counters(b);
+
+        gui.pop_top_widget();
+        device.reset();
+        device.set_recording(true);
+    });
+}
+
+// Recording a snapshot of the frame, as RenderThread::submit_frame() does, without a render thread replaying it
+// concurrently: the part of the cost of draw/render_thread that is spent on the GUI thread.
+static void add_record_frame(BenchmarkRegistry& reg, TreeLayout tl, int n) {
+    std::string name = std::string("draw/record/") + tree_layout_name(tl) + "/" + std::to_string(n);
+    reg.add(name, [tl, n](Bench& b) {
+        lgui::HLDevice& device = lgui::HLDevice::get();
+        device.set_display_size(1024, 576);
+        device.set_recording(false);
+        lgui::Graphics gfx{lgui::Graphics::RecordOnly(), lgui::Size()};
+        lgui::DrawList list;
+        lgui::GUI gui;
+        auto tree = make_widget_tree(tl, n);
+        tree->root.set_size(1024, 576);
+        gui.push_top_widget(tree->root);
+        auto frame = [&]() {
+            gfx.begin_recording(list, lgui::Rect(0, 0, 1024, 576));
+            gui.draw_widgets(gfx);
+            gfx.end_recording();
+        };
+        frame();
+        b.measure(frame);
+        b.set_counter("commands", list.no_commands());
+
+        gui.pop_top_widget();
+        device.reset();
+        device.set_recording(true);
+    });
+}
+
+// The cost of a frame on the GUI thread when drawing is left to a RenderThread: just recording a snapshot (see
+// draw/record). With fewer cores than threads, the render thread replaying the snapshots takes its time from the
+// GUI thread, so this also includes most of the replay.
+static void add_render_thread_frame(BenchmarkRegistry& reg, TreeLayout tl, int n) {
+    std::string name = std::string("draw/render_thread/") + tree_layout_name(tl) + "/" + std::to_string(n);
+    reg.add(name, [tl, n](Bench& b) {
+        lgui::HLDevice& device = lgui::HLDevice::get();
+        device.set_display_size(1024, 576);
+        device.set_recording(false);
+        lgui::GUI gui;
+        auto tree = make_widget_tree(tl, n);
+        tree->root.set_size(1024, 576);
+        gui.push_top_widget(tree->root);
+        lgui::RenderThread render_thread;
+        render_thread.start();
+        auto frame = [&]() {
+            render_thread.submit_frame(gui);
+        };
+        frame();
+        b.measure(frame);
+        render_thread.stop();
+
+        lgui::RenderLatencyStats s = render_thread.stats();
+        b.set_counter("frames_rendered", s.frames_rendered);
+        b.set_counter("frames_dropped", s.frames_dropped);
+
+        gui.pop_top_widget();
+        device.reset();
+        device.set_recording(true);
+    });
+}
+
+void add_draw_benchmarks(BenchmarkRegistry& reg) {
+    for (TreeLayout tl : {TreeLayout::Flow, TreeLayout::NestedBoxes}) {
+        for (int n : {100, 1000}) {
+            add_frame(reg, tl, n, FrameMode::Full);
+            add_frame(reg, tl, n, FrameMode::IdleDamageTracking);
+            add_frame(reg, tl, n, FrameMode::DrawListReplay);
+        }
+    }
+    add_label_repaint(reg, false);
+    add_label_repaint(reg, true);
+    for (TreeLayout tl : {TreeLayout::Flow, TreeLayout::NestedBoxes}) {
+        add_record_frame(reg, tl, 1000);
+        add_render_thread_frame(reg, tl, 1000);
+    }
+}
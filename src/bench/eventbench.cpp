@@ -0,0 +1,114 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "benchmark.h"
+#include "benchcommon.h"
+
+#include "lgui/internal/eventhandlerbase.h"
+#include "lgui/signal.h"
+
+static const int no_points = 64;
+
+// A fixed zigzag path of points covering the display.
+static lgui::Point path_point(int i, const lgui::Size& s) {
+    return lgui::Point((i * 997) % s.w(), (i * 541) % s.h());
+}
+
+static void layout_tree(WidgetTree& tree) {
+    lgui::MeasureResults mr = tree.root.measure(lgui::SizeConstraint(1024, lgui::SizeConstraintMode::Maximum),
+                                                lgui::SizeConstraint(0, lgui::SizeConstraintMode::NoLimits));
+    tree.root.layout(lgui::Rect(0, 0, 1024, std::max(mr.h(), 576)));
+}
+
+static void add_hit_tests(BenchmarkRegistry& reg, TreeLayout tl, int n) {
+    std::string suffix = std::string(tree_layout_name(tl)) + "/" + std::to_string(n);
+    reg.add("events/leaf_at/" + suffix, [tl, n](Bench& b) {
+        auto tree = make_widget_tree(tl, n);
+        layout_tree(*tree);
+        lgui::dtl::WidgetTreeTraversalStack stack;
+        lgui::Size s(1024, 576);
+        int hits = 0;
+        b.set_items(no_points);
+        b.measure([&]() {
+            hits = 0;
+            for (int i = 0; i < no_points; ++i) {
+                lgui::PointF p(path_point(i, s));
+                if (lgui::dtl::EventHandlerBase::get_leaf_widget_at_nonrecursive(&tree->root, p, stack) != &tree->root)
+                    hits++;
+            }
+        });
+        b.set_counter("leaf_hits", hits);
+    });
+    reg.add("events/mouse_move/" + suffix, [tl, n](Bench& b) {
+        lgui::GUI gui;
+        auto tree = make_widget_tree(tl, n);
+        layout_tree(*tree);
+        gui.push_top_widget(tree->root);
+        lgui::Size s(1024, 576);
+        b.set_items(no_points);
+        b.measure([&]() {
+            for (int i = 0; i < no_points; ++i) {
+                lgui::Point p = path_point(i, s);
+                push_mouse(gui, lgui::ExternalEvent::EVENT_MOUSE_MOVED, p.x(), p.y());
+            }
+        });
+        gui.pop_top_widget();
+    });
+}
+
+static void add_signal_emit(BenchmarkRegistry& reg, int slots) {
+    reg.add("events/signal_emit/" + std::to_string(slots) + "_slots", [slots](Bench& b) {
+        lgui::Signal<int> signal;
+        int64_t sum = 0;
+        for (int i = 0; i < slots; ++i)
+            signal.connect([&sum](int v) { sum += v; });
+        b.set_items(slots);
+        b.measure([&]() { signal.emit(1); });
+        b.set_counter("sum", double(sum));
+    });
+}
+
+void add_event_benchmarks(BenchmarkRegistry& reg) {
+    for (TreeLayout tl : {TreeLayout::Flow, TreeLayout::NestedBoxes}) {
+        for (int n : {100, 1000, 10000})
+            add_hit_tests(reg, tl, n);
+    }
+    for (int slots : {0, 1, 10, 100, 1000})
+        add_signal_emit(reg, slots);
+}
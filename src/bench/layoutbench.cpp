@@ -0,0 +1,104 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "benchmark.h"
+#include "benchcommon.h"
+
+#include <memory>
+
+static void add_layout(BenchmarkRegistry& reg, TreeLayout tl, int n, bool cached) {
+    std::string name = std::string("layout/") + tree_layout_name(tl) + "/" + std::to_string(n) +
+                       (cached ? "/warm" : "/cold");
+    reg.add(name, [tl, n, cached](Bench& b) {
+        auto tree = make_widget_tree(tl, n);
+        bool was_enabled = lgui::Widget::is_measure_cache_enabled();
+        lgui::Widget::set_measure_cache_enabled(cached);
+        b.set_items(n);
+        b.measure([&]() {
+            lgui::MeasureResults mr = tree->root.measure(lgui::SizeConstraint(1024, lgui::SizeConstraintMode::Maximum),
+                                                         lgui::SizeConstraint(0, lgui::SizeConstraintMode::NoLimits));
+            tree->root.layout(lgui::Rect(0, 0, 1024, mr.h()));
+        });
+        b.set_counter("height", tree->root.height());
+        lgui::Widget::set_measure_cache_enabled(was_enabled);
+    });
+}
+
+static void add_container_build(BenchmarkRegistry& reg, int n, bool bulk) {
+    std::string name = std::string("layout/container_build/") + std::to_string(n) + (bulk ? "/add_children" : "/add_child");
+    reg.add(name, [n, bulk](Bench& b) {
+        lgui::GUI gui;
+        lgui::Container root;
+        root.set_size(1024, 576);
+        gui.push_top_widget(root);
+        std::vector<std::unique_ptr<lgui::Widget>> widgets;
+        std::vector<lgui::Widget*> ptrs;
+        for (int i = 0; i < n; ++i) {
+            widgets.emplace_back(new lgui::Widget);
+            widgets.back()->set_rect((i % 100) * 10, (i / 100) * 10, 8, 8);
+            ptrs.push_back(widgets.back().get());
+        }
+        b.set_items(n);
+        b.measure([&]() {
+            if (bulk)
+                root.add_children(ptrs);
+            else {
+                for (lgui::Widget* w : ptrs)
+                    root.add_child(*w);
+            }
+            root.remove_all_children();
+        });
+        gui.pop_top_widget();
+    });
+}
+
+void add_layout_benchmarks(BenchmarkRegistry& reg) {
+    for (int n : {100, 1000, 10000}) {
+        add_container_build(reg, n, false);
+        add_container_build(reg, n, true);
+    }
+    for (TreeLayout tl : {TreeLayout::Flow, TreeLayout::SimpleTable, TreeLayout::Relative, TreeLayout::NestedBoxes}) {
+        for (int n : {10, 100, 1000, 10000}) {
+            // Cold: every layout measures all its items, as after a style or font change. Warm: measure results
+            // are remembered from the previous run, as when the parent is relaid out without changes.
+            add_layout(reg, tl, n, false);
+            add_layout(reg, tl, n, true);
+        }
+    }
+}
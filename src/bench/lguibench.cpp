@@ -0,0 +1,129 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Microbenchmarks for lgui, built as lgui_bench with the headless backend (-DLGUI_HEADLESS=ON), so results
+// don't depend on a GPU, a display or font files: fonts have fixed metrics and drawing is only recorded.
+//
+// Usage: lgui_bench [--filter=SUBSTRING] [--out=FILE] [--samples=N] [--min-time=MS] [--list]
+//
+// Progress goes to stderr; the results are written as JSON to FILE or stdout. Every benchmark reports the
+// time per run of its operation over N samples (min, median, mean, max, standard deviation) and, where it
+// makes sense, a throughput and some counters describing the work done.
+
+#include "benchmark.h"
+#include "benchcommon.h"
+
+#include "lgui/platform/events.h"
+#include "lgui/style/defaultstyle.h"
+#include "lgui/style/defaultstylecolorscheme.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const lgui::Font* bench_font_ptr = nullptr;
+
+const lgui::Font& bench_font() {
+    return *bench_font_ptr;
+}
+
+static bool parse_arg(const char* arg, const char* name, std::string& value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) == 0 && arg[len] == '=') {
+        value = arg + len + 1;
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    std::string filter, out_filename, value;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        if (parse_arg(argv[i], "--filter", value))
+            filter = value;
+        else if (parse_arg(argv[i], "--out", value))
+            out_filename = value;
+        else if (parse_arg(argv[i], "--samples", value))
+            Bench::no_samples = std::max(1, atoi(value.c_str()));
+        else if (parse_arg(argv[i], "--min-time", value))
+            Bench::min_sample_ms = std::max(0.0, atof(value.c_str()));
+        else if (strcmp(argv[i], "--list") == 0)
+            list = true;
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter=SUBSTRING] [--out=FILE] [--samples=N] [--min-time=MS] [--list]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    lgui::set_time(0.0);
+    lgui::Font font("data/forgotteb.ttf", 20);
+    bench_font_ptr = &font;
+    lgui::DefaultStyleDarkColorScheme color_scheme;
+    lgui::DefaultStyle style(font, color_scheme);
+    lgui::Widget::set_default_style(&style);
+
+    BenchmarkRegistry reg;
+    add_text_benchmarks(reg);
+    add_layout_benchmarks(reg);
+    add_event_benchmarks(reg);
+    add_draw_benchmarks(reg);
+
+    if (list) {
+        reg.list(std::cout);
+        return EXIT_SUCCESS;
+    }
+
+    reg.run(filter, std::cerr);
+
+    if (out_filename.empty()) {
+        reg.write_json(std::cout);
+    }
+    else {
+        std::ofstream file(out_filename);
+        reg.write_json(file);
+        if (!file) {
+            std::cerr << "Couldn't write " << out_filename << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
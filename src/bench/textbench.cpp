@@ -0,0 +1,126 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "benchmark.h"
+#include "benchcommon.h"
+
+#include "lgui/widgets/textbox.h"
+
+static void add_wordwrap(BenchmarkRegistry& reg, Corpus c, int width) {
+    std::string name = std::string("text/wordwrap/") + corpus_name(c) + "/w" + std::to_string(width);
+    reg.add(name, [c, width](Bench& b) {
+        std::string text = make_corpus(c, 64 * 1024);
+        std::vector<lgui::TextSpan> lines;
+        b.set_items(text.size());
+        b.measure([&]() {
+            lines.clear();
+            bench_font().do_wordwrap(text, width, lines);
+        });
+        b.set_counter("lines", lines.size());
+    });
+}
+
+// A single word of 160k characters, split over many lines.
+static void add_wordwrap_long_word(BenchmarkRegistry& reg) {
+    reg.add("text/wordwrap/long_word/w640", [](Bench& b) {
+        std::string text(160 * 1024, 'x');
+        std::vector<lgui::TextSpan> lines;
+        b.set_items(text.size());
+        b.measure([&]() {
+            lines.clear();
+            bench_font().do_wordwrap(text, 640, lines);
+        });
+        b.set_counter("lines", lines.size());
+    });
+    reg.add("text/textbox_wrap/long_word/w640", [](Bench& b) {
+        lgui::TextBox tb;
+        tb.set_wrap_mode(lgui::TextBox::FittingWords);
+        tb.set_size(640, 480);
+        std::string text(160 * 1024, 'x');
+        b.set_items(text.size());
+        b.measure([&]() {
+            tb.set_text(text);
+        });
+    });
+}
+
+static void add_textbox_typing(BenchmarkRegistry& reg, int lines, lgui::TextBox::WrapMode wm, const char* wm_name) {
+    std::string name = std::string("text/textbox_type/") + std::to_string(lines) + "_lines/" + wm_name;
+    reg.add(name, [lines, wm](Bench& b) {
+        const int chars = 16;
+        lgui::GUI gui;
+        lgui::TextBox tb(make_document(lines));
+        tb.set_wrap_mode(wm);
+        tb.set_size(640, 480);
+        gui.push_top_widget(tb);
+        tb.focus();
+        // Type in the middle of the document.
+        for (int i = 0; i < lines / 2; ++i)
+            push_key_char(gui, lgui::Keycodes::KEY_DOWN, 0);
+        b.set_items(2 * chars);
+        b.measure([&]() {
+            for (int i = 0; i < chars; ++i)
+                push_key_char(gui, lgui::Keycodes::KEY_A, 'a' + i);
+            for (int i = 0; i < chars; ++i)
+                push_key_char(gui, lgui::Keycodes::KEY_BACKSPACE, 8);
+        });
+        gui.pop_top_widget();
+    });
+}
+
+void add_text_benchmarks(BenchmarkRegistry& reg) {
+    for (Corpus c : {Corpus::Prose, Corpus::LongWords, Corpus::Utf8, Corpus::ShortLines}) {
+        add_wordwrap(reg, c, 160);
+        add_wordwrap(reg, c, 640);
+    }
+    add_wordwrap_long_word(reg);
+    reg.add("text/wordwrap_strings/prose/w640", [](Bench& b) {
+        std::string text = make_corpus(Corpus::Prose, 64 * 1024);
+        std::vector<std::string> lines;
+        b.set_items(text.size());
+        b.measure([&]() {
+            lines.clear();
+            bench_font().do_wordwrap(text, 640, lines);
+        });
+    });
+    for (int lines : {1000, 10000}) {
+        add_textbox_typing(reg, lines, lgui::TextBox::FittingWords, "fitting_words");
+        add_textbox_typing(reg, lines, lgui::TextBox::None, "no_wrap");
+    }
+}
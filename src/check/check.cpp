@@ -0,0 +1,82 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "check.h"
+
+#include <ostream>
+
+static int failed_expectations = 0;
+static std::ostream* check_log = nullptr;
+
+void check_expect(bool ok, const char* expr, const char* file, int line) {
+    if (ok)
+        return;
+    failed_expectations++;
+    if (check_log)
+        *check_log << "\n  " << file << ":" << line << ": CHECK(" << expr << ") failed";
+}
+
+void CheckRegistry::add(const std::string& name, Function f) {
+    mchecks.emplace_back(name, std::move(f));
+}
+
+int CheckRegistry::run(const std::string& filter, std::ostream& log) {
+    int failed = 0;
+    check_log = &log;
+    for (const auto& c : mchecks) {
+        if (!filter.empty() && c.first.find(filter) == std::string::npos)
+            continue;
+        log << c.first << "... " << std::flush;
+        failed_expectations = 0;
+        c.second();
+        if (failed_expectations > 0) {
+            log << "\nFAILED" << std::endl;
+            failed++;
+        }
+        else
+            log << "ok" << std::endl;
+    }
+    check_log = nullptr;
+    return failed;
+}
+
+void CheckRegistry::list(std::ostream& os) const {
+    for (const auto& c : mchecks)
+        os << c.first << "\n";
+}
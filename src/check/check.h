@@ -0,0 +1,79 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_CHECK_CHECK_H
+#define LGUI_CHECK_CHECK_H
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace lgui {
+class Font;
+}
+
+/** Report a failed expectation if `expr` is false. The check goes on, so that all failures are reported. */
+#define CHECK(expr) check_expect((expr), #expr, __FILE__, __LINE__)
+
+void check_expect(bool ok, const char* expr, const char* file, int line);
+
+/** A list of named behavioural checks, run against the headless backend. A check fails if any of its
+ *  expectations (see CHECK()) fails. */
+class CheckRegistry {
+    public:
+        using Function = std::function<void()>;
+
+        void add(const std::string& name, Function f);
+
+        /** Run all checks whose name contains `filter` (all if it is empty), in the order they were added.
+         *  Failures are printed to `log`. Return the number of failed checks. */
+        int run(const std::string& filter, std::ostream& log);
+
+        void list(std::ostream& os) const;
+
+    private:
+        std::vector<std::pair<std::string, Function>> mchecks;
+};
+
+void add_draw_checks(CheckRegistry& reg);
+void add_text_checks(CheckRegistry& reg, const lgui::Font& font);
+void add_textbox_checks(CheckRegistry& reg);
+
+#endif // LGUI_CHECK_CHECK_H
@@ -0,0 +1,280 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "check.h"
+
+#include "lgui/gui.h"
+#include "lgui/drawevent.h"
+#include "lgui/platform/drawlist.h"
+#include "lgui/platform/graphics.h"
+#include "lgui/platform/headless/hldevice.h"
+#include "lgui/widgets/container.h"
+#include "lgui/widgets/labels/textlabel.h"
+
+namespace {
+
+// A GUI with damage tracking and a root container filling the display. Drawing is recorded by the headless
+// device, so the checks can look at what a frame has drawn.
+struct Scene {
+    lgui::Graphics gfx;
+    lgui::GUI gui;
+    lgui::Container root;
+
+    Scene() {
+        lgui::HLDevice& device = lgui::HLDevice::get();
+        device.set_display_size(640, 480);
+        device.set_recording(true);
+        root.set_size(640, 480);
+        gui.set_damage_tracking(true);
+        gui.push_top_widget(root);
+    }
+
+    ~Scene() {
+        gui.pop_top_widget();
+        lgui::HLDevice::get().reset();
+    }
+
+    /** Draw a frame; return whether anything has been drawn. The device only holds the frame's commands. */
+    bool frame() {
+        lgui::HLDevice::get().reset();
+        bool drawn = gui.draw_widgets(gfx);
+        gfx.flip();
+        return drawn;
+    }
+
+    int commands(lgui::HLDrawCommand::Type type) const {
+        return lgui::HLDevice::get().stats().commands[type];
+    }
+};
+
+// Fills its rect and counts how often it has been drawn.
+class CountingWidget : public lgui::Widget {
+    public:
+        void draw(const lgui::DrawEvent& de) const override {
+            ++mdraws;
+            de.gfx().filled_rect(size_rect(), lgui::rgb(1, 0, 0));
+        }
+
+        int draws() const { return mdraws; }
+
+    private:
+        mutable int mdraws = 0;
+};
+
+}
+
+// A label inside a subtree cached as a layer changes its text to one of the same width: nothing is moved or
+// resized, so only the label invalidating itself and its parents' layers gets the new text drawn.
+static void check_layer_label_repaint() {
+    Scene scene;
+    lgui::Container panel;
+    panel.set_size(200, 100);
+    panel.set_cache_as_layer(true);
+    lgui::TextLabel label("Label");
+    label.set_size(100, 30);
+    panel.add_child(label);
+    scene.root.add_child(panel);
+    scene.frame();
+
+    CHECK(!scene.frame());
+    label.set_text("Lebal");
+    CHECK(scene.frame());
+    CHECK(scene.commands(lgui::HLDrawCommand::Text) > 0);
+
+    scene.root.remove_child(panel);
+}
+
+// The same for a subtree cached as a draw list: the label must get the list recorded again.
+static void check_draw_list_label_repaint() {
+    Scene scene;
+    lgui::Container panel;
+    panel.set_size(200, 100);
+    panel.set_cache_as_draw_list(true);
+    lgui::TextLabel label("Label");
+    label.set_size(100, 30);
+    panel.add_child(label);
+    scene.root.add_child(panel);
+    scene.frame();
+
+    CHECK(!scene.frame());
+    label.set_text("Lebal");
+    CHECK(scene.frame());
+    CHECK(scene.commands(lgui::HLDrawCommand::Text) > 0);
+
+    scene.root.remove_child(panel);
+}
+
+// Drawing a subtree cached as a draw list replays its commands without running its widgets' draw() methods,
+// until one of them is invalidated.
+static void check_draw_list_replay() {
+    Scene scene;
+    scene.gui.set_damage_tracking(false);
+    lgui::Container panel;
+    panel.set_size(200, 100);
+    panel.set_cache_as_draw_list(true);
+    CountingWidget child;
+    child.set_size(50, 50);
+    panel.add_child(child);
+    scene.root.add_child(panel);
+
+    scene.frame();
+    CHECK(child.draws() == 1);
+    int primitives = scene.commands(lgui::HLDrawCommand::Primitive);
+    CHECK(primitives > 0);
+
+    scene.frame();
+    CHECK(child.draws() == 1);
+    CHECK(scene.commands(lgui::HLDrawCommand::Primitive) == primitives);
+
+    child.invalidate();
+    scene.frame();
+    CHECK(child.draws() == 2);
+    CHECK(scene.commands(lgui::HLDrawCommand::Primitive) == primitives);
+
+    scene.root.remove_child(panel);
+}
+
+// A panel lying completely outside of the display, with a child reaching into it: unless the panel is clipped,
+// the child has to be drawn.
+struct OverflowingPanel {
+    lgui::Container panel;
+    CountingWidget child;
+
+    explicit OverflowingPanel(bool clipped) {
+        panel.set_pos(-200, -200);
+        panel.set_size(100, 100);
+        panel.set_clipped(clipped);
+        child.set_pos(300, 300);
+        child.set_size(50, 50);
+        panel.add_child(child);
+    }
+};
+
+static void check_unclipped_overflow() {
+    Scene scene;
+    OverflowingPanel p(false);
+    scene.root.add_child(p.panel);
+
+    CHECK(scene.frame());
+    CHECK(p.child.draws() == 1);
+    CHECK(scene.commands(lgui::HLDrawCommand::Primitive) > 0);
+
+    scene.root.remove_child(p.panel);
+}
+
+static void check_clipped_overflow() {
+    Scene scene;
+    OverflowingPanel p(true);
+    scene.root.add_child(p.panel);
+
+    scene.frame();
+    CHECK(p.child.draws() == 0);
+
+    scene.root.remove_child(p.panel);
+}
+
+// Moving the child damages both its old and its new place, although neither overlaps the panel.
+static void check_overflow_damage() {
+    Scene scene;
+    OverflowingPanel p(false);
+    scene.root.add_child(p.panel);
+    scene.frame();
+
+    CHECK(!scene.frame());
+    p.child.set_pos(310, 300);
+    CHECK(scene.frame());
+    CHECK(p.child.draws() == 2);
+
+    scene.root.remove_child(p.panel);
+}
+
+// Replaying a panel cached as a draw list must not cull the child either.
+static void check_overflow_draw_list() {
+    Scene scene;
+    scene.gui.set_damage_tracking(false);
+    OverflowingPanel p(false);
+    p.panel.set_cache_as_draw_list(true);
+    scene.root.add_child(p.panel);
+
+    scene.frame();
+    int primitives = scene.commands(lgui::HLDrawCommand::Primitive);
+    CHECK(primitives > 0);
+    scene.frame();
+    CHECK(p.child.draws() == 1);
+    CHECK(scene.commands(lgui::HLDrawCommand::Primitive) == primitives);
+
+    scene.root.remove_child(p.panel);
+}
+
+// Areas nothing has been drawn within are left out of a draw list, along with their transformations; replaying
+// it draws the same.
+static void check_draw_list_empty_areas() {
+    Scene scene;
+    lgui::DrawList list;
+    lgui::Graphics recording{lgui::Graphics::RecordOnly(), lgui::Size(640, 480)};
+    lgui::Transform t;
+    t.translate_post(lgui::PointF(10, 10));
+    recording.begin_recording(list);
+    recording.push_draw_area(lgui::Rect(10, 10, 100, 100), true);
+    recording.push_draw_area(lgui::Rect(0, 0, 50, 50), t);
+    recording.pop_draw_area();
+    recording.filled_rect(lgui::Rect(0, 0, 20, 20), lgui::rgb(1, 0, 0));
+    recording.push_draw_area(lgui::Rect(20, 20, 50, 50));
+    recording.pop_draw_area();
+    recording.pop_draw_area();
+    recording.push_draw_area(lgui::Rect(200, 200, 50, 50), t);
+    recording.pop_draw_area();
+    recording.end_recording();
+    CHECK(list.no_commands() == 3);
+
+    lgui::HLDevice::get().reset();
+    list.replay(scene.gfx);
+    CHECK(scene.commands(lgui::HLDrawCommand::Primitive) == 1);
+}
+
+void add_draw_checks(CheckRegistry& reg) {
+    reg.add("draw/layer/label_repaint", check_layer_label_repaint);
+    reg.add("draw/draw_list/label_repaint", check_draw_list_label_repaint);
+    reg.add("draw/draw_list/replay", check_draw_list_replay);
+    reg.add("draw/draw_list/empty_areas", check_draw_list_empty_areas);
+    reg.add("draw/cull/unclipped_overflow", check_unclipped_overflow);
+    reg.add("draw/cull/clipped_overflow", check_clipped_overflow);
+    reg.add("draw/cull/overflow_damage", check_overflow_damage);
+    reg.add("draw/cull/overflow_draw_list", check_overflow_draw_list);
+}
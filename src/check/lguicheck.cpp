@@ -0,0 +1,92 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Behavioural checks for lgui, built as lgui_check with the headless backend (-DLGUI_HEADLESS=ON) and run by
+// ctest. They look at what is drawn (the headless device counts the draw commands), so they don't depend on
+// a GPU or a display.
+//
+// Usage: lgui_check [--filter=SUBSTRING] [--list]
+
+#include "check.h"
+
+#include "lgui/platform/events.h"
+#include "lgui/platform/font.h"
+#include "lgui/style/defaultstyle.h"
+#include "lgui/style/defaultstylecolorscheme.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    std::string filter;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--filter=", 9) == 0)
+            filter = argv[i] + 9;
+        else if (strcmp(argv[i], "--list") == 0)
+            list = true;
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--filter=SUBSTRING] [--list]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    lgui::set_time(0.0);
+    lgui::Font font("data/forgotteb.ttf", 20);
+    lgui::DefaultStyleDarkColorScheme color_scheme;
+    lgui::DefaultStyle style(font, color_scheme);
+    lgui::Widget::set_default_style(&style);
+
+    CheckRegistry reg;
+    add_draw_checks(reg);
+    add_text_checks(reg, font);
+    add_textbox_checks(reg);
+
+    if (list) {
+        reg.list(std::cout);
+        return EXIT_SUCCESS;
+    }
+    int failed = reg.run(filter, std::cerr);
+    if (failed > 0) {
+        std::cerr << failed << " check(s) failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
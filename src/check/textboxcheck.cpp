@@ -0,0 +1,214 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "check.h"
+
+#include "lgui/gui.h"
+#include "lgui/textsource.h"
+#include "lgui/internal/lineindex.h"
+#include "lgui/platform/events.h"
+#include "lgui/platform/graphics.h"
+#include "lgui/platform/keycodes.h"
+#include "lgui/platform/utf8.h"
+#include "lgui/platform/headless/hldevice.h"
+#include "lgui/widgets/textbox.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// A source read in chunks only (no data()), as from a stream.
+class StringTextSource : public lgui::TextSource {
+    public:
+        explicit StringTextSource(std::string text)
+                : mtext(std::move(text)) {}
+
+        uint64_t size() const override { return mtext.size(); }
+
+        size_t read(uint64_t offs, size_t n, char* dest) const override {
+            if (offs >= mtext.size())
+                return 0;
+            n = std::min<size_t>(n, mtext.size() - offs);
+            memcpy(dest, mtext.data() + offs, n);
+            return n;
+        }
+
+    private:
+        std::string mtext;
+};
+
+// A focused TextBox receiving key events through a GUI.
+struct Editor {
+    lgui::GUI gui;
+    lgui::TextBox tb;
+
+    Editor(const std::string& text, lgui::TextBox::WrapMode wm) {
+        tb.set_wrap_mode(wm);
+        tb.set_size(200, 300);
+        tb.set_text(text);
+        gui.push_top_widget(tb);
+        tb.focus();
+    }
+
+    ~Editor() {
+        gui.pop_top_widget();
+    }
+
+    void key(lgui::KeyCode code, int unichar = 0, int modifiers = 0) {
+        lgui::advance_time(0.001);
+        lgui::ExternalEvent e{};
+        e.type = lgui::ExternalEvent::EVENT_KEY_CHAR;
+        e.timestamp = lgui::get_time();
+        e.key.code = code;
+        e.key.unichar = unichar;
+        e.key.modifiers = modifiers;
+        gui.push_external_event(e);
+    }
+
+    void type(char c) {
+        key(lgui::Keycodes::KEY_X, c);
+    }
+};
+
+}
+
+// Ctrl+Left/Right only search a window of the text around the caret; the boundaries found have to be the
+// same as when searching the whole text, also for words longer than the window.
+static void check_word_navigation() {
+    const std::string text = "alpha  " + std::string(3000, 'b') + " \xc3\xa4" + std::string(2000, 'c') + " omega";
+    for (bool backwards : {false, true}) {
+        Editor ed(text, lgui::TextBox::None);
+        size_t expected = backwards ? text.size() : 0;
+        ed.key(backwards ? lgui::Keycodes::KEY_END : lgui::Keycodes::KEY_HOME, 0, lgui::KeyModifiers::KEYMOD_CTRL);
+        for (int i = 0; i < 6; ++i) {
+            ed.key(backwards ? lgui::Keycodes::KEY_LEFT : lgui::Keycodes::KEY_RIGHT, 0,
+                   lgui::KeyModifiers::KEYMOD_CTRL);
+            expected = lgui::utf8::skip_to_next_word_boundary(text, expected, backwards);
+        }
+        ed.type('X');
+        CHECK(ed.tb.text() == text.substr(0, expected) + "X" + text.substr(expected));
+    }
+}
+
+// Rows are read from the text by their offsets: after edits, moving the caret through a wrapped text by
+// single characters has to visit every byte offset of it (the text is ASCII).
+static void check_wrapped_caret_offsets() {
+    std::string text;
+    for (int i = 0; i < 40; ++i)
+        text += "word" + std::to_string(i) + (i % 7 == 6 ? "\n" : " ");
+    Editor ed(text, lgui::TextBox::FittingWords);
+    // Edit in the middle, so that the text consists of several pieces.
+    for (int i = 0; i < 50; ++i)
+        ed.key(lgui::Keycodes::KEY_RIGHT);
+    for (char c : std::string("inserted text "))
+        ed.type(c);
+    text.insert(50, "inserted text ");
+    CHECK(ed.tb.text() == text);
+
+    for (size_t offs : {size_t(0), size_t(17), size_t(64), size_t(101), size_t(150), text.size()}) {
+        ed.key(lgui::Keycodes::KEY_HOME, 0, lgui::KeyModifiers::KEYMOD_CTRL);
+        for (size_t i = 0; i < offs; ++i)
+            ed.key(lgui::Keycodes::KEY_RIGHT);
+        ed.type('#');
+        text.insert(offs, "#");
+        CHECK(ed.tb.text() == text);
+    }
+}
+
+// The line index is built on a background thread; asking for a line waits just until it has been found.
+static void check_line_index() {
+    const int lines = 200000;
+    std::string text;
+    for (int i = 0; i < lines; ++i)
+        text += "line " + std::to_string(i) + "\n";
+    StringTextSource source(text);
+    lgui::dtl::LineIndex index;
+    index.reset(&source);
+
+    index.index_up_to_line(1000);
+    CHECK(index.line_count() > 1001);
+    CHECK(index.line_text(1000, 100) == "line 1000");
+
+    while (!index.is_complete()) {
+        if (!index.update())
+            std::this_thread::yield();
+    }
+    // The text ends with a newline, so there is an empty last line.
+    CHECK(index.line_count() == size_t(lines) + 1);
+    CHECK(index.line_text(lines - 1, 100) == "line " + std::to_string(lines - 1));
+    CHECK(index.line_text(lines, 100).empty());
+
+    // Resetting stops indexing the old source.
+    index.reset(&source);
+    index.reset(nullptr);
+    CHECK(index.line_count() == 0);
+}
+
+// Lines of a source aren't wrapped, so there is exactly one row per line, as the scroll range assumes.
+static void check_source_rows() {
+    lgui::HLDevice& device = lgui::HLDevice::get();
+    device.set_display_size(640, 480);
+    device.set_recording(true);
+    StringTextSource source(std::string(500, 'x') + "\nshort\n\nlast");
+    lgui::Graphics gfx;
+    lgui::GUI gui;
+    lgui::TextBox tb;
+    tb.set_wrap_mode(lgui::TextBox::FittingWords);
+    tb.set_size(200, 300);
+    tb.set_source(&source);
+    gui.push_top_widget(tb);
+
+    device.reset();
+    gui.draw_widgets(gfx);
+    gfx.flip();
+    CHECK(device.stats().commands[lgui::HLDrawCommand::Text] == 4);
+
+    gui.pop_top_widget();
+    tb.set_source(nullptr);
+    device.reset();
+}
+
+void add_textbox_checks(CheckRegistry& reg) {
+    reg.add("textbox/word_navigation", check_word_navigation);
+    reg.add("textbox/wrapped_caret_offsets", check_wrapped_caret_offsets);
+    reg.add("textbox/line_index", check_line_index);
+    reg.add("textbox/source_rows", check_source_rows);
+}
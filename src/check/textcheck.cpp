@@ -0,0 +1,90 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "check.h"
+
+#include "lgui/platform/font.h"
+#include "lgui/platform/textrun.h"
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+// A word much wider than a line is split over many lines. Each line has to be measured exactly, including
+// the last one of the word, and no character may get lost.
+static void check_wordwrap_long_word(const lgui::Font& font) {
+    const int max_width = 200;
+    std::string text = "short " + std::string(5000, 'x') + "yz tail";
+    std::vector<lgui::TextSpan> lines;
+    font.do_wordwrap(text, max_width, lines);
+
+    CHECK(lines.size() > 2);
+    std::string joined;
+    for (const lgui::TextSpan& l : lines) {
+        CHECK(l.width == font.text_width(text, l.offs, l.size));
+        CHECK(l.width <= max_width);
+        joined.append(text, l.offs, l.size);
+    }
+    // Whether a line includes the space it has been broken at depends on where the word was split.
+    auto no_spaces = [](std::string s) {
+        s.erase(std::remove(s.begin(), s.end(), ' '), s.end());
+        return s;
+    };
+    CHECK(no_spaces(joined) == no_spaces(text));
+}
+
+// A run shaped for a font that has been destroyed must be shaped again for a new font, even one constructed at
+// the same address.
+static void check_text_run_font_reuse() {
+    std::aligned_storage<sizeof(lgui::Font), alignof(lgui::Font)>::type storage;
+    lgui::TextRun run("Text");
+
+    auto* font = new (&storage) lgui::Font("data/forgotteb.ttf", 20);
+    CHECK(run.width(*font) == font->text_width("Text"));
+    font->~Font();
+
+    font = new (&storage) lgui::Font("data/forgotteb.ttf", 30);
+    CHECK(run.width(*font) == font->text_width("Text"));
+    font->~Font();
+}
+
+void add_text_checks(CheckRegistry& reg, const lgui::Font& font) {
+    reg.add("text/wordwrap/long_word", [&font]() { check_wordwrap_long_word(font); });
+    reg.add("text/text_run/font_reuse", check_text_run_font_reuse);
+}
@@ -41,6 +41,7 @@
 #include "lgui/vector_utils.h"
 #include "lgui/timertickevent.h"
 #include "concreteanimation.h"
+#include "lgui/profiler.h"
 
 namespace lgui {
 namespace  dtl {
@@ -67,6 +68,7 @@ void AnimationPlayer::update(const TimerTickEvent& timer_event) {
     for (ConcreteAnimation* ani : manimations) {
         ani->update(timer_event.timestamp(), elapsed);
     }
+    LGUI_PROFILE_COUNT(AnimationsUpdated, manimations.size());
     mlast_timestamp = timer_event.timestamp();
 }
 
@@ -62,6 +62,9 @@ class AnimationPlayer {
 
         void update(const TimerTickEvent& timer_event);
 
+        /** Return whether there are any animations currently registered. */
+        bool is_playing() const { return !manimations.empty(); }
+
         static AnimationPlayer& instance() {
             if (!minstance) {
                 minstance = std::make_unique<AnimationPlayer>();
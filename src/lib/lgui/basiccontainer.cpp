@@ -43,14 +43,18 @@
 #include "lgui/platform/graphics.h"
 #include "drawevent.h"
 #include "lgui/internal/focusmanager.h"
+#include "lgui/internal/childhitgrid.h"
 #include "layout/layouttransition.h"
 
+#include <algorithm>
 #include <limits>
 
 //#define DRAW_OUTLINES
 
 namespace lgui {
 
+int BasicContainer::mhit_grid_threshold = 64;
+
 BasicContainer::BasicContainer()
         : mlayout(nullptr) {
 }
@@ -86,7 +90,12 @@ void BasicContainer::draw_children(const DrawEvent& de) const {
 
 void BasicContainer::set_children_area(const Rect& children_area) {
     if (mchildren_area != children_area) {
+        // The children move along with it.
+        invalidate_rect(visual_bounds());
         mchildren_area = children_area;
+        invalidate_rect(visual_bounds());
+        if (mhit_grid)
+            mhit_grid->invalidate();
         if (mlayout)
             request_layout();
     }
@@ -101,6 +110,14 @@ Widget* BasicContainer::get_child_at(PointF p) {
     //        It's not really a flag for public children though...
     if (!children_area().contains(p))
         return nullptr;
+    if (mhit_grid_threshold > 0 && signed(mchildren.size()) >= mhit_grid_threshold) {
+        if (!mhit_grid)
+            mhit_grid = std::make_unique<dtl::ChildHitGrid>();
+        if (mhit_grid->needs_rebuild())
+            mhit_grid->rebuild(mchildren_area, mchildren);
+        return mhit_grid->child_at(p);
+    }
+    mhit_grid.reset();
     // reverse iteration as those at the end are considered to be "on-top"
     for (auto it = mchildren.rbegin(); it != mchildren.rend(); ++it) {
         Widget* c = *it;
@@ -114,15 +131,10 @@ Widget* BasicContainer::get_child_at(PointF p) {
 void BasicContainer::add_child(Widget& widget) {
     ASSERT(widget.parent() == nullptr);
     // take precautions against double add
-    bool found = false;
-    for (auto& child : mchildren) {
-        if (child == &widget) {
-            found = true;
-            break;
-        }
-    }
-    if (!found) {
+    if (widget.parent() != this) {
         mchildren.push_back(&widget);
+        if (mhit_grid)
+            mhit_grid->add(widget);
         configure_new_child(widget);
         if (mlayout) {
             mlayout->_child_added_to_target(widget);
@@ -144,6 +156,36 @@ void BasicContainer::add_child(Widget& widget) {
     }
 }
 
+void BasicContainer::add_children(const std::vector<Widget*>& widgets) {
+    std::vector<Widget*> added;
+    added.reserve(widgets.size());
+    mchildren.reserve(mchildren.size() + widgets.size());
+    for (Widget* widget : widgets) {
+        ASSERT(widget->parent() == nullptr);
+        if (widget->parent() == this)
+            continue;
+        mchildren.push_back(widget);
+        if (mhit_grid)
+            mhit_grid->add(*widget);
+        configure_new_child(*widget);
+        if (!widget->has_strong_style() && &widget->style() != &style())
+            widget->set_style(&style());
+        added.push_back(widget);
+    }
+    if (added.empty())
+        return;
+    if (mlayout)
+        mlayout->_children_added_to_target(added);
+    _emit_children_added(added);
+    if (layout_transition()) {
+        for (Widget* widget : added)
+            layout_transition()->widget_added(*widget);
+    }
+    // See add_child().
+    if (!mlayout && is_added_to_gui())
+        request_layout();
+}
+
 void BasicContainer::remove_child(Widget& widget) {
     if (!layout_transition()) {
         _remove_child(widget);
@@ -154,13 +196,13 @@ void BasicContainer::remove_child(Widget& widget) {
 }
 
 void BasicContainer::_remove_child(Widget& widget) {
-    bool found = false;
-    for (auto it = begin(); it != end(); ++it) {
-        if (*it == &widget) {
-            mchildren.erase(it);
-            found = true;
-            break;
-        }
+    // Search from the end: children are often removed in reverse order, and erasing there is cheap.
+    auto rit = std::find(mchildren.rbegin(), mchildren.rend(), &widget);
+    bool found = rit != mchildren.rend();
+    if (found) {
+        mchildren.erase(std::next(rit).base());
+        if (mhit_grid)
+            mhit_grid->remove(widget);
     }
     ASSERT(found);
     if (found) {
@@ -174,8 +216,9 @@ void BasicContainer::_remove_child(Widget& widget) {
 
 void BasicContainer::remove_all_children() {
     container_t cc = mchildren; // clone container
-    for (Widget* w : cc)
-        remove_child(*w);
+    // Topmost first, so that each removal erases the last element.
+    for (auto it = cc.rbegin(); it != cc.rend(); ++it)
+        remove_child(**it);
 }
 
 void BasicContainer::set_layout(Layout* layout) {
@@ -223,6 +266,8 @@ void BasicContainer::resized(const Size& old_size) {
     (void) old_size;
     mchildren_area.set_size(size());
     mchildren_area.set_pos(0, 0);
+    if (mhit_grid)
+        mhit_grid->invalidate();
     if (mlayout)
         request_layout();
 }
@@ -243,6 +288,11 @@ void BasicContainer::visit_down(const std::function<void(Widget&)>& f) {
     }
 }
 
+void BasicContainer::visit_children(const std::function<void(const Widget&)>& f) const {
+    for (const Widget* child : mchildren)
+        f(*child);
+}
+
 MeasureResults BasicContainer::measure_children(SizeConstraint wc, SizeConstraint hc) {
     if (mlayout)
         return mlayout->measure(wc, hc);
@@ -281,8 +331,10 @@ Rect BasicContainer::children_bounding_box() const {
 void BasicContainer::_bring_child_to_front(Widget& child) {
     if (child.parent() == this) {
         if (mchildren.back() != &child) {
-            mchildren.remove(&child);
-            mchildren.push_back(&child);
+            auto it = std::find(mchildren.begin(), mchildren.end(), &child);
+            std::rotate(it, it + 1, mchildren.end());
+            if (mhit_grid)
+                mhit_grid->bring_to_front(child);
         }
     }
 }
@@ -290,11 +342,18 @@ void BasicContainer::_bring_child_to_front(Widget& child) {
 void BasicContainer::_send_child_to_back(Widget& child) {
     if (child.parent() == this) {
         if (mchildren.front() != &child) {
-            mchildren.remove(&child);
-            mchildren.push_front(&child);
+            auto it = std::find(mchildren.begin(), mchildren.end(), &child);
+            std::rotate(mchildren.begin(), it, it + 1);
+            if (mhit_grid)
+                mhit_grid->send_to_back(child);
         }
     }
 }
 
+void BasicContainer::_child_placement_changed(Widget& child) {
+    if (mhit_grid)
+        mhit_grid->child_moved(child);
+}
+
 }
 
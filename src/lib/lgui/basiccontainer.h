@@ -40,13 +40,19 @@
 #ifndef LGUI_BASICCONTAINER_H
 #define LGUI_BASICCONTAINER_H
 
-#include <list>
+#include <initializer_list>
+#include <memory>
+#include <vector>
 #include "widget.h"
 
 namespace lgui {
 
 class Layout;
 
+namespace dtl {
+class ChildHitGrid;
+}
+
 /** A %BasicContainer is a widget with children. As such, it serves as bases class for a number of other
  *  widgets. You can set layouts on a %BasicContainer and its subclasses. When using a layout, you usually
  *  need to add children to the layouts and not the %BasicContainer (but the layout will add them as
@@ -72,6 +78,15 @@ class BasicContainer : public Widget {
         Rect children_area() const override;
 
         void add_child(Widget& widget);
+
+        /** Add several children at once, on top of the existing ones in the given order. Widget listeners and
+         *  the layout are notified only once for all of them and at most one layout process is requested,
+         *  which makes this much cheaper than calling add_child() for each widget when adding many. */
+        void add_children(const std::vector<Widget*>& widgets);
+        void add_children(std::initializer_list<Widget*> widgets) {
+            add_children(std::vector<Widget*>(widgets));
+        }
+
         void remove_child(Widget& widget);
         void remove_all_children();
         void set_layout(Layout* layout);
@@ -92,7 +107,7 @@ class BasicContainer : public Widget {
         // and no one should ever be allowed to change our internal
         // pointers! (i.e. const_iterator is not the same as const Widget*,
         //            but rather Widget* const)
-        using container_t = std::list<Widget*>;
+        using container_t = std::vector<Widget*>;
         using iterator = container_t::const_iterator;
         using reverse_iterator = container_t::const_reverse_iterator;
         iterator begin() const { return mchildren.begin(); }
@@ -104,8 +119,15 @@ class BasicContainer : public Widget {
         Widget& first() const { return *mchildren.front(); }
 
         void visit_down(const std::function<void(Widget&)>& f) override;
+        void visit_children(const std::function<void(const Widget&)>& f) const override;
         void _remove_child(Widget& widget);
 
+        /** Set the number of children from which on containers will keep a grid of their children's rects to
+         *  find the child under the mouse, instead of testing one child after the other. Pass 0 to never use
+         *  the grid. The default is 64. */
+        static void set_hit_grid_threshold(int no_children) { mhit_grid_threshold = no_children; }
+        static int hit_grid_threshold() { return mhit_grid_threshold; }
+
     protected:
         void child_about_to_die(Widget& child) override;
         void resized(const Size& old_size) override;
@@ -129,6 +151,7 @@ class BasicContainer : public Widget {
 
         void _bring_child_to_front(Widget& child) override;
         void _send_child_to_back(Widget& child) override;
+        void _child_placement_changed(Widget& child) override;
 
         /** Used during the layout process to see how large the children area shall be given a potential size of the widget. */
         virtual Size get_children_area_size_for_size(Size size) { return size; }
@@ -137,6 +160,9 @@ class BasicContainer : public Widget {
         container_t mchildren;
         Layout* mlayout;
         Rect mchildren_area;
+        std::unique_ptr<dtl::ChildHitGrid> mhit_grid;
+
+        static int mhit_grid_threshold;
 };
 
 }
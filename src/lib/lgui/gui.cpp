@@ -38,12 +38,15 @@
 */
 
 #include <algorithm>
+#include <chrono>
 
 #include "gui.h"
+#include "profiler.h"
 
 #include "dragrepresentation.h"
 #include "drawevent.h"
 #include "lgui/platform/graphics.h"
+#include "lgui/animation/animationplayer.h"
 
 //#define _LGUI_DBG_DRAW_FOCUS
 //#define DEBUG_LAYOUT
@@ -60,29 +63,83 @@
 
 namespace lgui {
 
+// If there are more damage regions than this, they are collapsed into their bounding box.
+static constexpr size_t MAX_DAMAGE_RECTS = 16;
+
 GUI::GUI()
         : mevent_handler(*this),
           mtop_widget(nullptr), mmodal_widget(nullptr),
           mdraw_widget_stack_start(0),
+          mlayout_budget_ms(0.0),
           manimation_facilities(manimation_context),
+          mbackground_color(rgb(0, 0, 0)),
+          mundrawn_event_timestamp(-1.0),
           munder_mouse_invalid(false),
           mhandling_events(false),
           mlayout_in_progress(false),
-          mhandling_deferred_callbacks(false) {}
+          mhandling_deferred_callbacks(false),
+          mdamage_tracking(false),
+          mdamage_all(false),
+          mhad_drag_repr(false) {}
+
+bool GUI::draw_widgets(Graphics& gfx) {
+    LGUI_PROFILE_FRAME();
+    LGUI_PROFILE_SCOPE("GUI::draw_widgets");
+    gfx.reset_culled_count();
+    mundrawn_event_timestamp = -1.0;
+    if (!mdamage_tracking) {
+        do_draw_widgets(gfx, nullptr);
+        return true;
+    }
+
+    update_drag_damage();
+    if (!has_damage())
+        return false;
+
+    // Clipping isn't recorded: a recording has to contain everything.
+    if (gfx.is_recording()) {
+        do_draw_widgets(gfx, nullptr);
+    }
+    else if (mdamage_all) {
+        gfx.clear(mbackground_color);
+        do_draw_widgets(gfx, nullptr);
+    }
+    else {
+        Rect bounds = mdamage.front();
+        for (const Rect& r : mdamage)
+            bounds = bounds.united(r);
+
+        int cx, cy, cw, ch;
+        gfx.get_clip_rect(cx, cy, cw, ch);
+        Rect clip = bounds;
+        clip.clip_to(Rect(cx, cy, cw, ch));
+        gfx.set_clip_rect(clip.x(), clip.y(), clip.w(), clip.h());
+        // What's been drawn there before may not be drawn over completely.
+        gfx.clear(mbackground_color);
+        do_draw_widgets(gfx, &bounds);
+        gfx.set_clip_rect(cx, cy, cw, ch);
+    }
+    clear_damage();
+    return true;
+}
+
+void GUI::do_draw_widgets(Graphics& gfx, const Rect* damage_bounds) {
+    auto is_damaged = [damage_bounds](const Widget& w) {
+        return !damage_bounds || w.map_rect_to_absolute(w.visual_bounds()).overlaps(*damage_bounds);
+    };
 
-void GUI::draw_widgets(Graphics& gfx) {
     for (unsigned int i = mdraw_widget_stack_start; i < mtop_widget_stack.size(); i++) {
         const auto& e = mtop_widget_stack[i];
         const Widget& w = *e.top_widget;
-        if (w.is_visible()) {
+        if (w.is_visible() && is_damaged(w)) {
             Widget::draw_child(w, DrawEvent(gfx, false, 1.0));
             gfx.filled_rect(w.rect(), e.cover_col);
         }
     }
 
-    if (mtop_widget && mtop_widget->is_visible())
+    if (mtop_widget && mtop_widget->is_visible() && is_damaged(*mtop_widget))
         Widget::draw_child(*mtop_widget, DrawEvent(gfx, false, 1.0));
-    if (mmodal_widget)
+    if (mmodal_widget && is_damaged(*mmodal_widget))
         Widget::draw_child(*mmodal_widget, DrawEvent(gfx, false, 1.0));
 
 #ifdef _LGUI_DBG_DRAW_FOCUS
@@ -99,13 +156,86 @@ void GUI::draw_widgets(Graphics& gfx) {
         drag_repr->draw(gfx);
         gfx.pop_draw_area();
     }
+    // Submit anything still batched so that the caller can draw directly afterwards.
+    gfx.flush();
+}
+
+void GUI::set_damage_tracking(bool enabled) {
+    mdamage_tracking = enabled;
+    clear_damage();
+    if (enabled)
+        mdamage_all = true;
+}
+
+void GUI::set_background_color(const Color& col) {
+    mbackground_color = col;
+    invalidate_all();
+}
+
+void GUI::invalidate_all() {
+    if (mdamage_tracking) {
+        mdamage_all = true;
+        mdamage.clear();
+    }
+}
+
+void GUI::_add_damage(const Rect& r) {
+    if (!mdamage_tracking || mdamage_all || r.w() <= 0 || r.h() <= 0)
+        return;
+    Rect merged = r;
+    // Merge with every region overlapping; start over when merged since the region has grown.
+    size_t i = 0;
+    while (i < mdamage.size()) {
+        if (mdamage[i].overlaps(merged)) {
+            merged = merged.united(mdamage[i]);
+            mdamage[i] = mdamage.back();
+            mdamage.pop_back();
+            i = 0;
+        }
+        else
+            i++;
+    }
+    if (mdamage.size() >= MAX_DAMAGE_RECTS) {
+        for (const Rect& d : mdamage)
+            merged = merged.united(d);
+        mdamage.clear();
+    }
+    mdamage.push_back(merged);
+}
+
+void GUI::update_drag_damage() {
+    // The drag representation is not a widget, so track where it has been drawn the last time.
+    const DragRepresentation* drag_repr = mevent_handler.drag_representation();
+    if (mhad_drag_repr)
+        _add_damage(mlast_drag_rect);
+    if (drag_repr) {
+        mlast_drag_rect = drag_repr->rect();
+        _add_damage(mlast_drag_rect);
+    }
+    mhad_drag_repr = drag_repr != nullptr;
+}
+
+void GUI::clear_damage() {
+    mdamage.clear();
+    mdamage_all = false;
 }
 
 void GUI::push_external_event(const ExternalEvent& event) {
+    // Animations may change arbitrary properties, so there is no way to tell what they've damaged.
+    bool animating = mdamage_tracking && event.type == ExternalEvent::EVENT_TIMER_TICK &&
+                     dtl::AnimationPlayer::instance().is_playing();
+
+    if (event.type != ExternalEvent::EVENT_TIMER_TICK && mundrawn_event_timestamp < 0)
+        mundrawn_event_timestamp = event.timestamp;
+
     mhandling_events = true;
     mevent_handler.push_external_event(event);
     mhandling_events = false;
 
+    if (animating || event.type == ExternalEvent::EVENT_DISPLAY_RESIZE ||
+        event.type == ExternalEvent::EVENT_RESUME_DRAWING)
+        invalidate_all();
+
     handle_deferred();
 }
 
@@ -113,7 +243,7 @@ void GUI::handle_deferred() {
     if (mhandling_events)
         return;
     handle_deferred_actions();
-    handle_relayout();
+    handle_relayout(true);
     handle_deferred_callbacks();
     if (munder_mouse_invalid) {
         mevent_handler.update_under_mouse();
@@ -141,6 +271,7 @@ void GUI::push_top_widget(TopWidget& top, bool shinethrough, Color cover_col) {
             mdraw_widget_stack_start = mtop_widget_stack.size();
     }
     set_top(&top);
+    invalidate_all();
     // this triggers a relayout
     _request_layout(top);
     handle_relayout();
@@ -168,6 +299,7 @@ void GUI::pop_top_widget() {
     }
 
     set_top(new_top);
+    invalidate_all();
 
     if (entry) {
         mdraw_widget_stack_start = entry->top_stack_start_drawing_idx;
@@ -199,25 +331,67 @@ void GUI::handle_deferred_actions() {
     mdeferred_actions.clear();
 }
 
-void GUI::handle_relayout() {
-    if (!mrelayout_widgets.empty()) {
-        DBG_LAYOUT("################ LAYOUT BEGINS\n");
-        mlayout_in_progress = true;
-        for (auto relayout_widget : mrelayout_widgets) {
+static int widget_depth(const Widget* w) {
+    int depth = 0;
+    for (w = w->parent(); w; w = w->parent())
+        depth++;
+    return depth;
+}
+
+void GUI::handle_relayout(bool use_budget) {
+    if (mrelayout_widgets.empty())
+        return;
+    LGUI_PROFILE_SCOPE("GUI::handle_relayout");
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto elapsed_ms = [start]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    // Lay out parents before their descendants: a descendant that is queued, too, will usually have been
+    // laid out along with its ancestor, and its own (then no-op) pass will be skipped.
+    mrelayout_queue.clear();
+    for (Widget* w : mrelayout_widgets)
+        mrelayout_queue.emplace_back(widget_depth(w), w);
+    std::sort(mrelayout_queue.begin(), mrelayout_queue.end(),
+              [](const std::pair<int, Widget*>& a, const std::pair<int, Widget*>& b) {
+                  return a.first < b.first;
+              });
+
+    LayoutPassStats stats;
+    stats.queued = mrelayout_queue.size();
+    DBG_LAYOUT("################ LAYOUT BEGINS\n");
+    mlayout_in_progress = true;
+    for (const auto& entry : mrelayout_queue) {
+        Widget* relayout_widget = entry.second;
+        auto it = mrelayout_widgets.find(relayout_widget);
+        if (it == mrelayout_widgets.end())
+            continue; // deregistered in the meantime
+        if (use_budget && mlayout_budget_ms > 0 && stats.laid_out > 0 && elapsed_ms() > mlayout_budget_ms)
+            break;
+        mrelayout_widgets.erase(it);
+        if (!relayout_widget->needs_relayout()) {
+            stats.skipped++;
+            continue;
+        }
 #ifdef LGUI_DEBUG_ENABLE_RTTI
-            DBG_LAYOUT("##### LAYOUT RUNS for %p (%s)\n", relayout_widget, typeid(*relayout_widget).name());
+        DBG_LAYOUT("##### LAYOUT RUNS for %p (%s)\n", relayout_widget, typeid(*relayout_widget).name());
 #else
-            DBG_LAYOUT("##### LAYOUT RUNS for %p\n", relayout_widget);
+        DBG_LAYOUT("##### LAYOUT RUNS for %p\n", relayout_widget);
 #endif
-            relayout_widget->_relayout();
-        }
-        mrelayout_widgets.clear();
-        DBG_LAYOUT("################ LAYOUT ENDS\n");
-        mlayout_in_progress = false;
+        relayout_widget->_relayout();
+        stats.laid_out++;
+        LGUI_PROFILE_COUNT(LayoutPasses, 1);
     }
+    stats.deferred = mrelayout_widgets.size();
+    DBG_LAYOUT("################ LAYOUT ENDS\n");
+    mlayout_in_progress = false;
+    stats.ms = elapsed_ms();
+    mlast_layout_stats = stats;
 }
 
 void GUI::handle_deferred_callbacks() {
+    LGUI_PROFILE_SCOPE("GUI::handle_deferred_callbacks");
     mhandling_deferred_callbacks = true;
     for (auto& callback : mdeferred_callbacks) {
         callback();
@@ -241,8 +415,10 @@ void GUI::_bring_to_front(Widget& w) {
         mdeferred_actions.emplace_back(DeferredAction::BringToFront, &w);
         return;
     }
-    if (w.parent())
+    if (w.parent()) {
         w.parent()->_bring_child_to_front(w);
+        w.invalidate();
+    }
 }
 
 void GUI::_send_to_back(Widget& w) {
@@ -250,8 +426,10 @@ void GUI::_send_to_back(Widget& w) {
         mdeferred_actions.emplace_back(DeferredAction::SendToBack, &w);
         return;
     }
-    if (w.parent())
+    if (w.parent()) {
         w.parent()->_send_child_to_back(w);
+        w.invalidate();
+    }
 }
 
 void GUI::_request_layout(Widget& w) {
@@ -264,12 +442,16 @@ void GUI::_request_layout(Widget& w) {
 bool GUI::_request_modal_widget(Widget& w) {
     bool success = mevent_handler._request_modal_widget(w);
     mmodal_widget = mevent_handler.modal_widget();
+    if (success)
+        w.invalidate();
     return success;
 }
 
 bool GUI::_release_modal_widget(Widget& w) {
     bool success = mevent_handler._release_modal_widget(w);
     mmodal_widget = mevent_handler.modal_widget();
+    if (success)
+        w.invalidate();
     return success;
 }
 
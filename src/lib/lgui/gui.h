@@ -43,6 +43,7 @@
 #include <deque>
 #include <unordered_set>
 #include <functional>
+#include <vector>
 
 #include "widget.h"
 #include "lgui/platform/color.h"
@@ -56,6 +57,15 @@ class DragRepresentation;
 
 using TopWidget = Widget;
 
+/** Statistics about the last layout pass run by the GUI. */
+struct LayoutPassStats {
+    int queued = 0;     /**< widgets that were queued for relayout at the start of the pass */
+    int laid_out = 0;   /**< widgets whose layout process has been run */
+    int skipped = 0;    /**< queued widgets that had already been laid out with an ancestor */
+    int deferred = 0;   /**< widgets left queued for the next pass because the budget was exhausted */
+    double ms = 0.0;    /**< duration of the pass in milliseconds */
+};
+
 /** The main %GUI class. You'll need one of those. Push external events to it and it will distribute them
  *  to the widgets. Call draw_widgets() to draw the GUI. Push (and pop) top-widgets. */
 class GUI {
@@ -63,13 +73,62 @@ class GUI {
         GUI();
         ~GUI() = default;
 
-        /** Draws the GUI. */
-        void draw_widgets(Graphics& gfx);
+        /** Draws the GUI.
+         *  If damage tracking is enabled, only widgets intersecting the damaged area will be drawn and
+         *  drawing will be clipped to the bounding box of the damage, which is cleared to the background
+         *  color first. The damage is cleared afterwards.
+         *  @return whether anything has been drawn. This will always be `true` if damage tracking is
+         *          disabled. If it returns `false`, the host loop can skip flipping the display.
+         *  @note Widgets are drawn on the calling thread only. Most of the work of a frame is done by the
+         *        backend, which has to be done on the thread the display is current on, and the text the
+         *        widgets measure and shape goes through a lock of the font. To take the backend's work off
+         *        the GUI thread, use a RenderThread.
+         *  @see set_damage_tracking */
+        bool draw_widgets(Graphics& gfx);
+
+        /** Enable or disable damage tracking. With damage tracking enabled, widgets report the areas
+         *  that need to be redrawn (e.g. when their rect, visibility, style or opacity changes, when they
+         *  handle input events or receive timer ticks) and draw_widgets() will only redraw what has been
+         *  damaged. Everything is considered damaged after enabling it.
+         *  draw_widgets() will repaint the background of the damaged area itself (see
+         *  set_background_color()).
+         *  @note The contents of the drawing target have to persist between frames for this to work, so
+         *        the host must not clear it before calling draw_widgets() - that would erase everything
+         *        that isn't redrawn. Don't use it with a backbuffer whose contents are undefined after
+         *        flipping either; draw to an intermediate bitmap in that case. */
+        void set_damage_tracking(bool enabled);
+
+        /** Set the color draw_widgets() clears the damaged area to before redrawing it when damage tracking
+         *  is enabled. Opaque black by default. Recordings (see Graphics::begin_recording()) don't contain
+         *  the background. Changing it will consider everything damaged. */
+        void set_background_color(const Color& col);
+
+        /** Return the color the damaged area is cleared to. */
+        const Color& background_color() const { return mbackground_color; }
+
+        /** Return whether damage tracking is enabled. */
+        bool is_damage_tracking_enabled() const { return mdamage_tracking; }
+
+        /** Return whether there's anything to be redrawn. Always `true` if damage tracking is disabled. */
+        bool has_damage() const { return !mdamage_tracking || mdamage_all || !mdamage.empty(); }
+
+        /** Return the current damage regions in absolute coordinates. Overlapping regions are merged.
+         *  This will be empty if everything has been invalidated via invalidate_all(). */
+        const std::vector<Rect>& damage() const { return mdamage; }
+
+        /** Consider everything damaged, e.g. after the display has been resized or its contents have
+         *  been lost. */
+        void invalidate_all();
 
         /** Processes the external event passed and distributes resulting
          *  events to the widgets. */
         void push_external_event(const ExternalEvent& event);
 
+        /** Return the timestamp of the earliest external event other than a timer tick that has been pushed
+         *  since the last call to draw_widgets(), or a negative value if there hasn't been any. The time from
+         *  it to the flip of the next frame is the latency of the GUI's reaction. @see RenderThread */
+        double undrawn_event_timestamp() const { return mundrawn_event_timestamp; }
+
         /** This can be called to trigger processing of deferred actions (layout,
          *  pushing / popping top widgets,changing drawing order, updating under-mouse buffer).
          *  This is automatically called after processing each external event. However, there are
@@ -106,6 +165,20 @@ class GUI {
          */
         void pop_top_widget();
 
+        /** Set a time budget in milliseconds for the layout pass run while handling deferred actions. When it
+         *  is exceeded, the widgets still queued for relayout are left for the next pass, i.e. the next event,
+         *  so expensive relayouts of several independent parts of the GUI are spread over time instead of
+         *  blocking input. At least one widget is laid out per pass. Layout passes triggered by pushing or
+         *  popping top-widgets always run to completion. 0 (the default) means no limit. */
+        void set_layout_budget(double ms) { mlayout_budget_ms = ms; }
+        double layout_budget() const { return mlayout_budget_ms; }
+
+        /** Return whether there are widgets waiting to be laid out. */
+        bool has_pending_relayout() const { return !mrelayout_widgets.empty(); }
+
+        /** Return statistics about the last layout pass that has done anything. */
+        const LayoutPassStats& last_layout_pass_stats() const { return mlast_layout_stats; }
+
         /** Returns the current top-widget. */
         TopWidget* top_widget() { return mtop_widget; } // used by focus manager
 
@@ -137,12 +210,17 @@ class GUI {
         void _subscribe_to_timer_ticks(Widget& w) { mevent_handler._subscribe_to_timer_ticks(w); }
         void _unsubscribe_from_timer_ticks(Widget& w) { mevent_handler._unsubscribe_from_timer_ticks(w); }
         void _enqueue_deferred(const std::function<void()>& callback);
+        void _add_damage(const Rect& r);
 
     private:
         void set_top(TopWidget* top);
 
+        void do_draw_widgets(Graphics& gfx, const Rect* damage_bounds);
+        void update_drag_damage();
+        void clear_damage();
+
         void handle_deferred_actions();
-        void handle_relayout();
+        void handle_relayout(bool use_budget = false);
         void handle_deferred_callbacks();
 
         dtl::EventHandler mevent_handler;
@@ -182,12 +260,23 @@ class GUI {
 
         std::vector<std::function<void()>> mdeferred_callbacks;
 
+        // Widgets at the top of a layout hierarchy that have requested layout. Processed top-down.
         std::unordered_set<Widget*> mrelayout_widgets;
+        std::vector<std::pair<int, Widget*>> mrelayout_queue; // (depth, widget), reused
+        double mlayout_budget_ms;
+        LayoutPassStats mlast_layout_stats;
 
         AnimationContext manimation_context;
         AnimationFacilities manimation_facilities;
 
+        std::vector<Rect> mdamage;
+        Rect mlast_drag_rect;
+        Color mbackground_color;
+
+        double mundrawn_event_timestamp;
+
         bool munder_mouse_invalid, mhandling_events, mlayout_in_progress, mhandling_deferred_callbacks;
+        bool mdamage_tracking, mdamage_all, mhad_drag_repr;
 };
 
 }
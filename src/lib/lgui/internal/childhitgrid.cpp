@@ -0,0 +1,196 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "childhitgrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "lgui/widget.h"
+#include "lgui/platform/error.h"
+
+namespace lgui {
+namespace dtl {
+
+// Aim for this many children per cell on average.
+static const int children_per_cell = 2;
+static const int min_cell_size = 8;
+
+ChildHitGrid::ChildHitGrid()
+        : mcell_w(1), mcell_h(1), mcols(0), mrows(0), mtop_rank(0), mbottom_rank(0), mneeds_rebuild(true) {}
+
+void ChildHitGrid::rebuild(const Rect& area, const std::vector<Widget*>& children) {
+    marea = area;
+    int no_cells = std::max<int>(1, children.size() / children_per_cell);
+    double cell_area = double(std::max(area.w(), 1)) * std::max(area.h(), 1) / no_cells;
+    mcell_w = mcell_h = std::max(min_cell_size, int(std::ceil(std::sqrt(cell_area))));
+    mcols = std::max(1, (area.w() + mcell_w - 1) / mcell_w);
+    mrows = std::max(1, (area.h() + mcell_h - 1) / mcell_h);
+
+    mcells.assign(mcols * mrows, std::vector<Item>());
+    malways_test.clear();
+    mentries.clear();
+    mmoved.clear();
+    mtop_rank = mbottom_rank = 0;
+    mneeds_rebuild = false;
+    for (Widget* c : children)
+        add(*c);
+}
+
+void ChildHitGrid::add(Widget& child) {
+    if (mneeds_rebuild)
+        return;
+    Entry& e = mentries[&child];
+    e.rank = ++mtop_rank;
+    e.moved = false;
+    insert(child, e);
+}
+
+void ChildHitGrid::remove(Widget& child) {
+    if (mneeds_rebuild)
+        return;
+    auto it = mentries.find(&child);
+    if (it == mentries.end())
+        return;
+    if (it->second.moved)
+        mmoved.erase(std::remove(mmoved.begin(), mmoved.end(), &child), mmoved.end());
+    erase(child, it->second);
+    mentries.erase(it);
+}
+
+void ChildHitGrid::bring_to_front(Widget& child) {
+    auto it = mentries.find(&child);
+    if (it != mentries.end())
+        it->second.rank = ++mtop_rank;
+}
+
+void ChildHitGrid::send_to_back(Widget& child) {
+    auto it = mentries.find(&child);
+    if (it != mentries.end())
+        it->second.rank = --mbottom_rank;
+}
+
+void ChildHitGrid::child_moved(Widget& child) {
+    if (mneeds_rebuild)
+        return;
+    auto it = mentries.find(&child);
+    if (it != mentries.end() && !it->second.moved) {
+        it->second.moved = true;
+        mmoved.push_back(&child);
+    }
+}
+
+void ChildHitGrid::insert(Widget& child, Entry& e) {
+    e.always_test = !child.transformation().is_identity() || child.is_outside_children_area();
+    e.cx1 = e.cy1 = 0;
+    e.cx2 = e.cy2 = -1;
+    Item item{&child, &e};
+    if (e.always_test) {
+        malways_test.push_back(item);
+        return;
+    }
+    Rect r = child.rect().translated(marea.pos());
+    if (r.w() <= 0 || r.h() <= 0 || !r.overlaps(marea))
+        return; // can't be hit
+    e.cx1 = std::max(0, (r.x() - marea.x()) / mcell_w);
+    e.cy1 = std::max(0, (r.y() - marea.y()) / mcell_h);
+    e.cx2 = std::min(mcols - 1, (r.x2() - marea.x()) / mcell_w);
+    e.cy2 = std::min(mrows - 1, (r.y2() - marea.y()) / mcell_h);
+    for (int cy = e.cy1; cy <= e.cy2; ++cy) {
+        for (int cx = e.cx1; cx <= e.cx2; ++cx)
+            mcells[cy * mcols + cx].push_back(item);
+    }
+}
+
+void ChildHitGrid::erase(Widget& child, Entry& e) {
+    if (e.always_test) {
+        erase_item(malways_test, &child);
+        return;
+    }
+    for (int cy = e.cy1; cy <= e.cy2; ++cy) {
+        for (int cx = e.cx1; cx <= e.cx2; ++cx)
+            erase_item(mcells[cy * mcols + cx], &child);
+    }
+}
+
+void ChildHitGrid::update_moved() {
+    for (Widget* w : mmoved) {
+        Entry& e = mentries[w];
+        erase(*w, e);
+        insert(*w, e);
+        e.moved = false;
+    }
+    mmoved.clear();
+}
+
+void ChildHitGrid::test(const Item& item, PointF p, Widget*& best, int64_t& best_rank) const {
+    if (item.e->rank > best_rank && item.w->is_visible() && item.w->is_active() && item.w->is_inside(p)) {
+        best = item.w;
+        best_rank = item.e->rank;
+    }
+}
+
+Widget* ChildHitGrid::child_at(PointF p) {
+    ASSERT(!mneeds_rebuild);
+    update_moved();
+    Widget* best = nullptr;
+    int64_t best_rank = std::numeric_limits<int64_t>::min();
+    int cx = int(std::floor((p.x() - marea.x()) / mcell_w));
+    int cy = int(std::floor((p.y() - marea.y()) / mcell_h));
+    if (cx >= 0 && cx < mcols && cy >= 0 && cy < mrows) {
+        for (const Item& item : mcells[cy * mcols + cx])
+            test(item, p, best, best_rank);
+    }
+    for (const Item& item : malways_test)
+        test(item, p, best, best_rank);
+    return best;
+}
+
+void ChildHitGrid::erase_item(std::vector<Item>& items, const Widget* w) {
+    for (auto& item : items) {
+        if (item.w == w) {
+            item = items.back();
+            items.pop_back();
+            return;
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,120 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_CHILDHITGRID_H
+#define LGUI_CHILDHITGRID_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "lgui/lgui_types.h"
+
+namespace lgui {
+
+class Widget;
+
+namespace dtl {
+
+/** A uniform grid over a container's children area, remembering which children overlap each cell, used to
+ *  find the child at a point without testing every child. Children are ranked by z-order so the topmost
+ *  candidate can be picked regardless of the order within a cell.
+ *
+ *  Children with a transformation or outside the children area can't be put into cells reliably; they are kept
+ *  in a list tested for every lookup. Visibility, activeness and irregular shapes are checked at lookup time
+ *  (via Widget::is_inside()), so the grid only needs to know about changes of the children's rects.
+ *
+ *  Moved children are only marked and re-inserted on the next lookup, so relaying out all children doesn't
+ *  cost more than one rebuild. */
+class ChildHitGrid {
+    public:
+        ChildHitGrid();
+
+        /** Rebuild the grid for `children` (back to front) inside `area`, given in parent coordinates. */
+        void rebuild(const Rect& area, const std::vector<Widget*>& children);
+
+        /** Return whether the grid has to be rebuilt before the next lookup. */
+        bool needs_rebuild() const { return mneeds_rebuild; }
+        /** Request a rebuild, e.g. because the children area has changed. */
+        void invalidate() { mneeds_rebuild = true; }
+
+        /** Add a child on top of all others. */
+        void add(Widget& child);
+        void remove(Widget& child);
+        void bring_to_front(Widget& child);
+        void send_to_back(Widget& child);
+        /** Mark a child whose rect or transformation has changed. */
+        void child_moved(Widget& child);
+
+        /** Return the topmost visible and active child `p` is inside of, or nullptr. `p` is in parent
+         *  coordinates and must be within the area. */
+        Widget* child_at(PointF p);
+
+    private:
+        struct Entry {
+            int64_t rank;   // higher is further on top
+            int cx1, cy1, cx2, cy2; // cell range; empty if cx1 > cx2
+            bool always_test;
+            bool moved;
+        };
+
+        struct Item {
+            Widget* w;
+            const Entry* e; // entries are node-based, so this stays valid
+        };
+
+        void insert(Widget& child, Entry& e);
+        void erase(Widget& child, Entry& e);
+        void update_moved();
+        void test(const Item& item, PointF p, Widget*& best, int64_t& best_rank) const;
+        static void erase_item(std::vector<Item>& items, const Widget* w);
+
+        Rect marea;
+        int mcell_w, mcell_h, mcols, mrows;
+        std::vector<std::vector<Item>> mcells;
+        std::vector<Item> malways_test;
+        std::unordered_map<const Widget*, Entry> mentries;
+        std::vector<Widget*> mmoved;
+        int64_t mtop_rank, mbottom_rank;
+        bool mneeds_rebuild;
+};
+
+}
+}
+
+#endif // LGUI_CHILDHITGRID_H
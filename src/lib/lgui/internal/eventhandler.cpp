@@ -41,6 +41,7 @@
 #include "lgui/dragrepresentation.h"
 
 #include "lgui/platform/keycodes.h"
+#include "lgui/profiler.h"
 
 namespace lgui {
 
@@ -54,6 +55,7 @@ EventHandler::EventHandler(GUI& gui)
 
 
 void EventHandler::push_external_event(const lgui::ExternalEvent& event) {
+    LGUI_PROFILE_SCOPE("EventHandler::push_external_event");
     // to generate events with a reasonable timestamp:
     mmouse_handler.set_last_timestamp(event.timestamp);
 
@@ -39,6 +39,9 @@
 
 #include "focusmanager.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "lgui/platform/error.h"
 
 #include "lgui/widget.h"
@@ -56,6 +59,7 @@ FocusManager::FocusManager(dtl::EventHandlerBase& handler)
 
 void FocusManager::add(Widget& widget) {
     mwidgets.push_back(&widget);
+    mknown_widgets.insert(&widget);
 }
 
 void FocusManager::remove(Widget& widget) {
@@ -65,12 +69,11 @@ void FocusManager::remove(Widget& widget) {
         release_modal_focus(widget);
     if (mfocus_widget == &widget)
         focus_none();
-    for (auto it = mwidgets.begin(); it != mwidgets.end(); ++it) {
-        if (*it == &widget) {
-            mwidgets.erase(it);
-            break;
-        }
-    }
+    // Search from the end: children are removed topmost first, see BasicContainer::remove_all_children().
+    auto it = std::find(mwidgets.rbegin(), mwidgets.rend(), &widget);
+    if (it != mwidgets.rend())
+        mwidgets.erase(std::next(it).base());
+    mknown_widgets.erase(&widget);
 }
 
 bool FocusManager::is_parent_of_focus_widget(const Widget* w) const {
@@ -185,11 +188,7 @@ void FocusManager::widget_became_invisible(Widget& w) {
 }
 
 bool FocusManager::know_widget(const Widget& widget) const {
-    for (const Widget* w : mwidgets) {
-        if (&widget == w)
-            return true;
-    }
-    return false;
+    return mknown_widgets.count(&widget) > 0;
 }
 
 bool FocusManager::tab_move_focus(bool rev) {
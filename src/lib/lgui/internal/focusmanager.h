@@ -40,6 +40,7 @@
 #ifndef LGUI_FOCUSMANAGER_H
 #define LGUI_FOCUSMANAGER_H
 
+#include <unordered_set>
 #include <vector>
 #include "lgui/platform/error.h"
 #include "lgui/focusevent.h"
@@ -104,7 +105,8 @@ class FocusManager {
         static void send_focus_event(Widget* w, FocusEvent::Type type);
 
         Widget* mfocus_widget, * mmodal_focus_widget;
-        std::vector<Widget*> mwidgets;
+        std::vector<Widget*> mwidgets; // in tab order
+        std::unordered_set<const Widget*> mknown_widgets;
         dtl::EventHandlerBase& mhandler;
 };
 
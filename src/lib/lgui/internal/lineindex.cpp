@@ -0,0 +1,197 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "lineindex.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "lgui/textsource.h"
+#include "lgui/platform/error.h"
+
+namespace lgui {
+namespace dtl {
+
+static const size_t READ_CHUNK_SIZE = 1 << 16;
+
+LineIndex::LineIndex()
+        : msource(nullptr), msize(0), mscanned(0), mfound_scanned(0), mfound_size(0), mstop(false) {}
+
+LineIndex::~LineIndex() {
+    stop();
+}
+
+void LineIndex::stop() {
+    if (mthread.joinable()) {
+        mstop = true;
+        mthread.join();
+    }
+    mstop = false;
+}
+
+void LineIndex::reset(const TextSource* source) {
+    stop();
+    msource = source;
+    msize = source ? source->size() : 0;
+    mscanned = 0;
+    mblock_base.clear();
+    mrel.clear();
+    mblock_base.shrink_to_fit();
+    mrel.shrink_to_fit();
+    mfound.clear();
+    mfound.shrink_to_fit();
+    mfound_scanned = 0;
+    mfound_size = msize;
+    if (source) {
+        add_line_start(0);
+        if (msize > 0)
+            mthread = std::thread(&LineIndex::scan, this);
+    }
+}
+
+void LineIndex::add_line_start(uint64_t offs) {
+    if (mrel.size() % LINES_PER_BLOCK == 0)
+        mblock_base.push_back(offs);
+    uint64_t rel = offs - mblock_base.back();
+    // would need a block of lines larger than 4 GB
+    ASSERT(rel <= UINT32_MAX);
+    mrel.push_back(uint32_t(rel));
+}
+
+void LineIndex::scan() {
+    const char* data = msource->data();
+    uint64_t size;
+    {
+        std::lock_guard<std::mutex> lock(mmutex);
+        size = mfound_size;
+    }
+    std::vector<char> buffer;
+    std::vector<uint64_t> found;
+    uint64_t scanned = 0;
+    while (scanned < size && !mstop) {
+        size_t n = size_t(std::min<uint64_t>(size - scanned, READ_CHUNK_SIZE));
+        const char* chunk;
+        bool end = false;
+        if (data)
+            chunk = data + scanned;
+        else {
+            buffer.resize(READ_CHUNK_SIZE);
+            n = msource->read(scanned, n, buffer.data());
+            end = n == 0; // source shrunk or failed: treat as end
+            chunk = buffer.data();
+        }
+        const char* p = chunk;
+        const char* chunk_end = chunk + n;
+        while ((p = static_cast<const char*>(std::memchr(p, '\n', chunk_end - p))) != nullptr) {
+            p++;
+            found.push_back(scanned + (p - chunk));
+        }
+        scanned += n;
+        {
+            std::lock_guard<std::mutex> lock(mmutex);
+            mfound.insert(mfound.end(), found.begin(), found.end());
+            mfound_scanned = scanned;
+            if (end)
+                mfound_size = scanned;
+        }
+        mfound_condition.notify_all();
+        found.clear();
+        if (end)
+            break;
+    }
+}
+
+bool LineIndex::take_found() {
+    if (mfound_scanned == mscanned)
+        return false;
+    for (uint64_t offs : mfound)
+        add_line_start(offs);
+    mfound.clear();
+    mscanned = mfound_scanned;
+    msize = mfound_size;
+    return true;
+}
+
+bool LineIndex::update() {
+    if (is_complete())
+        return false;
+    std::lock_guard<std::mutex> lock(mmutex);
+    return take_found();
+}
+
+void LineIndex::index_up_to_line(size_t line) {
+    if (is_complete() || line_count() > line + 1)
+        return;
+    std::unique_lock<std::mutex> lock(mmutex);
+    take_found();
+    while (!is_complete() && line_count() <= line + 1) {
+        mfound_condition.wait(lock, [this]() { return mfound_scanned != mscanned; });
+        take_found();
+    }
+}
+
+size_t LineIndex::estimated_line_count() const {
+    if (is_complete() || mscanned == 0)
+        return line_count();
+    return std::max(line_count(), size_t(double(line_count()) * double(msize) / double(mscanned)));
+}
+
+uint64_t LineIndex::line_start(size_t line) const {
+    ASSERT(line < mrel.size());
+    return mblock_base[line / LINES_PER_BLOCK] + mrel[line];
+}
+
+uint64_t LineIndex::line_end(size_t line) const {
+    if (line + 1 < mrel.size())
+        return line_start(line + 1) - 1;
+    return mscanned;
+}
+
+std::string LineIndex::line_text(size_t line, size_t max_bytes) const {
+    if (!msource || line >= mrel.size())
+        return std::string();
+    uint64_t start = line_start(line), end = line_end(line);
+    std::string text = msource->substr(start, size_t(std::min<uint64_t>(end - start, max_bytes)));
+    if (!text.empty() && text.back() == '\r' && end - start <= max_bytes)
+        text.pop_back();
+    return text;
+}
+
+}
+}
@@ -0,0 +1,120 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_LINEINDEX_H
+#define LGUI_LINEINDEX_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace lgui {
+
+class TextSource;
+
+namespace dtl {
+
+/** Index of the line starts of a TextSource, built incrementally: a background thread scans the source for
+ *  line breaks, and update() takes over the line starts it has found so far, so the GUI thread never scans
+ *  the source itself. index_up_to_line() waits just as long as needed for a line. Line starts are stored as
+ *  32-bit offsets relative to a 64-bit base per block of lines, i.e. roughly 4 bytes per line. */
+class LineIndex {
+    public:
+        LineIndex();
+        ~LineIndex();
+
+        LineIndex(const LineIndex& other) = delete;
+        LineIndex& operator=(const LineIndex& other) = delete;
+
+        /** Start indexing a new source on a background thread, stopping any indexing of the previous one.
+         *  Pass nullptr to release the index. */
+        void reset(const TextSource* source);
+
+        /** Take over the line starts found by the background thread since the last call. Return true if
+         *  anything has changed. */
+        bool update();
+        /** Wait until `line` is known to exist and its end is known (or the whole source is indexed). */
+        void index_up_to_line(size_t line);
+
+        bool is_complete() const { return mscanned == msize; }
+        uint64_t indexed_bytes() const { return mscanned; }
+
+        /** Return the number of lines found so far. Only final if is_complete(). */
+        size_t line_count() const { return mrel.size(); }
+        /** Return the number of lines, extrapolated from the part indexed so far if not complete. */
+        size_t estimated_line_count() const;
+
+        /** Return the byte offset of the start of `line`. */
+        uint64_t line_start(size_t line) const;
+        /** Return the byte offset of the end of `line` (not including '\n'). */
+        uint64_t line_end(size_t line) const;
+        /** Read the text of `line`, without the line terminator. Reads at most `max_bytes`. */
+        std::string line_text(size_t line, size_t max_bytes) const;
+
+    private:
+        static const size_t LINES_PER_BLOCK = 64;
+
+        void add_line_start(uint64_t offs);
+        void stop();
+        void scan(); // run by the background thread
+        bool take_found(); // with mmutex held
+
+        const TextSource* msource;
+        uint64_t msize, mscanned;
+        std::vector<uint64_t> mblock_base;
+        std::vector<uint32_t> mrel;
+
+        // Shared with the background thread, guarded by mmutex.
+        std::mutex mmutex;
+        std::condition_variable mfound_condition;
+        std::vector<uint64_t> mfound; // line starts not taken over yet
+        uint64_t mfound_scanned, mfound_size;
+
+        std::atomic<bool> mstop;
+        std::thread mthread;
+};
+
+}
+}
+
+#endif // LGUI_LINEINDEX_H
@@ -0,0 +1,108 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_MEASURECACHE_H
+#define LGUI_MEASURECACHE_H
+
+#include <cstdint>
+#include "lgui/lgui_layout_types.h"
+
+namespace lgui {
+
+/** Counters of the measure cache; see Widget::measure_cached(). */
+struct MeasureCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    /** Return the fraction of lookups that have been hits (0 if there haven't been any lookups). */
+    double hit_rate() const {
+        return hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0;
+    }
+};
+
+namespace dtl {
+
+/** Remembers the results of the last few measure() calls of a widget, keyed on the constraint pair. Layouts
+ *  typically measure a child several times with identical constraints during one layout pass (and again in
+ *  the next pass if nothing has changed), so a handful of entries is enough. */
+class MeasureCache {
+    public:
+        bool lookup(SizeConstraint wc, SizeConstraint hc, MeasureResults& result) const {
+            for (int i = 0; i < mused; i++) {
+                if (mentries[i].wc == wc && mentries[i].hc == hc) {
+                    result = mentries[i].result;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void store(SizeConstraint wc, SizeConstraint hc, const MeasureResults& result) {
+            Entry& e = mentries[mnext];
+            e.wc = wc;
+            e.hc = hc;
+            e.result = result;
+            mnext = (mnext + 1) % NO_ENTRIES;
+            if (mused < NO_ENTRIES)
+                mused++;
+        }
+
+        void clear() {
+            mused = 0;
+            mnext = 0;
+        }
+
+        bool empty() const { return mused == 0; }
+
+    private:
+        static const int NO_ENTRIES = 4;
+
+        struct Entry {
+            SizeConstraint wc, hc;
+            MeasureResults result;
+        };
+
+        Entry mentries[NO_ENTRIES];
+        uint8_t mused = 0, mnext = 0;
+};
+
+}
+}
+
+#endif // LGUI_MEASURECACHE_H
@@ -0,0 +1,315 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "piecetable.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "lgui/platform/error.h"
+
+namespace lgui {
+namespace dtl {
+
+template <typename Func>
+bool PieceTable::visit(int t, size_t base, size_t from, size_t to, Func& f) const {
+    if (t < 0 || from >= to)
+        return false;
+    const Node& n = mnodes[t];
+    size_t nstart = base + sum(n.left), nend = nstart + n.len;
+    if (from < nstart && visit(n.left, base, from, to, f))
+        return true;
+    if (from < nend && to > nstart) {
+        size_t a = std::max(from, nstart), b = std::min(to, nend);
+        if (f(data(n) + (a - nstart), b - a, a))
+            return true;
+    }
+    if (to > nend)
+        return visit(n.right, nend, from, to, f);
+    return false;
+}
+
+template <typename Func>
+bool PieceTable::visit_backwards(int t, size_t base, size_t from, size_t to, Func& f) const {
+    if (t < 0 || from >= to)
+        return false;
+    const Node& n = mnodes[t];
+    size_t nstart = base + sum(n.left), nend = nstart + n.len;
+    if (to > nend && visit_backwards(n.right, nend, from, to, f))
+        return true;
+    if (from < nend && to > nstart) {
+        size_t a = std::max(from, nstart), b = std::min(to, nend);
+        if (f(data(n) + (a - nstart), b - a, a))
+            return true;
+    }
+    if (from < nstart)
+        return visit_backwards(n.left, base, from, to, f);
+    return false;
+}
+
+PieceTable::PieceTable()
+        : mroot(-1), mseed(0x9e3779b9), mcache_valid(true) {}
+
+PieceTable::PieceTable(std::string text)
+        : PieceTable() {
+    assign(std::move(text));
+}
+
+void PieceTable::assign(std::string text) {
+    clear();
+    morig = std::move(text);
+    if (!morig.empty())
+        mroot = new_node(false, 0, morig.size());
+    mcache_valid = false;
+}
+
+void PieceTable::clear() {
+    morig.clear();
+    madd.clear();
+    mnodes.clear();
+    mfree_nodes.clear();
+    mroot = -1;
+    mcache.clear();
+    mcache_valid = true;
+}
+
+size_t PieceTable::size() const {
+    return sum(mroot);
+}
+
+void PieceTable::insert(size_t pos, const std::string& str) {
+    if (str.empty())
+        return;
+    ASSERT(pos <= size());
+    size_t add_start = madd.size();
+    madd.append(str);
+    int l, r;
+    split(mroot, pos, l, r);
+    // Typing appends to the add buffer right after the previous insertion: just grow that piece.
+    if (!extend_last(l, add_start, str.size()))
+        l = merge(l, new_node(true, add_start, str.size()));
+    mroot = merge(l, r);
+    mcache_valid = false;
+}
+
+void PieceTable::erase(size_t pos, size_t n) {
+    size_t sz = size();
+    if (pos >= sz || n == 0)
+        return;
+    n = std::min(n, sz - pos);
+    int l, m, r;
+    split(mroot, pos, l, m);
+    split(m, n, m, r);
+    free_subtree(m);
+    mroot = merge(l, r);
+    mcache_valid = false;
+}
+
+char PieceTable::at(size_t pos) const {
+    ASSERT(pos < size());
+    int t = mroot;
+    while (t >= 0) {
+        const Node& n = mnodes[t];
+        size_t lsum = sum(n.left);
+        if (pos < lsum)
+            t = n.left;
+        else if (pos < lsum + n.len)
+            return data(n)[pos - lsum];
+        else {
+            pos -= lsum + n.len;
+            t = n.right;
+        }
+    }
+    return 0;
+}
+
+std::string PieceTable::substr(size_t pos, size_t n) const {
+    std::string s;
+    size_t sz = size();
+    if (pos >= sz)
+        return s;
+    n = std::min(n, sz - pos);
+    s.reserve(n);
+    auto append = [&s](const char* p, size_t len, size_t) {
+        s.append(p, len);
+        return false;
+    };
+    visit(mroot, 0, pos, pos + n, append);
+    return s;
+}
+
+size_t PieceTable::find(char c, size_t pos) const {
+    size_t found = npos;
+    auto search = [c, &found](const char* p, size_t len, size_t offs) {
+        const void* hit = std::memchr(p, c, len);
+        if (hit) {
+            found = offs + (static_cast<const char*>(hit) - p);
+            return true;
+        }
+        return false;
+    };
+    visit(mroot, 0, pos, size(), search);
+    return found;
+}
+
+size_t PieceTable::rfind(char c, size_t pos) const {
+    size_t sz = size();
+    if (sz == 0)
+        return npos;
+    size_t to = std::min(pos, sz - 1) + 1;
+    size_t found = npos;
+    auto search = [c, &found](const char* p, size_t len, size_t offs) {
+        for (size_t i = len; i > 0; i--) {
+            if (p[i - 1] == c) {
+                found = offs + i - 1;
+                return true;
+            }
+        }
+        return false;
+    };
+    visit_backwards(mroot, 0, 0, to, search);
+    return found;
+}
+
+const std::string& PieceTable::str() const {
+    if (!mcache_valid) {
+        mcache = substr(0);
+        mcache_valid = true;
+    }
+    return mcache;
+}
+
+int PieceTable::new_node(bool add, size_t start, size_t len) {
+    // xorshift32: priorities only need to be reasonably random to keep the treap balanced
+    mseed ^= mseed << 13;
+    mseed ^= mseed >> 17;
+    mseed ^= mseed << 5;
+    Node n{start, len, len, -1, -1, mseed, add};
+    if (!mfree_nodes.empty()) {
+        int t = mfree_nodes.back();
+        mfree_nodes.pop_back();
+        mnodes[t] = n;
+        return t;
+    }
+    mnodes.push_back(n);
+    return signed(mnodes.size()) - 1;
+}
+
+void PieceTable::free_subtree(int t) {
+    if (t < 0)
+        return;
+    free_subtree(mnodes[t].left);
+    free_subtree(mnodes[t].right);
+    mfree_nodes.push_back(t);
+}
+
+void PieceTable::update(int t) {
+    Node& n = mnodes[t];
+    n.sum = n.len + sum(n.left) + sum(n.right);
+}
+
+int PieceTable::merge(int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (mnodes[a].prio > mnodes[b].prio) {
+        mnodes[a].right = merge(mnodes[a].right, b);
+        update(a);
+        return a;
+    }
+    else {
+        mnodes[b].left = merge(a, mnodes[b].left);
+        update(b);
+        return b;
+    }
+}
+
+void PieceTable::split(int t, size_t pos, int& l, int& r) {
+    if (t < 0) {
+        l = r = -1;
+        return;
+    }
+    size_t lsum = sum(mnodes[t].left);
+    size_t len = mnodes[t].len;
+    int a, b;
+    if (pos <= lsum) {
+        split(mnodes[t].left, pos, a, b);
+        mnodes[t].left = b;
+        update(t);
+        l = a;
+        r = t;
+    }
+    else if (pos >= lsum + len) {
+        split(mnodes[t].right, pos - lsum - len, a, b);
+        mnodes[t].right = a;
+        update(t);
+        l = t;
+        r = b;
+    }
+    else {
+        // Split inside this piece: the tail becomes a new node in front of the right subtree.
+        size_t k = pos - lsum;
+        int tail = new_node(mnodes[t].add, mnodes[t].start + k, len - k);
+        int right = mnodes[t].right;
+        mnodes[t].len = k;
+        mnodes[t].right = -1;
+        update(t);
+        l = t;
+        r = merge(tail, right);
+    }
+}
+
+bool PieceTable::extend_last(int t, size_t add_start, size_t n) {
+    if (t < 0)
+        return false;
+    int last = t;
+    while (mnodes[last].right >= 0)
+        last = mnodes[last].right;
+    const Node& ln = mnodes[last];
+    if (!ln.add || ln.start + ln.len != add_start)
+        return false;
+    for (int i = t; i >= 0; i = mnodes[i].right)
+        mnodes[i].sum += n;
+    mnodes[last].len += n;
+    return true;
+}
+
+}
+}
@@ -0,0 +1,118 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_PIECETABLE_H
+#define LGUI_PIECETABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace lgui {
+namespace dtl {
+
+/** Text buffer keeping a document as a sequence of pieces, each referring to a range in either the original
+ *  text or an append-only buffer holding everything inserted later. Pieces are kept in a treap ordered by
+ *  position, so inserting, erasing and locating offsets is O(log n) in the number of pieces, independent of
+ *  the length of the document. Consecutive typing is coalesced into a single piece. */
+class PieceTable {
+    public:
+        static const size_t npos = std::string::npos;
+
+        PieceTable();
+        explicit PieceTable(std::string text);
+
+        /** Replace the whole content. */
+        void assign(std::string text);
+        void clear();
+
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+
+        void insert(size_t pos, const std::string& str);
+        void erase(size_t pos, size_t n);
+
+        char at(size_t pos) const;
+        std::string substr(size_t pos, size_t n = npos) const;
+
+        /** Return the offset of the first occurrence of `c` at or after `pos`, or npos. */
+        size_t find(char c, size_t pos = 0) const;
+        /** Return the offset of the last occurrence of `c` at or before `pos`, or npos. */
+        size_t rfind(char c, size_t pos = npos) const;
+
+        /** Return the whole text as a string. It is materialized lazily and cached until the next
+         *  modification. */
+        const std::string& str() const;
+
+    private:
+        struct Node {
+            size_t start, len, sum;
+            int left, right;
+            uint32_t prio;
+            bool add;
+        };
+
+        int new_node(bool add, size_t start, size_t len);
+        void free_subtree(int t);
+        size_t sum(int t) const { return t >= 0 ? mnodes[t].sum : 0; }
+        void update(int t);
+        int merge(int a, int b);
+        void split(int t, size_t pos, int& l, int& r);
+        bool extend_last(int t, size_t add_start, size_t n);
+        const char* data(const Node& n) const { return (n.add ? madd.data() : morig.data()) + n.start; }
+
+        template <typename Func>
+        bool visit(int t, size_t base, size_t from, size_t to, Func& f) const;
+        template <typename Func>
+        bool visit_backwards(int t, size_t base, size_t from, size_t to, Func& f) const;
+
+        std::string morig, madd;
+        std::vector<Node> mnodes;
+        std::vector<int> mfree_nodes;
+        int mroot;
+        uint32_t mseed;
+
+        mutable std::string mcache;
+        mutable bool mcache_valid;
+};
+
+}
+}
+
+#endif // LGUI_PIECETABLE_H
@@ -0,0 +1,251 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "textrowindex.h"
+
+#include <algorithm>
+
+#include "lgui/platform/error.h"
+
+namespace lgui {
+namespace dtl {
+
+TextRowIndex::TextRowIndex()
+        : mroot(-1), mseed(0x2545f491) {}
+
+void TextRowIndex::clear() {
+    mnodes.clear();
+    mfree_nodes.clear();
+    mroot = -1;
+}
+
+const TextRow& TextRowIndex::operator[](size_t row) const {
+    ASSERT(row < size());
+    int t = mroot;
+    for (;;) {
+        const Node& n = mnodes[t];
+        size_t lcount = count(n.left);
+        if (row < lcount)
+            t = n.left;
+        else if (row == lcount)
+            return n.row;
+        else {
+            row -= lcount + 1;
+            t = n.right;
+        }
+    }
+}
+
+void TextRowIndex::replace(size_t first, size_t last, std::vector<TextRow>& rows) {
+    ASSERT(first <= last && last <= size());
+    int l, m, r;
+    split(mroot, first, l, m);
+    split(m, last - first, m, r);
+    free_subtree(m);
+    mroot = merge(merge(l, build(rows)), r);
+}
+
+size_t TextRowIndex::byte_offset(size_t row) const {
+    size_t offs = 0;
+    int t = mroot;
+    while (t >= 0) {
+        const Node& n = mnodes[t];
+        size_t lcount = count(n.left);
+        if (row <= lcount)
+            t = n.left;
+        else {
+            offs += bytes(n.left) + n.row.size + n.row.split_cwidth;
+            row -= lcount + 1;
+            t = n.right;
+        }
+    }
+    return offs;
+}
+
+size_t TextRowIndex::cp_offset(size_t row) const {
+    size_t offs = 0;
+    int t = mroot;
+    while (t >= 0) {
+        const Node& n = mnodes[t];
+        size_t lcount = count(n.left);
+        if (row <= lcount)
+            t = n.left;
+        else {
+            offs += cps(n.left) + n.row.chrlen + (n.row.split_cwidth > 0 ? 1 : 0);
+            row -= lcount + 1;
+            t = n.right;
+        }
+    }
+    return offs;
+}
+
+size_t TextRowIndex::row_at_byte_offset(size_t offs, size_t& row_start) const {
+    size_t row = 0;
+    row_start = 0;
+    int t = mroot;
+    while (t >= 0) {
+        const Node& n = mnodes[t];
+        size_t lbytes = bytes(n.left);
+        size_t nbytes = n.row.size + n.row.split_cwidth;
+        if (offs < lbytes)
+            t = n.left;
+        else if (offs < lbytes + nbytes) {
+            row_start += lbytes;
+            return row + count(n.left);
+        }
+        else {
+            offs -= lbytes + nbytes;
+            row_start += lbytes + nbytes;
+            row += count(n.left) + 1;
+            t = n.right;
+        }
+    }
+    return size();
+}
+
+int TextRowIndex::new_node(TextRow&& row) {
+    mseed ^= mseed << 13;
+    mseed ^= mseed >> 17;
+    mseed ^= mseed << 5;
+    Node n{std::move(row), 1, 0, 0, 0, -1, -1, mseed};
+    int t;
+    if (!mfree_nodes.empty()) {
+        t = mfree_nodes.back();
+        mfree_nodes.pop_back();
+        mnodes[t] = std::move(n);
+    }
+    else {
+        mnodes.push_back(std::move(n));
+        t = signed(mnodes.size()) - 1;
+    }
+    update(t);
+    return t;
+}
+
+void TextRowIndex::free_subtree(int t) {
+    if (t < 0)
+        return;
+    free_subtree(mnodes[t].left);
+    free_subtree(mnodes[t].right);
+    mfree_nodes.push_back(t);
+}
+
+void TextRowIndex::update(int t) {
+    Node& n = mnodes[t];
+    n.count = 1 + count(n.left) + count(n.right);
+    n.bytes = n.row.size + n.row.split_cwidth + bytes(n.left) + bytes(n.right);
+    n.cps = n.row.chrlen + (n.row.split_cwidth > 0 ? 1 : 0) + cps(n.left) + cps(n.right);
+    n.max_width = n.row.width;
+    if (n.left >= 0)
+        n.max_width = std::max(n.max_width, mnodes[n.left].max_width);
+    if (n.right >= 0)
+        n.max_width = std::max(n.max_width, mnodes[n.right].max_width);
+}
+
+void TextRowIndex::update_subtree(int t) {
+    if (t < 0)
+        return;
+    update_subtree(mnodes[t].left);
+    update_subtree(mnodes[t].right);
+    update(t);
+}
+
+int TextRowIndex::merge(int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (mnodes[a].prio > mnodes[b].prio) {
+        mnodes[a].right = merge(mnodes[a].right, b);
+        update(a);
+        return a;
+    }
+    else {
+        mnodes[b].left = merge(a, mnodes[b].left);
+        update(b);
+        return b;
+    }
+}
+
+void TextRowIndex::split(int t, size_t n, int& l, int& r) {
+    if (t < 0) {
+        l = r = -1;
+        return;
+    }
+    int a, b;
+    size_t lcount = count(mnodes[t].left);
+    if (n <= lcount) {
+        split(mnodes[t].left, n, a, b);
+        mnodes[t].left = b;
+        update(t);
+        l = a;
+        r = t;
+    }
+    else {
+        split(mnodes[t].right, n - lcount - 1, a, b);
+        mnodes[t].right = a;
+        update(t);
+        l = t;
+        r = b;
+    }
+}
+
+int TextRowIndex::build(std::vector<TextRow>& rows) {
+    // Linear-time treap construction from an ordered sequence: keep the right spine on a stack.
+    std::vector<int> spine;
+    for (TextRow& row : rows) {
+        int t = new_node(std::move(row));
+        int last = -1;
+        while (!spine.empty() && mnodes[spine.back()].prio < mnodes[t].prio) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        mnodes[t].left = last;
+        if (!spine.empty())
+            mnodes[spine.back()].right = t;
+        spine.push_back(t);
+    }
+    if (spine.empty())
+        return -1;
+    update_subtree(spine.front());
+    return spine.front();
+}
+
+}
+}
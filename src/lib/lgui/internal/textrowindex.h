@@ -0,0 +1,123 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_TEXTROWINDEX_H
+#define LGUI_TEXTROWINDEX_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace lgui {
+namespace dtl {
+
+/** One row of (wrapped) text as displayed by TextBox. Rows don't hold their text: the index maps them to
+ *  their offset in the text, from where it is read. */
+struct TextRow {
+    size_t size;          // length in bytes
+    int chrlen;           // length in code points
+    int width;            // width in pixels
+    uint8_t split_cwidth; // width in bytes of the character the row was split at (not part of the row)
+};
+
+/** Sequence of TextRows with an index over them: rows are kept in a treap ordered by row number whose nodes
+ *  carry prefix sums of byte and code point lengths as well as the maximum row width. Accessing a row,
+ *  mapping between rows and text offsets and replacing a range of rows are O(log n) in the number of
+ *  rows (plus the number of rows replaced). */
+class TextRowIndex {
+    public:
+        TextRowIndex();
+
+        size_t size() const { return count(mroot); }
+        bool empty() const { return mroot < 0; }
+        void clear();
+
+        const TextRow& operator[](size_t row) const;
+        const TextRow& back() const { return (*this)[size() - 1]; }
+
+        /** Replace the rows [first, last) with `rows`. The contents of `rows` will be moved from. */
+        void replace(size_t first, size_t last, std::vector<TextRow>& rows);
+        void assign(std::vector<TextRow>& rows) {
+            clear();
+            replace(0, 0, rows);
+        }
+
+        /** Return the byte offset of the start of `row` in the text (including split characters). */
+        size_t byte_offset(size_t row) const;
+        /** Return the code point offset of the start of `row` in the text (including split characters). */
+        size_t cp_offset(size_t row) const;
+        /** Return the row containing byte offset `offs` and store the offset of that row's start in
+         *  `row_start`. Returns size() if `offs` is beyond the last row. */
+        size_t row_at_byte_offset(size_t offs, size_t& row_start) const;
+
+        /** Return the total number of bytes covered, including split characters. */
+        size_t total_bytes() const { return bytes(mroot); }
+        /** Return the width of the widest row. */
+        int max_width() const { return mroot >= 0 ? mnodes[mroot].max_width : 0; }
+
+    private:
+        struct Node {
+            TextRow row;
+            size_t count, bytes, cps;
+            int max_width;
+            int left, right;
+            uint32_t prio;
+        };
+
+        int new_node(TextRow&& row);
+        void free_subtree(int t);
+        size_t count(int t) const { return t >= 0 ? mnodes[t].count : 0; }
+        size_t bytes(int t) const { return t >= 0 ? mnodes[t].bytes : 0; }
+        size_t cps(int t) const { return t >= 0 ? mnodes[t].cps : 0; }
+        void update(int t);
+        void update_subtree(int t);
+        int merge(int a, int b);
+        void split(int t, size_t n, int& l, int& r);
+        int build(std::vector<TextRow>& rows);
+
+        std::vector<Node> mnodes;
+        std::vector<int> mfree_nodes;
+        int mroot;
+        uint32_t mseed;
+};
+
+}
+}
+
+#endif // LGUI_TEXTROWINDEX_H
@@ -42,6 +42,7 @@
 #include "lgui/widget.h"
 #include "timerhandler.h"
 #include "lgui/timertickevent.h"
+#include "lgui/profiler.h"
 
 namespace lgui {
 
@@ -80,14 +81,17 @@ void TimerHandler::unsubscribe_from_timer_ticks(Widget& w) {
 
 void TimerHandler::handle_timer_tick(const ExternalEvent& event)
 {
+    LGUI_PROFILE_SCOPE("TimerHandler::handle_timer_tick");
     mdistributing_timer_ticks = true;
     TimerTickEvent tte(event.timestamp, event.timer.count);
 
     manimation_handler.update(tte);
 
     for (Widget* w : mwidgets_subscribed_to_timer_ticks) {
-        if (w && event.timer.count % w->timer_tick_skip_mod() == 0)
+        if (w && event.timer.count % w->timer_tick_skip_mod() == 0) {
             w->timer_ticked(tte);
+            w->invalidate();
+        }
     }
     mdistributing_timer_ticks = false;
     if (!mwidgets_timer_ticks_subscriptions_queue.empty()) {
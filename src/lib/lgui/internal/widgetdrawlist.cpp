@@ -0,0 +1,67 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "widgetdrawlist.h"
+#include "lgui/widget.h"
+#include "lgui/drawevent.h"
+#include "lgui/platform/graphics.h"
+#include "lgui/profiler.h"
+
+namespace lgui {
+
+namespace dtl {
+
+void WidgetDrawList::draw(const Widget& w, const DrawEvent& de) {
+    Graphics& gfx = de.gfx();
+    if (!mvalid || mdraw_disabled != de.draw_disabled() || msize != w.size()) {
+        LGUI_PROFILE_COUNT(DrawListsRecorded, 1);
+        // Record with full opacity: opacity is applied to the colors when replaying.
+        gfx.begin_recording(mlist);
+        w.draw(DrawEvent(gfx, de.draw_disabled(), 1.0));
+        gfx.end_recording();
+        mvalid = true;
+        mdraw_disabled = de.draw_disabled();
+        msize = w.size();
+    }
+    mlist.replay(gfx, de.opacity());
+}
+
+}
+
+}
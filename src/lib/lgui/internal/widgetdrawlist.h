@@ -0,0 +1,80 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_WIDGETDRAWLIST_H
+#define LGUI_WIDGETDRAWLIST_H
+
+#include "lgui/lgui_types.h"
+#include "lgui/platform/drawlist.h"
+
+namespace lgui {
+
+class Widget;
+class DrawEvent;
+
+namespace dtl {
+
+/** Caches the drawing commands of a widget (including its children) in a DrawList. The list is replayed
+ *  instead of drawing the widget until invalidate() is called. Used by Widget::set_cache_as_draw_list(). */
+class WidgetDrawList {
+    public:
+        WidgetDrawList()
+                : mvalid(false), mdraw_disabled(false) {}
+
+        /** Mark the recorded commands as stale: the widget will be recorded again the next time it is drawn. */
+        void invalidate() { mvalid = false; }
+        bool is_valid() const { return mvalid; }
+
+        /** Return the list of the last recording. */
+        const DrawList& draw_list() const { return mlist; }
+
+        /** Draw the widget `w` by replaying the list, recording it first if necessary. The draw area of the
+         *  widget is expected to have been pushed already. */
+        void draw(const Widget& w, const DrawEvent& de);
+
+    private:
+        DrawList mlist;
+        Size msize;
+        bool mvalid, mdraw_disabled;
+};
+
+}
+}
+
+#endif //LGUI_WIDGETDRAWLIST_H
@@ -0,0 +1,77 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "widgetlayer.h"
+#include "lgui/widget.h"
+#include "lgui/drawevent.h"
+#include "lgui/platform/graphics.h"
+
+namespace lgui {
+
+namespace dtl {
+
+void WidgetLayer::draw(const Widget& w, const DrawEvent& de) {
+    if (w.width() <= 0 || w.height() <= 0)
+        return;
+    Graphics& gfx = de.gfx();
+    if (gfx.is_record_only()) {
+        // There's no backend to render the layer with.
+        w.draw(de);
+        return;
+    }
+    if (!mbmp || mbmp->w() != w.width() || mbmp->h() != w.height()) {
+        mbmp = std::make_unique<Bitmap>(w.width(), w.height());
+        mvalid = false;
+    }
+    if (!mvalid || mdraw_disabled != de.draw_disabled()) {
+        // Render with full opacity: opacity is applied when drawing the layer, so the subtree is
+        // composed as a whole.
+        gfx.begin_layer(*mbmp);
+        gfx.clear(rgba(0, 0, 0, 0));
+        w.draw(DrawEvent(gfx, de.draw_disabled(), 1.0));
+        gfx.end_layer();
+        mvalid = true;
+        mdraw_disabled = de.draw_disabled();
+    }
+    gfx.draw_tinted_bmp(*mbmp, 0, 0, grey_premult(1.0, de.opacity()));
+}
+
+}
+
+}
@@ -0,0 +1,76 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_WIDGETLAYER_H
+#define LGUI_WIDGETLAYER_H
+
+#include <memory>
+#include "lgui/platform/bitmap.h"
+
+namespace lgui {
+
+class Widget;
+class DrawEvent;
+
+namespace dtl {
+
+/** Caches the rendered contents of a widget (including its children) in a bitmap. The bitmap is drawn instead
+ *  of the widget until invalidate() is called. Used by Widget::set_cache_as_layer(). */
+class WidgetLayer {
+    public:
+        WidgetLayer()
+                : mvalid(false), mdraw_disabled(false) {}
+
+        /** Mark the cached contents as stale: the widget will be re-rendered the next time it is drawn. */
+        void invalidate() { mvalid = false; }
+        bool is_valid() const { return mvalid; }
+
+        /** Draw the widget `w` via the cache, re-rendering it into the cache first if necessary. The draw
+         *  area of the widget is expected to have been pushed already. */
+        void draw(const Widget& w, const DrawEvent& de);
+
+    private:
+        std::unique_ptr<Bitmap> mbmp;
+        bool mvalid, mdraw_disabled;
+};
+
+}
+}
+
+#endif //LGUI_WIDGETLAYER_H
@@ -42,6 +42,7 @@
 
 #include <list>
 #include <array>
+#include <cstdio>
 
 #include "lgui/lgui_types.h"
 #include "lgui/platform/error.h"
@@ -40,6 +40,8 @@
 #ifndef LGUI_IWIDGETLISTENER_H
 #define LGUI_IWIDGETLISTENER_H
 
+#include <vector>
+
 namespace lgui {
 class Widget;
 
@@ -60,6 +62,12 @@ class IWidgetListener {
             (void) w;
             (void) child;
         }
+        /** Called once for children added together (see BasicContainer::add_children()). The default
+         *  implementation calls child_added_wl() for each of them. */
+        virtual void children_added_wl(Widget& w, const std::vector<Widget*>& children) {
+            for (Widget* child : children)
+                child_added_wl(w, *child);
+        }
         virtual void child_removed_wl(Widget& w, Widget& child) {
             (void) w;
             (void) child;
@@ -72,6 +72,16 @@ void Layout::_child_added_to_target(Widget& widget) {
         mtarget->request_layout();
 }
 
+void Layout::_children_added_to_target(const std::vector<Widget*>& widgets) {
+    bool u = update_on_child_add_remove();
+    set_update_on_child_add_remove(false);
+    for (Widget* w : widgets)
+        _child_added_to_target(*w);
+    set_update_on_child_add_remove(u);
+    if (mupdate_on_child_add_remove && mtarget && !widgets.empty())
+        mtarget->request_layout();
+}
+
 void Layout::_child_removed_from_target(Widget& widget) {
     widget.remove_widget_listener(this);
     if (mupdate_on_child_add_remove && mtarget)
@@ -114,6 +114,10 @@ class Layout : public IWidgetListener, public ILayoutElement {
          *  of the widget. */
         virtual void _child_added_to_target(Widget& widget);
 
+        /** Called once for several children added to target at once. Default implementation will call
+         *  _child_added_to_target for each of them and request a layout only once. */
+        virtual void _children_added_to_target(const std::vector<Widget*>& widgets);
+
         /** Called whenever a child is removed from target.
          *  Default implementation will just deregister the layout as a
             widget listener from the widget.*/
@@ -1,8 +1,13 @@
 #include "layoutitem.h"
+#include "lgui/widget.h"
 
 lgui::MeasureResults lgui::LayoutItem::measure(lgui::SizeConstraint wc, lgui::SizeConstraint hc) {
     if (mle) {
-        mlast_measure_size = mle->measure(get_horz_constraint(wc), get_vert_constraint(hc));
+        if (mle->layout_element_type() == ILayoutElement::LayoutElementWidget)
+            mlast_measure_size = static_cast<Widget*>(mle)->measure_cached(get_horz_constraint(wc),
+                                                                           get_vert_constraint(hc));
+        else
+            mlast_measure_size = mle->measure(get_horz_constraint(wc), get_vert_constraint(hc));
     }
     else {
         mlast_measure_size = Size();
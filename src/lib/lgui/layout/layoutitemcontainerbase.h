@@ -103,6 +103,10 @@ class LayoutItemContainerBase : public Layout {
                 _remove_widget_fnlh(widget);
         }
 
+        void _children_added_to_target(const std::vector<Widget*>& widgets) override {
+            (void) widgets;
+        }
+
         void _new_target() override {
             // Add each widget that we control to the target.
             ASSERT(mtarget); // Should've been set.
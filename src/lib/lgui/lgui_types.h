@@ -368,6 +368,14 @@ class Rect {
             return mpos + Point(msize.w() / 2, msize.h() / 2);
         }
 
+        /** Return the smallest rectangle containing both this rectangle and `other`. */
+        Rect united(const Rect& other) const {
+            Scalar nx1 = std::min(x(), other.x()), ny1 = std::min(y(), other.y());
+            Scalar nx2 = std::max(x() + w(), other.x() + other.w());
+            Scalar ny2 = std::max(y() + h(), other.y() + other.h());
+            return Rect(nx1, ny1, nx2 - nx1, ny2 - ny1);
+        }
+
         bool operator==(const Rect& other) const {
             return mpos == other.mpos && msize == other.msize;
         }
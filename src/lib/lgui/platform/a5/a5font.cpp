@@ -37,6 +37,7 @@
 * THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <atomic>
 #include <cstring>
 
 #include "../font.h"
@@ -49,7 +50,10 @@
 
 namespace lgui {
 
-A5Font::A5Font(const std::string& filename, int size) {
+static std::atomic<uint64_t> next_font_id(1);
+
+A5Font::A5Font(const std::string& filename, int size)
+        : mid(next_font_id++) {
     mfnt = al_load_ttf_font(filename.c_str(), size, 0);
     if (!mfnt) {
         error("Couldn't load font", "Couldn't load font \"%s\".", filename.c_str());
@@ -80,10 +84,12 @@ int A5Font::char_width_hint() const {
 }
 
 int A5Font::text_width(const std::string& str) const {
+    std::lock_guard<std::mutex> lock(mmutex);
     return al_get_text_width(mfnt, str.c_str());
 }
 
 int A5Font::text_width(const char* str) const {
+    std::lock_guard<std::mutex> lock(mmutex);
     return al_get_text_width(mfnt, str);
 }
 
@@ -94,11 +100,18 @@ int A5Font::text_width(const std::string& str, size_t offs, size_t n) const {
         n = str.size() - offs;
     ALLEGRO_USTR_INFO info;
     const ALLEGRO_USTR* ref = al_ref_buffer(&info, str.data() + offs, n);
+    std::lock_guard<std::mutex> lock(mmutex);
     return al_get_ustr_width(mfnt, ref);
 }
 
+int A5Font::glyph_advance(int32_t cp, int32_t next_cp) const {
+    std::lock_guard<std::mutex> lock(mmutex);
+    return al_get_glyph_advance(mfnt, cp, next_cp < 0 ? ALLEGRO_NO_KERNING : next_cp);
+}
+
 lgui::Rect A5Font::text_dims(const std::string& str) const {
     int bbx, bby, bbw, bbh;
+    std::lock_guard<std::mutex> lock(mmutex);
     al_get_text_dimensions(mfnt, str.c_str(), &bbx, &bby, &bbw, &bbh);
     return lgui::Rect(bbx, bby, bbw, bbh);
 }
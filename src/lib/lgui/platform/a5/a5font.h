@@ -42,6 +42,8 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <mutex>
 
 #include "lgui/lgui_types.h"
 
@@ -49,9 +51,13 @@ struct ALLEGRO_FONT;
 
 namespace lgui {
 
-/** Class representing an Allegro 5 font. Do not use this class directly, but rather use Font. */
+/** Class representing an Allegro 5 font. Do not use this class directly, but rather use Font.
+ *  A font may be used by several threads (see RenderThread): every call into Allegro that looks up glyphs
+ *  holds a mutex of the font. Measuring never renders glyphs; that is only done by drawing, i.e. on the
+ *  thread the display is current on. */
 class A5Font {
         friend class A5Graphics;
+        friend class A5TextRun;
 
     public:
         /** Loads an Allegro 5 font with the specified size. */
@@ -60,7 +66,7 @@ class A5Font {
 
         /** Move constructor. */
         A5Font(A5Font&& other)
-                : mfnt(other.mfnt) {
+                : mfnt(other.mfnt), mid(other.mid), mmutex() {
             other.mfnt = nullptr;
         }
 
@@ -86,8 +92,18 @@ class A5Font {
         int text_width(const std::string& str, size_t offs, size_t n) const;
         lgui::Rect text_dims(const std::string& str) const;
 
+        /** Return how far to advance after drawing code point `cp`, taking kerning with the code point
+         *  `next_cp` following it into account. Pass -1 as `next_cp` if nothing follows. */
+        int glyph_advance(int32_t cp, int32_t next_cp) const;
+
+        /** Return an ID identifying the loaded font. Unlike the font's address, it is never reused by another
+         *  font, so glyphs may be cached under it (see A5TextRun). */
+        uint64_t id() const { return mid; }
+
     private:
         ALLEGRO_FONT* mfnt;
+        uint64_t mid;
+        mutable std::mutex mmutex; // held while Allegro looks up glyphs, which fills the font's caches
 };
 
 }
@@ -38,6 +38,7 @@
 */
 
 #include <cmath>
+#include <mutex>
 
 #include <allegro5/allegro_color.h>
 #include <allegro5/allegro_primitives.h>
@@ -50,16 +51,29 @@
 #include "../error.h"
 #include "../graphics.h"
 #include "../utf8.h"
+#include "lgui/profiler.h"
 #include "a5graphics.h"
 
 
 namespace lgui {
 
 A5Graphics::A5Graphics()
-        : moffsx(0), moffsy(0) {
+        : moffsx(0), moffsy(0), mprims(nullptr), mbatching(false), mtransform_dirty(false),
+          mholding_bitmaps(false), mpending_is_offset(false), mapplied_is_offset(false) {
     ASSERT(al_get_current_display() != nullptr);
     mw = display_width();
     mh = display_height();
+    mpending_transform.set_identity();
+    mapplied_transform.set_identity();
+}
+
+A5Graphics::A5Graphics(int w, int h)
+        : moffsx(0), moffsy(0), mprims(nullptr), mbatching(false), mtransform_dirty(false),
+          mholding_bitmaps(false), mpending_is_offset(false), mapplied_is_offset(false) {
+    mw = w;
+    mh = h;
+    mpending_transform.set_identity();
+    mapplied_transform.set_identity();
 }
 
 void A5Graphics::get_clip_rect(int& x, int& y, int& w, int& h) {
@@ -67,21 +81,142 @@ void A5Graphics::get_clip_rect(int& x, int& y, int& w, int& h) {
 }
 
 void A5Graphics::set_clip_rect(int x, int y, int w, int h) {
+    if (mbatching) {
+        int cx, cy, cw, ch;
+        al_get_clipping_rectangle(&cx, &cy, &cw, &ch);
+        if (cx == x && cy == y && cw == w && ch == h)
+            return;
+        flush();
+    }
     al_set_clipping_rectangle(x, y, w, h);
 }
 
 void A5Graphics::reset_clip_rect() {
+    flush();
     al_reset_clipping_rectangle();
 }
 
 void A5Graphics::clear(lgui::Color col) {
+    flush();
     al_clear_to_color(col);
 }
 
 void A5Graphics::flip() {
+    flush();
     al_flip_display();
 }
 
+void A5Graphics::set_batching(bool batching) {
+    flush();
+    mbatching = batching;
+    if (mprims)
+        mprims->set_batching(batching);
+}
+
+void A5Graphics::flush() {
+    release_bitmaps();
+    if (mprims)
+        mprims->flush();
+    apply_pending_transform();
+}
+
+void A5Graphics::set_transform_deferred(const Transform& transform) {
+    if (!mbatching) {
+        use_transform(transform);
+        return;
+    }
+    mpending_transform = transform;
+    mpending_is_offset = false;
+    mtransform_dirty = true;
+}
+
+void A5Graphics::set_translation_deferred(int x, int y) {
+    Point offs(x, y);
+    bool unchanged = mtransform_dirty ? mpending_is_offset && mpending_offs == offs :
+                     mapplied_is_offset && mapplied_offs == offs;
+    if (unchanged)
+        return;
+    mpending_offs = offs;
+    mpending_is_offset = true;
+    mtransform_dirty = true;
+    if (!mbatching)
+        apply_pending_transform();
+}
+
+void A5Graphics::apply_pending_transform() const {
+    if (mtransform_dirty) {
+        if (mpending_is_offset) {
+            mpending_transform.set_identity();
+            mpending_transform.translate_post(PointF(mpending_offs));
+        }
+        al_use_transform(&mpending_transform.a5_transform());
+        mapplied_transform = mpending_transform;
+        mapplied_is_offset = mpending_is_offset;
+        mapplied_offs = mpending_offs;
+        mtransform_dirty = false;
+    }
+    if (mprims)
+        mprims->set_batch_offset(0, 0);
+}
+
+bool A5Graphics::pending_translation_delta(PointF& d) const {
+    PointF pending, applied;
+    if (mpending_is_offset)
+        pending = PointF(mpending_offs);
+    else if (mpending_transform.is_translation())
+        pending = mpending_transform.translation();
+    else
+        return false;
+    if (mapplied_is_offset)
+        applied = PointF(mapplied_offs);
+    else if (mapplied_transform.is_translation())
+        applied = mapplied_transform.translation();
+    else
+        return false;
+    d = pending - applied;
+    return true;
+}
+
+void A5Graphics::release_bitmaps() const {
+    if (mholding_bitmaps) {
+        al_hold_bitmap_drawing(false);
+        mholding_bitmaps = false;
+    }
+}
+
+void A5Graphics::prepare_prims() const {
+    LGUI_PROFILE_COUNT(DrawCalls, 1);
+    if (!mbatching)
+        return;
+    release_bitmaps();
+    if (!mtransform_dirty)
+        return;
+    PointF d;
+    if (pending_translation_delta(d)) {
+        // Translate on the CPU so that the batch can continue.
+        mprims->set_batch_offset(d.x(), d.y());
+    }
+    else {
+        mprims->flush();
+        apply_pending_transform();
+    }
+}
+
+void A5Graphics::prepare_bitmaps() const {
+    LGUI_PROFILE_COUNT(DrawCalls, 1);
+    if (!mbatching)
+        return;
+    if (mprims)
+        mprims->flush();
+    if (mholding_bitmaps && !mtransform_dirty)
+        return;
+    // Held bitmaps are drawn with the transformation active at the time of release.
+    release_bitmaps();
+    apply_pending_transform();
+    al_hold_bitmap_drawing(true);
+    mholding_bitmaps = true;
+}
+
 int A5Graphics::display_width() const {
     ASSERT(al_get_current_display());
     return al_get_display_width(al_get_current_display());
@@ -93,17 +228,23 @@ int A5Graphics::display_height() const {
 }
 
 void A5Graphics::draw_text(const A5Font& font, float x, float y, lgui::Color color, const std::string& text) {
+    prepare_bitmaps();
+    std::lock_guard<std::mutex> lock(font.mmutex);
     al_draw_text(font.mfnt, color, x, y, 0, text.c_str());
 }
 
 void A5Graphics::draw_textr(const A5Font& font, float x, float y, lgui::Color color, const std::string& text) {
-    al_draw_text(font.mfnt, color, x - font.text_width(text), y, 0,
-                 text.c_str());
+    prepare_bitmaps();
+    int width = font.text_width(text);
+    std::lock_guard<std::mutex> lock(font.mmutex);
+    al_draw_text(font.mfnt, color, x - width, y, 0, text.c_str());
 }
 
 void A5Graphics::draw_textc(const A5Font& font, float x, float y, lgui::Color color, const std::string& text) {
-    al_draw_text(font.mfnt, color, x - font.text_width(text) / 2, y, 0,
-                 text.c_str());
+    prepare_bitmaps();
+    int width = font.text_width(text);
+    std::lock_guard<std::mutex> lock(font.mmutex);
+    al_draw_text(font.mfnt, color, x - width / 2, y, 0, text.c_str());
 }
 
 void A5Graphics::start_deferred_drawing() {
@@ -115,6 +256,7 @@ void A5Graphics::end_deferred_drawing() {
 }
 
 void A5Graphics::set_blender(Blender blender) {
+    flush();
     if (blender == BLENDER_ADD)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ONE);
     else if (blender == BLENDER_MULTIPLY)
@@ -131,6 +273,7 @@ void A5Graphics::_error_shutdown() {
 
 void A5Graphics::start_drawing_to_bmp(lgui::Bitmap& bmp) {
     ASSERT(bmp.mbmp);
+    flush();
     al_set_target_bitmap(bmp.mbmp);
 }
 
@@ -148,23 +291,41 @@ void A5Graphics::end_drawing_to_bmp_perm(lgui::Bitmap& bmp) {
 }
 
 void A5Graphics::restore_drawing_to_backbuffer() {
+    flush();
     al_set_target_backbuffer(al_get_current_display());
 }
 
+void A5Graphics::push_target(lgui::Bitmap& bmp) {
+    ASSERT(bmp.mbmp);
+    flush();
+    mtarget_stack.push_back(al_get_target_bitmap());
+    al_set_target_bitmap(bmp.mbmp);
+}
+
+void A5Graphics::pop_target() {
+    ASSERT(!mtarget_stack.empty());
+    flush();
+    al_set_target_bitmap(mtarget_stack.back());
+    mtarget_stack.pop_back();
+}
+
 void A5Graphics::draw_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int flip) {
     ASSERT(bitmap.mbmp);
+    prepare_bitmaps();
     al_draw_bitmap(bitmap.mbmp, dx, dy, flip);
 }
 
 void A5Graphics::draw_tinted_bmp(const lgui::Bitmap& bitmap, int dx, int dy, lgui::Color col,
                                  int flip) {
     ASSERT(bitmap.mbmp);
+    prepare_bitmaps();
     al_draw_tinted_bitmap(bitmap.mbmp, col, dx, dy, flip);
 }
 
 void A5Graphics::draw_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int sx, int sy,
                                  int sw, int sh, int flip) {
     ASSERT(bitmap.mbmp);
+    prepare_bitmaps();
     al_draw_bitmap_region(bitmap.mbmp, float(sx), float(sy), float(sw), float(sh),
                           float(dx), float(dy), flip);
 }
@@ -172,6 +333,7 @@ void A5Graphics::draw_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int
 void A5Graphics::draw_tinted_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int sx, int sy,
                                         int sw, int sh, lgui::Color col, int flip) {
     ASSERT(bitmap.mbmp);
+    prepare_bitmaps();
     al_draw_tinted_bitmap_region(bitmap.mbmp, col, float(sx), float(sy), float(sw), float(sh),
                                  float(dx), float(dy), flip);
 }
@@ -179,6 +341,7 @@ void A5Graphics::draw_tinted_bmp_region(const lgui::Bitmap& bitmap, int dx, int
 void A5Graphics::draw_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int dw, int dh,
                                  int flip) const {
     ASSERT(bitmap.mbmp);
+    prepare_bitmaps();
     al_draw_scaled_bitmap(bitmap.mbmp, 0, 0, bitmap.w(), bitmap.h(),
                           dx, dy, dw, dh, flip);
 }
@@ -187,6 +350,7 @@ void A5Graphics::draw_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int
 void A5Graphics::draw_tinted_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int dw, int dh, lgui::Color col,
                                         int flip) const {
     ASSERT(bitmap.mbmp);
+    prepare_bitmaps();
     al_draw_tinted_scaled_bitmap(bitmap.mbmp, col, 0, 0, bitmap.w(), bitmap.h(),
                                  dx, dy, dw, dh, flip);
 }
@@ -208,6 +372,8 @@ void A5Graphics::draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, fl
         num_segments = (PRIM_CACHE_SIZE - 1) / 4;
     }
 
+    flush();
+
     al_calculate_arc(&(vertex_cache[0].x), sizeof(ALLEGRO_VERTEX), 0, 0, crx, cry, 0, ALLEGRO_PI / 2, 0,
                      num_segments + 1);
 
@@ -247,7 +413,11 @@ void A5Graphics::draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, fl
 }
 
 void A5Graphics::use_transform(const Transform& transform) {
+    flush();
     al_use_transform(&transform.a5_transform());
+    mapplied_transform = transform;
+    mpending_transform = transform;
+    mapplied_is_offset = mpending_is_offset = false;
 }
 
 static int render_glyph(const ALLEGRO_FONT* f, const ALLEGRO_COLOR& color,
@@ -280,6 +450,8 @@ void A5Graphics::draw_text_clipped_to_rect(const A5Font& font, float x, float y,
                                            const Rect& clip_rect, const std::string& text) {
     if (y >= clip_rect.y2())
         return;
+    prepare_bitmaps();
+    std::lock_guard<std::mutex> lock(font.mmutex);
     size_t pos = 0;
     int last_cp = -1;
     float xd = x;
@@ -290,4 +462,45 @@ void A5Graphics::draw_text_clipped_to_rect(const A5Font& font, float x, float y,
     }
 }
 
+void A5Graphics::draw_text_run(const A5Font& font, float x, float y, lgui::Color color, const A5TextRun& run) {
+    run.shape(font);
+    prepare_bitmaps();
+    std::lock_guard<std::mutex> lock(font.mmutex);
+    run.render_glyphs(font);
+    bool hold = !al_is_bitmap_drawing_held();
+    if (hold)
+        al_hold_bitmap_drawing(true);
+    for (const auto& g : run.mglyphs)
+        al_draw_tinted_bitmap_region(g.bitmap, color, g.sx, g.sy, g.sw, g.sh, x + g.dx, y + g.dy, 0);
+    if (hold)
+        al_hold_bitmap_drawing(false);
+}
+
+void A5Graphics::draw_text_run_clipped_to_rect(const A5Font& font, float x, float y, lgui::Color color,
+                                               const Rect& clip_rect, const A5TextRun& run) {
+    if (y >= clip_rect.y2())
+        return;
+    run.shape(font);
+    prepare_bitmaps();
+    std::lock_guard<std::mutex> lock(font.mmutex);
+    run.render_glyphs(font);
+    bool hold = !al_is_bitmap_drawing_held();
+    if (hold)
+        al_hold_bitmap_drawing(true);
+    for (const auto& g : run.mglyphs) {
+        float dx = x + g.dx, dy = y + g.dy;
+        if (dx >= clip_rect.x2())
+            break;
+        if (dx + g.sw <= clip_rect.x1())
+            continue;
+        Rect clipped(dx, dy, g.sw, g.sh);
+        clipped.clip_to(clip_rect);
+        al_draw_tinted_bitmap_region(g.bitmap, color,
+                                     g.sx + clipped.x1() - dx, g.sy + clipped.y1() - dy, clipped.w(), clipped.h(),
+                                     clipped.x1(), clipped.y1(), 0);
+    }
+    if (hold)
+        al_hold_bitmap_drawing(false);
+}
+
 }
@@ -40,13 +40,17 @@
 #ifndef LGUI_A5_GRAPHICS_H
 #define LGUI_A5_GRAPHICS_H
 
+#include <vector>
+
 #include "../font.h"
+#include "../textrun.h"
 #include "../color.h"
 #include "../transform.h"
 
 namespace lgui {
 
 class Bitmap;
+class A5PrimHelper;
 
 /** Class representing an Allegro 5 graphics context, providing drawing operations. Do not use this class
  *  directly, but rather use graphics. */
@@ -74,6 +78,12 @@ class A5Graphics {
 
         void restore_drawing_to_backbuffer();
 
+        /** Make `bmp` the drawing target, remembering the current one. Transformation and clipping rectangle
+         *  are properties of the target, so they will be those of `bmp` until pop_target() is called. */
+        void push_target(lgui::Bitmap& bmp);
+        /** Make the target that was current before the last call to push_target() the target again. */
+        void pop_target();
+
         void start_deferred_drawing();
         void end_deferred_drawing();
 
@@ -81,6 +91,18 @@ class A5Graphics {
 
         void use_transform(const Transform& transform);
 
+        /** Enable or disable batching (off by default). While batching, primitives are collected and drawn
+         *  with as few draw calls as possible: translations of draw areas are applied to the vertices
+         *  instead of changing the transformation, and consecutive text and bitmap draws are held, too.
+         *  A batch is flushed automatically when switching between primitives and bitmaps, or when
+         *  changing clipping, blending, non-translation transformations, or the target. When drawing with
+         *  Allegro directly in between, call flush() before. Disabling batching flushes. */
+        void set_batching(bool batching);
+        bool is_batching() const { return mbatching; }
+
+        /** Draw everything that has been batched so far and apply the current transformation. */
+        void flush();
+
         void clear(lgui::Color col);
 
         void flip();
@@ -110,10 +132,49 @@ class A5Graphics {
         void draw_text_clipped_to_rect(const A5Font& font, float x, float y, lgui::Color color,
                                        const Rect& clip_rect, const std::string& text);
 
+        /** Draw a text run, shaping it for `font` first if necessary. The glyphs are submitted as one batch of
+         *  textured quads. */
+        void draw_text_run(const A5Font& font, float x, float y, lgui::Color color, const A5TextRun& run);
+        /** Draw a text run clipped to a rectangle, see draw_text_clipped_to_rect(). */
+        void draw_text_run_clipped_to_rect(const A5Font& font, float x, float y, lgui::Color color,
+                                           const Rect& clip_rect, const A5TextRun& run);
+
         static void _error_shutdown();
 
     protected:
+        /** Construct without accessing the display, assuming a target of w x h pixels. Used for Graphics
+         *  objects that only record. */
+        A5Graphics(int w, int h);
+
+        void set_prim_helper(A5PrimHelper* prims) { mprims = prims; }
+
+        /** Make `transform` the current transformation. When batching, it may be applied lazily by
+         *  prepare_prims() or prepare_bitmaps(). */
+        void set_transform_deferred(const Transform& transform);
+        /** Make a translation by (x, y) the current transformation. Like set_transform_deferred(), but the
+         *  matrix is only built when it actually needs to be applied. */
+        void set_translation_deferred(int x, int y);
+        /** To be called before drawing primitives via the prim helper. */
+        void prepare_prims() const;
+        /** To be called before drawing bitmaps or text. */
+        void prepare_bitmaps() const;
+
         int moffsx, moffsy, mw, mh;
+
+    private:
+        void apply_pending_transform() const;
+        bool pending_translation_delta(PointF& d) const;
+        void release_bitmaps() const;
+
+        std::vector<ALLEGRO_BITMAP*> mtarget_stack;
+        A5PrimHelper* mprims;
+        bool mbatching;
+        mutable bool mtransform_dirty, mholding_bitmaps;
+        mutable Transform mpending_transform, mapplied_transform;
+        // Set if the respective transformation is a translation by the offset (the pending matrix is not
+        // built in that case).
+        mutable bool mpending_is_offset, mapplied_is_offset;
+        mutable Point mpending_offs, mapplied_offs;
 };
 
 }
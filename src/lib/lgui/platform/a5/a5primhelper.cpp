@@ -56,6 +56,15 @@ static const ALLEGRO_VERTEX_ELEMENT _prim_vertex_elems[] = {
 };
 
 
+static inline lgui::Color mix_colors(const lgui::Color& col1, const lgui::Color& col2, float t) {
+    if (t == 0)
+        return col1;
+    else if (t == 1)
+        return col2;
+    return lgui::rgba(col1.r + (col2.r - col1.r) * t, col1.g + (col2.g - col1.g) * t,
+                      col1.b + (col2.b - col1.b) * t, col1.a + (col2.a - col1.a) * t);
+}
+
 static inline void assign_gradient_colors(const lgui::Color* col1, const lgui::Color* col2, lgui::GradientDirection dir,
                                           const lgui::Color** tl_col, const lgui::Color** tr_col, const lgui::Color** bl_col, const lgui::Color** br_col) {
     if(dir == lgui::GradientDirection::RightToLeft || dir == lgui::GradientDirection::BottomToTop) {
@@ -79,9 +88,10 @@ static inline void assign_gradient_colors(const lgui::Color* col1, const lgui::C
 namespace lgui {
 
 A5PrimHelper::A5PrimHelper()
-    : mprim_vertex_decl(nullptr)
+    : mprim_vertex_decl(nullptr), mbatching(false), mbatch_dx(0), mbatch_dy(0),
+      mbatch_type(lgui::PrimType::PRIM_TRIANGLE_LIST), mdraw_calls(0), mtess_max_entries(256),
+      mtess_hits(0), mtess_misses(0)
 {
-    init();
 }
 
 A5PrimHelper::~A5PrimHelper()
@@ -92,53 +102,159 @@ A5PrimHelper::~A5PrimHelper()
     }
 }
 
-void A5PrimHelper::init()
+void A5PrimHelper::init() const
 {
     if (!mprim_vertex_decl)
         mprim_vertex_decl = al_create_vertex_decl(_prim_vertex_elems, sizeof(PrimVertex));
 }
 
+void A5PrimHelper::set_batching(bool batching)
+{
+    if (!batching)
+        flush();
+    mbatching = batching;
+}
+
+// When batching, the simple primitives are tessellated here instead of by Allegro, mirroring what
+// al_draw_* would do.
+
 void A5PrimHelper::rect(float x1, float y1, float x2, float y2, lgui::Color col, float thickness)
 {
-    al_draw_rectangle(x1, y1, x2, y2,
-                      col, thickness);
+    if (!mbatching) {
+        al_draw_rectangle(x1, y1, x2, y2,
+                          col, thickness);
+        mdraw_calls++;
+        return;
+    }
+    if (thickness > 0) {
+        float t = thickness / 2;
+        PrimVertex vtx[10] = {
+            {x1 - t, y1 - t, col}, {x1 + t, y1 + t, col}, {x2 + t, y1 - t, col}, {x2 - t, y1 + t, col},
+            {x2 + t, y2 + t, col}, {x2 - t, y2 - t, col}, {x1 - t, y2 + t, col}, {x1 + t, y2 - t, col},
+            {x1 - t, y1 - t, col}, {x1 + t, y1 + t, col}
+        };
+        draw_vertices(lgui::PrimType::PRIM_TRIANGLE_STRIP, vtx, 0, 10);
+    }
+    else {
+        PrimVertex vtx[4] = {{x1, y1, col}, {x2, y1, col}, {x2, y2, col}, {x1, y2, col}};
+        draw_vertices(lgui::PrimType::PRIM_LINE_LOOP, vtx, 0, 4);
+    }
 }
 
 void A5PrimHelper::rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col, float thickness)
 {
-    al_draw_rounded_rectangle(x1, y1, x2, y2,
-                              rx, ry, col, thickness);
+    if (!mbatching) {
+        al_draw_rounded_rectangle(x1, y1, x2, y2,
+                                  rx, ry, col, thickness);
+        mdraw_calls++;
+        return;
+    }
+    rounded_rect_spec_corners(x1, y1, x2, y2, rx, ry, col, thickness, 0xF);
 }
 
 void A5PrimHelper::filled_rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col)
 {
-    al_draw_filled_rounded_rectangle(x1, y1, x2, y2, rx, ry, col);
+    if (!mbatching) {
+        al_draw_filled_rounded_rectangle(x1, y1, x2, y2, rx, ry, col);
+        mdraw_calls++;
+        return;
+    }
+    filled_rounded_rect_spec_corners(x1, y1, x2, y2, rx, ry, col, 0xF);
 }
 
 
 void A5PrimHelper::circle(float cx, float cy, float r, lgui::Color col, float thickness)
 {
-    al_draw_circle(cx, cy, r, col, thickness);
+    if (!mbatching) {
+        al_draw_circle(cx, cy, r, col, thickness);
+        mdraw_calls++;
+        return;
+    }
+    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    int num_segments = PRIM_QUALITY * sqrtf(r);
+    if (thickness > 0) {
+        if (2 * num_segments + 2 >= PRIM_CACHE_SIZE)
+            num_segments = (PRIM_CACHE_SIZE - 3) / 2;
+        calc_arc(&(vertex_cache[0].x), sizeof(PrimVertex), cx, cy, r, r, 0, ALLEGRO_PI * 2, thickness, num_segments);
+        vertex_cache[2 * num_segments] = vertex_cache[0];
+        vertex_cache[2 * num_segments + 1] = vertex_cache[1];
+        for (int ii = 0; ii < 2 * num_segments + 2; ii++)
+            vertex_cache[ii].color = col;
+        draw_vertices(lgui::PrimType::PRIM_TRIANGLE_STRIP, vertex_cache, 0, 2 * num_segments + 2);
+    }
+    else {
+        if (num_segments >= PRIM_CACHE_SIZE)
+            num_segments = PRIM_CACHE_SIZE - 1;
+        calc_arc(&(vertex_cache[0].x), sizeof(PrimVertex), cx, cy, r, r, 0, ALLEGRO_PI * 2, 0, num_segments);
+        for (int ii = 0; ii < num_segments; ii++)
+            vertex_cache[ii].color = col;
+        draw_vertices(lgui::PrimType::PRIM_LINE_LOOP, vertex_cache, 0, num_segments - 1);
+    }
 }
 
 void A5PrimHelper::filled_circle(float cx, float cy, float r, lgui::Color col)
 {
-    al_draw_filled_circle(cx, cy, r, col);
+    if (!mbatching) {
+        al_draw_filled_circle(cx, cy, r, col);
+        mdraw_calls++;
+        return;
+    }
+    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    int num_segments = PRIM_QUALITY * sqrtf(r);
+    if (num_segments >= PRIM_CACHE_SIZE)
+        num_segments = PRIM_CACHE_SIZE - 1;
+    calc_arc(&(vertex_cache[1].x), sizeof(PrimVertex), cx, cy, r, r, 0, ALLEGRO_PI * 2, 0, num_segments);
+    vertex_cache[0].x = cx;
+    vertex_cache[0].y = cy;
+    for (int ii = 0; ii < num_segments + 1; ii++)
+        vertex_cache[ii].color = col;
+    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vertex_cache, 0, num_segments + 1);
 }
 
 void A5PrimHelper::line(float x1, float y1, float x2, float y2, lgui::Color col, float thickness)
 {
-    al_draw_line(x1, y1, x2, y2, col, thickness);
+    if (!mbatching) {
+        al_draw_line(x1, y1, x2, y2, col, thickness);
+        mdraw_calls++;
+        return;
+    }
+    if (thickness > 0) {
+        float dx = x2 - x1, dy = y2 - y1;
+        float len = hypotf(dx, dy);
+        if (len == 0)
+            return;
+        float tx = 0.5f * thickness * dy / len;
+        float ty = 0.5f * thickness * -dx / len;
+        PrimVertex vtx[4] = {{x1 + tx, y1 + ty, col}, {x1 - tx, y1 - ty, col},
+                             {x2 - tx, y2 - ty, col}, {x2 + tx, y2 + ty, col}};
+        draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vtx, 0, 4);
+    }
+    else {
+        PrimVertex vtx[2] = {{x1, y1, col}, {x2, y2, col}};
+        draw_vertices(lgui::PrimType::PRIM_LINE_LIST, vtx, 0, 2);
+    }
 }
 
 void A5PrimHelper::filled_rect(float x1, float y1, float x2, float y2, lgui::Color col)
 {
-    al_draw_filled_rectangle(x1, y1, x2, y2, col);
+    if (!mbatching) {
+        al_draw_filled_rectangle(x1, y1, x2, y2, col);
+        mdraw_calls++;
+        return;
+    }
+    PrimVertex vtx[4] = {{x1, y1, col}, {x1, y2, col}, {x2, y2, col}, {x2, y1, col}};
+    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vtx, 0, 4);
 }
 
 void A5PrimHelper::filled_triangle(float x1, float y1, float x2, float y2, float x3, float y3, lgui::Color col)
 {
-    al_draw_filled_triangle(x1, y1, x2, y2, x3, y3, col);
+    if (!mbatching) {
+        al_draw_filled_triangle(x1, y1, x2, y2, x3, y3, col);
+        mdraw_calls++;
+        return;
+    }
+    PrimVertex vtx[3] = {{x1, y1, col}, {x2, y2, col}, {x3, y3, col}};
+    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_LIST, vtx, 0, 3);
 }
 
 
@@ -150,8 +266,16 @@ void A5PrimHelper::filled_rounded_rect_gradient(float x1, float y1, float x2, fl
        return;
     }
 
+    TessKey key{TessShape::FilledRoundedRectGradient,
+                x2 - x1, y2 - y1, rx, ry, 0, 0, static_cast<int>(dir)};
+    draw_tessellated(key, x1, y1, col1, col2);
+}
 
-    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+int A5PrimHelper::tess_filled_rounded_rect_gradient(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                    float x1, float y1, float x2, float y2, float rx, float ry,
+                                                    const lgui::Color& col1, const lgui::Color& col2,
+                                                    lgui::GradientDirection dir)
+{
     int ii;
     const float scale = 1.0;
     int num_segments = PRIM_QUALITY * scale * sqrtf((rx + ry) / 2.0f) / 4;
@@ -200,7 +324,8 @@ void A5PrimHelper::filled_rounded_rect_gradient(float x1, float y1, float x2, fl
     }
     vertex_cache[4*num_segments+1] = vertex_cache[1]; // close the fan
 
-    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vertex_cache, 0, 4*num_segments + 2);
+    type = lgui::PrimType::PRIM_TRIANGLE_FAN;
+    return 4*num_segments + 2;
 }
 
 void A5PrimHelper::filled_rect_gradient(float x1, float y1, float x2, float y2, const lgui::Color& col1, const lgui::Color& col2, lgui::GradientDirection dir)
@@ -341,15 +466,23 @@ void A5PrimHelper::rounded_rect_spec_corners(float x1, float y1, float x2, float
     ASSERT(ry >= 0);
 
     if(corners == 0 || (rx == 0 || ry == 0)) {
-        al_draw_rectangle(x1, y1, x2, y2, color, thickness);
+        rect(x1, y1, x2, y2, color, thickness);
         return;
     }
-    else if(corners == 0xF) {
-        al_draw_rounded_rectangle(x1, y1, x2, y2, rx, ry, color, thickness);
+    else if(corners == 0xF && !mbatching) {
+        rounded_rect(x1, y1, x2, y2, rx, ry, color, thickness);
         return;
     }
 
-    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    TessKey key{TessShape::RoundedRectSpecCorners,
+                x2 - x1, y2 - y1, rx, ry, thickness, corners, 0};
+    draw_tessellated(key, x1, y1, color, color);
+}
+
+int A5PrimHelper::tess_rounded_rect_spec_corners(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                 float x1, float y1, float x2, float y2, float rx, float ry,
+                                                 lgui::Color color, float thickness, int corners)
+{
 
     const float scale = 1.0;
 
@@ -424,7 +557,8 @@ void A5PrimHelper::rounded_rect_spec_corners(float x1, float y1, float x2, float
             vertex_cache[ii].color = color;
         }
 
-        draw_vertices(lgui::PrimType::PRIM_TRIANGLE_STRIP, vertex_cache, 0, offs);
+        type = lgui::PrimType::PRIM_TRIANGLE_STRIP;
+        return offs;
     }
     else {
         int num_segments = PRIM_QUALITY * scale * sqrtf((rx + ry) / 2.0f) / 4;
@@ -479,7 +613,8 @@ void A5PrimHelper::rounded_rect_spec_corners(float x1, float y1, float x2, float
             vertex_cache[offs].color = color;
             offs++;
         }
-        draw_vertices(lgui::PrimType::PRIM_LINE_LOOP, vertex_cache, 0, offs);
+        type = lgui::PrimType::PRIM_LINE_LOOP;
+        return offs;
     }
 }
 
@@ -489,15 +624,23 @@ void A5PrimHelper::filled_rounded_rect_spec_corners(float x1, float y1, float x2
     ASSERT(ry >= 0);
 
     if(corners == 0 || (rx == 0 || ry == 0)) {
-        al_draw_filled_rectangle(x1, y1, x2, y2, color);
+        filled_rect(x1, y1, x2, y2, color);
         return;
     }
-    else if(corners == 0xF) {
-        al_draw_filled_rounded_rectangle(x1, y1, x2, y2, rx, ry, color);
+    else if(corners == 0xF && !mbatching) {
+        filled_rounded_rect(x1, y1, x2, y2, rx, ry, color);
         return;
     }
 
-    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    TessKey key{TessShape::FilledRoundedRectSpecCorners,
+                x2 - x1, y2 - y1, rx, ry, 0, corners, 0};
+    draw_tessellated(key, x1, y1, color, color);
+}
+
+int A5PrimHelper::tess_filled_rounded_rect_spec_corners(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                        float x1, float y1, float x2, float y2, float rx, float ry,
+                                                        lgui::Color color, int corners)
+{
 
     const float scale = 1.0;
 
@@ -560,7 +703,8 @@ void A5PrimHelper::filled_rounded_rect_spec_corners(float x1, float y1, float x2
         offs++;
     }
 
-    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vertex_cache, 0, offs);
+    type = lgui::PrimType::PRIM_TRIANGLE_FAN;
+    return offs;
 }
 
 
@@ -576,7 +720,15 @@ void A5PrimHelper::rounded_rect_bracket(float x1, float y1, float x2, float y2,
     ASSERT(rx >= 0);
     ASSERT(ry >= 0);
 
-    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    TessKey key{TessShape::RoundedRectBracket,
+                x2 - x1, y2 - y1, rx, ry, thickness, static_cast<int>(oe), 0};
+    draw_tessellated(key, x1, y1, color, color);
+}
+
+int A5PrimHelper::tess_rounded_rect_bracket(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                            float x1, float y1, float x2, float y2, float rx, float ry,
+                                            lgui::Color color, float thickness, lgui::OpenEdge oe)
+{
 
     const float scale = 1.0;
 
@@ -658,7 +810,8 @@ void A5PrimHelper::rounded_rect_bracket(float x1, float y1, float x2, float y2,
             vertex_cache[ii].color = color;
         }
 
-        draw_vertices(lgui::PrimType::PRIM_TRIANGLE_STRIP, vertex_cache, 0, offs);
+        type = lgui::PrimType::PRIM_TRIANGLE_STRIP;
+        return offs;
     }
     else {
         int num_segments = PRIM_QUALITY * scale * sqrtf((rx + ry) / 2.0f) / 4;
@@ -723,7 +876,8 @@ void A5PrimHelper::rounded_rect_bracket(float x1, float y1, float x2, float y2,
                 offs++;
                 break;
         }
-        draw_vertices(lgui::PrimType::PRIM_LINE_STRIP, vertex_cache, 0, offs);
+        type = lgui::PrimType::PRIM_LINE_STRIP;
+        return offs;
    }
 }
 
@@ -833,7 +987,15 @@ void A5PrimHelper::filled_rounded_rect_bracket(float x1, float y1, float x2, flo
     ASSERT(rx >= 0);
     ASSERT(ry >= 0);
 
-    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    TessKey key{TessShape::FilledRoundedRectBracket,
+                x2 - x1, y2 - y1, rx, ry, 0, static_cast<int>(oe), 0};
+    draw_tessellated(key, x1, y1, color, color);
+}
+
+int A5PrimHelper::tess_filled_rounded_rect_bracket(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                   float x1, float y1, float x2, float y2, float rx, float ry,
+                                                   lgui::Color color, lgui::OpenEdge oe)
+{
 
     const float scale = 1.0;
 
@@ -900,7 +1062,8 @@ void A5PrimHelper::filled_rounded_rect_bracket(float x1, float y1, float x2, flo
             break;
     }
 
-    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vertex_cache, 0, offs);
+    type = lgui::PrimType::PRIM_TRIANGLE_FAN;
+    return offs;
 }
 
 
@@ -916,7 +1079,16 @@ void A5PrimHelper::filled_rounded_rect_bracket_gradient(float x1, float y1, floa
     ASSERT(rx >= 0);
     ASSERT(ry >= 0);
 
-    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    TessKey key{TessShape::FilledRoundedRectBracketGradient,
+                x2 - x1, y2 - y1, rx, ry, 0, static_cast<int>(oe), static_cast<int>(dir)};
+    draw_tessellated(key, x1, y1, col1, col2);
+}
+
+int A5PrimHelper::tess_filled_rounded_rect_bracket_gradient(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                            float x1, float y1, float x2, float y2, float rx, float ry,
+                                                            const lgui::Color& col1, const lgui::Color& col2,
+                                                            lgui::OpenEdge oe, lgui::GradientDirection dir)
+{
 
     const float scale = 1.0;
 
@@ -1000,13 +1172,14 @@ void A5PrimHelper::filled_rounded_rect_bracket_gradient(float x1, float y1, floa
 
     vertex_cache[offs++] = vertex_cache[1]; // close fan
 
-    draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vertex_cache, 0, offs);
+    type = lgui::PrimType::PRIM_TRIANGLE_FAN;
+    return offs;
 }
 
 void A5PrimHelper::draw_visible_pixel(float px, float py, lgui::Color col)
 {
-    al_draw_line(px - 3, py,     px + 3, py,     col,  0);
-    al_draw_line(px,     py - 3, px,     py + 3, col,  0);
+    line(px - 3, py,     px + 3, py,     col,  0);
+    line(px,     py - 3, px,     py + 3, col,  0);
 }
 
 void A5PrimHelper::draw_filled_pieslice(float cx, float cy, float r, float start_theta, float delta_theta, ALLEGRO_COLOR color)
@@ -1035,24 +1208,223 @@ void A5PrimHelper::draw_filled_pieslice(float cx, float cy, float r, float start
     draw_vertices(lgui::PrimType::PRIM_TRIANGLE_FAN, vertex_cache, 0, num_segments+1);
 }
 
+void A5PrimHelper::set_tessellation_cache_size(unsigned int max_entries)
+{
+    mtess_max_entries = max_entries;
+    while (mtess_lru.size() > mtess_max_entries) {
+        mtess_index.erase(mtess_lru.back().key);
+        mtess_lru.pop_back();
+    }
+}
+
+void A5PrimHelper::clear_tessellation_cache()
+{
+    mtess_index.clear();
+    mtess_lru.clear();
+}
+
+bool A5PrimHelper::TessKey::operator==(const TessKey& other) const
+{
+    return shape == other.shape && w == other.w && h == other.h && rx == other.rx && ry == other.ry &&
+           thickness == other.thickness && variant == other.variant && dir == other.dir;
+}
+
+size_t A5PrimHelper::TessKeyHash::operator()(const TessKey& key) const
+{
+    std::hash<float> hf;
+    size_t h = static_cast<size_t>(key.shape);
+    auto combine = [&h](size_t v) { h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2); };
+    combine(hf(key.w));
+    combine(hf(key.h));
+    combine(hf(key.rx));
+    combine(hf(key.ry));
+    combine(hf(key.thickness));
+    combine(static_cast<size_t>(key.variant));
+    combine(static_cast<size_t>(key.dir));
+    return h;
+}
+
+int A5PrimHelper::tessellate(const TessKey& key, PrimVertex* vertex_cache, lgui::PrimType& type)
+{
+    // Colors encode the gradient parameter, see TessEntry.
+    const lgui::Color c1 = lgui::rgba(0, 0, 0, 0), c2 = lgui::rgba(1, 1, 1, 1);
+    const float w = key.w, h = key.h, rx = key.rx, ry = key.ry;
+    const auto oe = static_cast<lgui::OpenEdge>(key.variant);
+    const auto dir = static_cast<lgui::GradientDirection>(key.dir);
+    switch (key.shape) {
+        case TessShape::FilledRoundedRectGradient:
+            return tess_filled_rounded_rect_gradient(vertex_cache, type, 0, 0, w, h, rx, ry, c1, c2, dir);
+        case TessShape::RoundedRectSpecCorners:
+            return tess_rounded_rect_spec_corners(vertex_cache, type, 0, 0, w, h, rx, ry, c1, key.thickness,
+                                                  key.variant);
+        case TessShape::FilledRoundedRectSpecCorners:
+            return tess_filled_rounded_rect_spec_corners(vertex_cache, type, 0, 0, w, h, rx, ry, c1, key.variant);
+        case TessShape::RoundedRectBracket:
+            return tess_rounded_rect_bracket(vertex_cache, type, 0, 0, w, h, rx, ry, c1, key.thickness, oe);
+        case TessShape::FilledRoundedRectBracket:
+            return tess_filled_rounded_rect_bracket(vertex_cache, type, 0, 0, w, h, rx, ry, c1, oe);
+        case TessShape::FilledRoundedRectBracketGradient:
+            return tess_filled_rounded_rect_bracket_gradient(vertex_cache, type, 0, 0, w, h, rx, ry, c1, c2,
+                                                             oe, dir);
+    }
+    return 0;
+}
+
+void A5PrimHelper::draw_tessellated(const TessKey& key, float x, float y, const lgui::Color& col1,
+                                    const lgui::Color& col2)
+{
+    PrimVertex vertex_cache[PRIM_CACHE_SIZE];
+    const PrimVertex* src = vertex_cache;
+    lgui::PrimType type;
+    int n;
+
+    auto it = mtess_index.find(key);
+    if (it != mtess_index.end()) {
+        mtess_hits++;
+        mtess_lru.splice(mtess_lru.begin(), mtess_lru, it->second);
+        const TessEntry& e = mtess_lru.front();
+        src = e.vertices.data();
+        n = e.vertices.size();
+        type = e.type;
+    }
+    else {
+        mtess_misses++;
+        n = tessellate(key, vertex_cache, type);
+        if (mtess_max_entries > 0) {
+            if (mtess_lru.size() >= mtess_max_entries) {
+                mtess_index.erase(mtess_lru.back().key);
+                mtess_lru.pop_back();
+            }
+            mtess_lru.push_front(TessEntry{key, type, std::vector<PrimVertex>(vertex_cache, vertex_cache + n)});
+            mtess_index[key] = mtess_lru.begin();
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        const PrimVertex v = src[i];
+        vertex_cache[i].x = x + v.x;
+        vertex_cache[i].y = y + v.y;
+        vertex_cache[i].color = mix_colors(col1, col2, v.color.r);
+    }
+    draw_vertices(type, vertex_cache, 0, n);
+}
+
 void A5PrimHelper::draw_vertices_indexed(lgui::PrimType type, const std::vector<PrimVertex>& verts,
                                          const std::vector<int>& indices, unsigned int n) const
 {
     ASSERT(n <= indices.size());
+    if (mbatching) {
+        std::vector<PrimVertex> expanded(n);
+        for (unsigned int i = 0; i < n; i++)
+            expanded[i] = verts[indices[i]];
+        batch_vertices(type, expanded.data(), 0, n);
+        return;
+    }
+    init();
     al_draw_indexed_prim(verts.data(), mprim_vertex_decl, nullptr, indices.data(), n, static_cast<int>(type));
+    mdraw_calls++;
 }
 
 void A5PrimHelper::draw_vertices(lgui::PrimType type, const std::vector<PrimVertex>& verts, unsigned int start,
                                  unsigned int end) const
 {
     ASSERT(start <= verts.size() && end <= verts.size());
-    al_draw_prim(verts.data(), mprim_vertex_decl, nullptr, start, end, static_cast<int>(type));
+    draw_vertices(type, verts.data(), start, end);
 }
 
 void A5PrimHelper::draw_vertices(lgui::PrimType type, const PrimVertex* first, unsigned int start,
                                  unsigned int end) const
 {
+    if (mbatching)
+        batch_vertices(type, first, start, end);
+    else
+        submit(type, first, start, end);
+}
+
+void A5PrimHelper::submit(lgui::PrimType type, const PrimVertex* first, unsigned int start, unsigned int end) const
+{
+    init();
     al_draw_prim(first, mprim_vertex_decl, nullptr, start, end, static_cast<int>(type));
+    mdraw_calls++;
+}
+
+void A5PrimHelper::flush() const
+{
+    if (!mbatch.empty()) {
+        submit(mbatch_type, mbatch.data(), 0, mbatch.size());
+        mbatch.clear();
+    }
+}
+
+// Converts everything to point, line or triangle lists so that consecutive primitives can be drawn at once.
+void A5PrimHelper::batch_vertices(lgui::PrimType type, const PrimVertex* first, unsigned int start,
+                                  unsigned int end) const
+{
+    if (end <= start)
+        return;
+    lgui::PrimType batch_type;
+    unsigned int list_stride;
+    switch (type) {
+        case lgui::PrimType::PRIM_POINT_LIST:
+            batch_type = lgui::PrimType::PRIM_POINT_LIST;
+            list_stride = 1;
+            break;
+        case lgui::PrimType::PRIM_LINE_LIST:
+        case lgui::PrimType::PRIM_LINE_STRIP:
+        case lgui::PrimType::PRIM_LINE_LOOP:
+            batch_type = lgui::PrimType::PRIM_LINE_LIST;
+            list_stride = 2;
+            break;
+        default:
+            batch_type = lgui::PrimType::PRIM_TRIANGLE_LIST;
+            list_stride = 3;
+            break;
+    }
+    if (batch_type != mbatch_type || mbatch.size() >= MAX_BATCH_SIZE) {
+        flush();
+        mbatch_type = batch_type;
+    }
+
+    const float dx = mbatch_dx, dy = mbatch_dy;
+    auto add = [this, first, dx, dy](unsigned int i) {
+        const PrimVertex& v = first[i];
+        mbatch.push_back(PrimVertex{v.x + dx, v.y + dy, v.color});
+    };
+
+    switch (type) {
+        case lgui::PrimType::PRIM_POINT_LIST:
+        case lgui::PrimType::PRIM_LINE_LIST:
+        case lgui::PrimType::PRIM_TRIANGLE_LIST:
+            end -= (end - start) % list_stride;
+            for (unsigned int i = start; i < end; i++)
+                add(i);
+            break;
+        case lgui::PrimType::PRIM_LINE_STRIP:
+        case lgui::PrimType::PRIM_LINE_LOOP:
+            for (unsigned int i = start + 1; i < end; i++) {
+                add(i - 1);
+                add(i);
+            }
+            if (type == lgui::PrimType::PRIM_LINE_LOOP && end - start > 2) {
+                add(end - 1);
+                add(start);
+            }
+            break;
+        case lgui::PrimType::PRIM_TRIANGLE_STRIP:
+            for (unsigned int i = start + 2; i < end; i++) {
+                add(i - 2);
+                add(i - 1);
+                add(i);
+            }
+            break;
+        case lgui::PrimType::PRIM_TRIANGLE_FAN:
+            for (unsigned int i = start + 2; i < end; i++) {
+                add(start);
+                add(i - 1);
+                add(i);
+            }
+            break;
+    }
 }
 
 void A5PrimHelper::calc_pie_slice(std::vector<PrimVertex>& dest, float cx, float cy, float rx, float ry,
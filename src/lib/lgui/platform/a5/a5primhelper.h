@@ -42,6 +42,8 @@
 
 #include "../color.h"
 #include <allegro5/allegro_primitives.h>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace lgui {
@@ -70,7 +72,46 @@ class A5PrimHelper {
         A5PrimHelper(const A5PrimHelper&& other) = delete;
         A5PrimHelper operator=(const A5PrimHelper& other) = delete;
 
-        void init();
+        /** Create the vertex declaration if that hasn't been done yet. Called before the first draw call, so
+         *  that a helper that never draws (e.g. one of a recording-only Graphics) doesn't need Allegro. */
+        void init() const;
+
+        /** Enable or disable batching. While batching, primitives are not drawn right away, but converted to
+         *  lists and collected in a vertex buffer that is submitted with one draw call by flush(), or
+         *  automatically when a primitive of a different kind (points, lines, triangles) is added. Batched
+         *  primitives will be drawn with the transformation active at the time of flushing, so the
+         *  caller has to flush before changing it. Disabling batching flushes. */
+        void set_batching(bool batching);
+        bool is_batching() const { return mbatching; }
+
+        /** Set an offset to be added to the vertices of all primitives batched from now on. Used to apply
+         *  translations on the CPU instead of changing the transformation. */
+        void set_batch_offset(float dx, float dy) {
+            mbatch_dx = dx;
+            mbatch_dy = dy;
+        }
+
+        /** Submit all batched primitives. */
+        void flush() const;
+
+        /** Return the number of draw calls issued since the last call to reset_draw_calls(). */
+        int draw_calls() const { return mdraw_calls; }
+        void reset_draw_calls() { mdraw_calls = 0; }
+
+        /** Set the maximum number of shapes kept in the tessellation cache (default: 256). Rounded rectangles
+         *  with specific corners, (rounded) brackets and rounded gradients are tessellated once per size,
+         *  radii, thickness, corners or open edge and gradient direction; drawing them again only translates
+         *  and recolors the cached vertices. The least recently used shapes are evicted first; 0 disables
+         *  the cache. */
+        void set_tessellation_cache_size(unsigned int max_entries);
+        unsigned int tessellation_cache_size() const { return mtess_max_entries; }
+        void clear_tessellation_cache();
+
+        /** Return the number of tessellation cache hits since the last call to reset_tessellation_cache_stats(). */
+        int tessellation_cache_hits() const { return mtess_hits; }
+        /** Return the number of tessellation cache misses since the last call to reset_tessellation_cache_stats(). */
+        int tessellation_cache_misses() const { return mtess_misses; }
+        void reset_tessellation_cache_stats() { mtess_hits = mtess_misses = 0; }
 
         void rect(float x1, float y1, float x2, float y2, lgui::Color col, float thickness);
         void filled_rect(float x1, float y1, float x2, float y2, lgui::Color col);
@@ -119,8 +160,77 @@ class A5PrimHelper {
         static void calc_arc(float* dest, int stride, float cx, float cy, float rx, float ry,
                              float start_theta, float delta_theta, float thickness, int num_points);
     private:
-        ALLEGRO_VERTEX_DECL* mprim_vertex_decl;
-
+        static const constexpr unsigned int MAX_BATCH_SIZE = 0x10000;
+
+        enum class TessShape {
+                FilledRoundedRectGradient, RoundedRectSpecCorners, FilledRoundedRectSpecCorners,
+                RoundedRectBracket, FilledRoundedRectBracket, FilledRoundedRectBracketGradient
+        };
+
+        /** Identifies a shape independent of its position and colors. `variant` holds corners or open edge,
+         *  `dir` the gradient direction. */
+        struct TessKey {
+            TessShape shape;
+            float w, h, rx, ry, thickness;
+            int variant, dir;
+
+            bool operator==(const TessKey& other) const;
+        };
+
+        struct TessKeyHash {
+            size_t operator()(const TessKey& key) const;
+        };
+
+        /** Vertices relative to the origin, with the gradient parameter (0 for the first color, 1 for the
+         *  second) stored in the red component of the color. */
+        struct TessEntry {
+            TessKey key;
+            lgui::PrimType type;
+            std::vector<PrimVertex> vertices;
+        };
+
+        using TessList = std::list<TessEntry>;
+
+        void draw_tessellated(const TessKey& key, float x, float y, const lgui::Color& col1,
+                              const lgui::Color& col2);
+        static int tessellate(const TessKey& key, PrimVertex* vertex_cache, lgui::PrimType& type);
+
+        static int tess_filled_rounded_rect_gradient(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                     float x1, float y1, float x2, float y2, float rx, float ry,
+                                                     const lgui::Color& col1, const lgui::Color& col2,
+                                                     lgui::GradientDirection dir);
+        static int tess_rounded_rect_spec_corners(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                  float x1, float y1, float x2, float y2, float rx, float ry,
+                                                  lgui::Color color, float thickness, int corners);
+        static int tess_filled_rounded_rect_spec_corners(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                         float x1, float y1, float x2, float y2, float rx, float ry,
+                                                         lgui::Color color, int corners);
+        static int tess_rounded_rect_bracket(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                             float x1, float y1, float x2, float y2, float rx, float ry,
+                                             lgui::Color color, float thickness, lgui::OpenEdge oe);
+        static int tess_filled_rounded_rect_bracket(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                    float x1, float y1, float x2, float y2, float rx, float ry,
+                                                    lgui::Color color, lgui::OpenEdge oe);
+        static int tess_filled_rounded_rect_bracket_gradient(PrimVertex* vertex_cache, lgui::PrimType& type,
+                                                             float x1, float y1, float x2, float y2, float rx,
+                                                             float ry, const lgui::Color& col1,
+                                                             const lgui::Color& col2, lgui::OpenEdge oe,
+                                                             lgui::GradientDirection dir);
+
+        void batch_vertices(lgui::PrimType type, const PrimVertex* first, unsigned int start,
+                            unsigned int end) const;
+        void submit(lgui::PrimType type, const PrimVertex* first, unsigned int start, unsigned int end) const;
+
+        mutable ALLEGRO_VERTEX_DECL* mprim_vertex_decl;
+        bool mbatching;
+        float mbatch_dx, mbatch_dy;
+        mutable std::vector<PrimVertex> mbatch;
+        mutable lgui::PrimType mbatch_type;
+        mutable int mdraw_calls;
+        TessList mtess_lru;
+        std::unordered_map<TessKey, TessList::iterator, TessKeyHash> mtess_index;
+        unsigned int mtess_max_entries;
+        int mtess_hits, mtess_misses;
 };
 
 }
@@ -0,0 +1,142 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstring>
+#include <algorithm>
+
+#include "../textrun.h"
+#include "../font.h"
+#include "../utf8.h"
+#include "../error.h"
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+
+namespace lgui {
+
+A5TextRun::A5TextRun()
+        : mfont_id(0), mglyphs_font_id(0), mwidth(0) {}
+
+A5TextRun::A5TextRun(const std::string& text)
+        : mtext(text), mfont_id(0), mglyphs_font_id(0), mwidth(0) {}
+
+void A5TextRun::set_text(const std::string& text) {
+    if (text != mtext) {
+        mtext = text;
+        mfont_id = 0;
+        mglyphs_font_id = 0;
+    }
+}
+
+void A5TextRun::shape(const A5Font& font) const {
+    if (mfont_id == font.id())
+        return;
+    mfont_id = font.id();
+    mglyphs_font_id = 0;
+    mpen.clear();
+    moffs.clear();
+
+    std::lock_guard<std::mutex> lock(font.mmutex);
+    size_t pos = 0, offs = 0;
+    float pen = 0;
+    int cp = utf8::get_cp_next(mtext, pos);
+    while (cp >= 0) {
+        size_t next_offs = pos;
+        int next_cp = utf8::get_cp_next(mtext, pos);
+        mpen.push_back(pen);
+        moffs.push_back(offs);
+        // Includes the kerning with the next code point, so the pen is where the next glyph is drawn.
+        pen += al_get_glyph_advance(font.mfnt, cp, next_cp < 0 ? ALLEGRO_NO_KERNING : next_cp);
+        cp = next_cp;
+        offs = next_offs;
+    }
+    mpen.push_back(pen);
+    moffs.push_back(mtext.size());
+    mwidth = al_get_text_width(font.mfnt, mtext.c_str());
+}
+
+void A5TextRun::render_glyphs(const A5Font& font) const {
+    ASSERT(mfont_id == font.id());
+    if (mglyphs_font_id == font.id())
+        return;
+    mglyphs_font_id = font.id();
+    mglyphs.clear();
+    size_t pos = 0, idx = 0;
+    int cp;
+    while ((cp = utf8::get_cp_next(mtext, pos)) >= 0) {
+        ALLEGRO_GLYPH glyph;
+        memset(&glyph, 0, sizeof(ALLEGRO_GLYPH));
+        // No kerning: it is part of the pen positions already.
+        al_get_glyph(font.mfnt, -1, cp, &glyph);
+        if (glyph.bitmap != nullptr) {
+            mglyphs.push_back(Glyph{glyph.bitmap, glyph.x, glyph.y, glyph.w, glyph.h,
+                                    mpen[idx] + glyph.offset_x, float(glyph.offset_y)});
+        }
+        idx++;
+    }
+}
+
+int A5TextRun::width(const A5Font& font) const {
+    shape(font);
+    return mwidth;
+}
+
+int A5TextRun::cp_x(const A5Font& font, size_t cp_idx) const {
+    shape(font);
+    if (cp_idx >= mpen.size())
+        cp_idx = mpen.size() - 1;
+    return mpen[cp_idx];
+}
+
+std::pair<size_t, size_t> A5TextRun::hit_char(const A5Font& font, int px) const {
+    shape(font);
+    if (px <= 0 || mtext.empty())
+        return {0, 0};
+    // First code point starting at or after px.
+    auto it = std::lower_bound(mpen.begin(), mpen.end(), float(px));
+    if (it == mpen.end())
+        return {mtext.size(), mpen.size() - 1};
+    size_t idx = it - mpen.begin();
+    // Nearer to previous character?
+    if (idx > 0 && px - mpen[idx - 1] < mpen[idx] - px)
+        idx--;
+    return {moffs[idx], idx};
+}
+
+}
@@ -0,0 +1,105 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_A5_TEXTRUN_H
+#define LGUI_A5_TEXTRUN_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct ALLEGRO_BITMAP;
+
+namespace lgui {
+
+class A5Font;
+
+/** Allegro 5 implementation of a text run. Do not use this class directly, but rather use TextRun. */
+class A5TextRun {
+        friend class A5Graphics;
+
+    public:
+        A5TextRun();
+        explicit A5TextRun(const std::string& text);
+
+        /** Set the text. It will be shaped again when it is used the next time. */
+        void set_text(const std::string& text);
+        const std::string& text() const { return mtext; }
+        bool empty() const { return mtext.empty(); }
+
+        /** Look up advances and kerning of the text for `font` unless that has already been done for the
+         *  current text and font. All other methods taking a font call this. The glyphs themselves are looked
+         *  up when the run is drawn, since that may render them, which needs the display. */
+        void shape(const A5Font& font) const;
+
+        /** Return the width the text will occupy using `font`. Same as Font::text_width(). */
+        int width(const A5Font& font) const;
+
+        /** Return the x-coordinate the code point with index `cp_idx` starts at. Indices past the end will
+         *  return the position after the last code point. */
+        int cp_x(const A5Font& font, size_t cp_idx) const;
+
+        /** Return offset (first) and code point index (second) of the character hit by a point with
+         *  x-coordinate px. Same as Font::hit_char(), but without measuring any substrings. */
+        std::pair<size_t, size_t> hit_char(const A5Font& font, int px) const;
+
+    private:
+        // Look up the glyphs of the shaped run. Called by A5Graphics with the font's mutex held.
+        void render_glyphs(const A5Font& font) const;
+
+        struct Glyph {
+            ALLEGRO_BITMAP* bitmap;
+            int sx, sy, sw, sh;
+            float dx, dy;
+        };
+
+        std::string mtext;
+        mutable uint64_t mfont_id; // of the font shaped for, 0 if not shaped
+        mutable uint64_t mglyphs_font_id; // of the font mglyphs have been looked up for, 0 if not yet
+        mutable int mwidth;
+        mutable std::vector<Glyph> mglyphs;
+        // Pen position and byte offset for every code point, plus one entry for the end.
+        mutable std::vector<float> mpen;
+        mutable std::vector<size_t> moffs;
+};
+
+}
+
+#endif // LGUI_A5_TEXTRUN_H
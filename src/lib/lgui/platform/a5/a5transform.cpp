@@ -71,6 +71,18 @@ void A5Transform::compose_pre(const A5Transform& other) {
 #undef E
 }
 
+bool A5Transform::is_translation() const {
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            if (i == 3 && j < 2) // X and Y translation
+                continue;
+            if (mtransform.m[i][j] != (i == j ? 1.0f : 0.0f))
+                return false;
+        }
+    }
+    return true;
+}
+
 void A5Transform::set_rotation(float degrees) {
     al_rotate_transform(&mtransform, degrees / 180.0 * ALLEGRO_PI);
 }
@@ -93,6 +93,14 @@ class A5Transform {
             return {dx, dy};
         }
 
+        /** Return whether the transformation is a pure 2D translation. */
+        bool is_translation() const;
+
+        /** Return the translation component of the transformation. */
+        PointF translation() const {
+            return {mtransform.m[3][0], mtransform.m[3][1]};
+        }
+
         /** Return whether the transformation is invertable. */
         bool is_invertable() const {
             return al_check_inverse(&mtransform, 1e-7);
@@ -40,15 +40,26 @@
 #ifndef LGUI_BITMAP_H
 #define LGUI_BITMAP_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlbitmap.h"
+
+namespace lgui {
+using BitmapImplementation = HLBitmap;
+}
+#else
 #include "a5/a5bitmap.h"
 
 namespace lgui {
 using BitmapImplementation = A5Bitmap;
 }
+#endif
+
+#include "drawlistreplayer.h"
 
 namespace lgui {
 
-/** Class representing a bitmap resource. */
+/** Class representing a bitmap resource. Destroying a bitmap waits until no draw list that may reference it
+ *  is replayed on another thread anymore (see RenderThread). */
 class Bitmap : public BitmapImplementation {
     public:
         explicit Bitmap(const char* filename, bool filter = false)
@@ -56,6 +67,10 @@ class Bitmap : public BitmapImplementation {
 
         Bitmap(int w, int h)
                 : BitmapImplementation(w, h) {}
+
+        Bitmap(Bitmap&& other) = default;
+
+        ~Bitmap() { dtl::wait_for_draw_list_replayers(); }
 };
 
 }
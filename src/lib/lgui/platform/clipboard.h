@@ -40,11 +40,19 @@
 #ifndef LGUI_CLIPBOARD_H
 #define LGUI_CLIPBOARD_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlclipboard.h"
+#else
 #include "a5/a5clipboard.h"
+#endif
 
 namespace lgui {
 
+#ifdef LGUI_HEADLESS
+using ClipboardImplementation = HLClipboard;
+#else
 using ClipboardImplementation = A5Clipboard;
+#endif
 
 class Clipboard : public ClipboardImplementation {
 };
@@ -40,6 +40,10 @@
 #ifndef LGUI_COLOR_H
 #define LGUI_COLOR_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlcolor.h"
+#else
 #include "a5/a5color.h"
+#endif
 
 #endif // LGUI_COLOR_H
@@ -0,0 +1,469 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include "drawlist.h"
+#include "graphics.h"
+#include "bitmap.h"
+#include "error.h"
+#include "lgui/profiler.h"
+
+namespace lgui {
+
+static Color mult_opacity(const Color& col, float opacity) {
+    if (opacity == 1.0f)
+        return col;
+    return rgba(col.r * opacity, col.g * opacity, col.b * opacity, col.a * opacity);
+}
+
+void DrawList::clear() {
+    mcommands.clear();
+    mvertices.clear();
+    mtransforms.clear();
+    mtexts.clear();
+    mruns.clear();
+    mopen_areas.clear();
+}
+
+DrawList::Command& DrawList::add(Op op, const Color& col1, std::initializer_list<float> f) {
+    ASSERT(f.size() <= 8);
+    mcommands.emplace_back(); // value-initialized: all arguments are zero
+    Command& c = mcommands.back();
+    c.op = op;
+    std::copy(f.begin(), f.end(), std::begin(c.f));
+    c.col1 = col1;
+    c.col2 = col1;
+    return c;
+}
+
+void DrawList::push_area(int offsx, int offsy, int w, int h, const Transform* transform, bool clip,
+                         const Rect* cull_bounds) {
+    mopen_areas.push_back(mcommands.size());
+    Command& c = add(Op::PushArea, Color(), {});
+    if (cull_bounds) {
+        c.f[0] = cull_bounds->x();
+        c.f[1] = cull_bounds->y();
+        c.f[2] = cull_bounds->w();
+        c.f[3] = cull_bounds->h();
+    }
+    else
+        c.f[2] = -1; // not culled
+    c.i[0] = offsx;
+    c.i[1] = offsy;
+    c.i[2] = w;
+    c.i[3] = h;
+    c.i[4] = -1;
+    c.clip = clip;
+    if (transform) {
+        c.i[4] = mtransforms.size();
+        mtransforms.push_back(*transform);
+    }
+}
+
+void DrawList::pop_area() {
+    ASSERT(!mopen_areas.empty());
+    if (size_t(mopen_areas.back()) + 1 == mcommands.size()) {
+        // Nothing has been drawn within the area (e.g. a container's padding), so it can be left out.
+        const Command& c = mcommands.back();
+        if (c.i[4] >= 0)
+            mtransforms.pop_back();
+        mcommands.pop_back();
+        mopen_areas.pop_back();
+        return;
+    }
+    // Remember where the area ends so that replay() can skip it if it is culled.
+    mcommands[mopen_areas.back()].i[5] = mcommands.size();
+    mopen_areas.pop_back();
+    add(Op::PopArea, Color(), {});
+}
+
+void DrawList::clear_to_color(Color col) {
+    add(Op::Clear, col, {});
+}
+
+void DrawList::fill_draw_area(Color col) {
+    add(Op::FillDrawArea, col, {});
+}
+
+void DrawList::rect(float x1, float y1, float x2, float y2, Color col, float thickness) {
+    add(Op::Rect, col, {x1, y1, x2, y2, thickness});
+}
+
+void DrawList::filled_rect(float x1, float y1, float x2, float y2, Color col) {
+    add(Op::FilledRect, col, {x1, y1, x2, y2});
+}
+
+void DrawList::filled_triangle(float x1, float y1, float x2, float y2, float x3, float y3, Color col) {
+    add(Op::FilledTriangle, col, {x1, y1, x2, y2, x3, y3});
+}
+
+void DrawList::rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, Color col,
+                            float thickness) {
+    add(Op::RoundedRect, col, {x1, y1, x2, y2, rx, ry, thickness});
+}
+
+void DrawList::filled_rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, Color col) {
+    add(Op::FilledRoundedRect, col, {x1, y1, x2, y2, rx, ry});
+}
+
+void DrawList::filled_rounded_rect_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                            const Color& col1, const Color& col2, GradientDirection dir) {
+    Command& c = add(Op::FilledRoundedRectGradient, col1, {x1, y1, x2, y2, rx, ry});
+    c.col2 = col2;
+    c.i[0] = int(dir);
+}
+
+void DrawList::filled_rect_gradient(float x1, float y1, float x2, float y2, const Color& col1, const Color& col2,
+                                    GradientDirection dir) {
+    Command& c = add(Op::FilledRectGradient, col1, {x1, y1, x2, y2});
+    c.col2 = col2;
+    c.i[0] = int(dir);
+}
+
+void DrawList::rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry, Color col,
+                                         float thickness, int corners) {
+    Command& c = add(Op::RoundedRectSpecCorners, col, {x1, y1, x2, y2, rx, ry, thickness});
+    c.i[0] = corners;
+}
+
+void DrawList::filled_rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                Color col, int corners) {
+    Command& c = add(Op::FilledRoundedRectSpecCorners, col, {x1, y1, x2, y2, rx, ry});
+    c.i[0] = corners;
+}
+
+void DrawList::rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry, Color col,
+                                    float thickness, OpenEdge oe) {
+    Command& c = add(Op::RoundedRectBracket, col, {x1, y1, x2, y2, rx, ry, thickness});
+    c.i[0] = int(oe);
+}
+
+void DrawList::rect_bracket(float x1, float y1, float x2, float y2, Color col, float thickness, OpenEdge oe) {
+    Command& c = add(Op::RectBracket, col, {x1, y1, x2, y2, thickness});
+    c.i[0] = int(oe);
+}
+
+void DrawList::filled_rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry,
+                                           Color col, OpenEdge oe) {
+    Command& c = add(Op::FilledRoundedRectBracket, col, {x1, y1, x2, y2, rx, ry});
+    c.i[0] = int(oe);
+}
+
+void DrawList::filled_rounded_rect_bracket_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                    const Color& col1, const Color& col2, OpenEdge oe,
+                                                    GradientDirection dir) {
+    Command& c = add(Op::FilledRoundedRectBracketGradient, col1, {x1, y1, x2, y2, rx, ry});
+    c.col2 = col2;
+    c.i[0] = int(oe);
+    c.i[1] = int(dir);
+}
+
+void DrawList::circle(float cx, float cy, float r, Color col, float thickness) {
+    add(Op::Circle, col, {cx, cy, r, thickness});
+}
+
+void DrawList::filled_circle(float cx, float cy, float r, Color col) {
+    add(Op::FilledCircle, col, {cx, cy, r});
+}
+
+void DrawList::line(float x1, float y1, float x2, float y2, Color col, float thickness) {
+    add(Op::Line, col, {x1, y1, x2, y2, thickness});
+}
+
+void DrawList::draw_visible_pixel(float px, float py, Color col) {
+    add(Op::VisiblePixel, col, {px, py});
+}
+
+void DrawList::draw_filled_pieslice(float cx, float cy, float r, float start_theta, float delta_theta, Color col) {
+    add(Op::FilledPieslice, col, {cx, cy, r, start_theta, delta_theta});
+}
+
+void DrawList::draw_vertices(PrimType type, const PrimVertex* first, unsigned int start, unsigned int end) {
+    if (end <= start)
+        return;
+    Command& c = add(Op::Vertices, Color(), {});
+    c.i[0] = int(type);
+    c.i[1] = mvertices.size();
+    c.i[2] = end - start;
+    mvertices.insert(mvertices.end(), first + start, first + end);
+}
+
+void DrawList::draw_vertices_indexed(PrimType type, const std::vector<PrimVertex>& verts,
+                                     const std::vector<int>& indices, unsigned int n) {
+    ASSERT(n <= indices.size());
+    if (n == 0)
+        return;
+    // Resolve the indices: this needs more space, but the vertices can be replayed as one range.
+    Command& c = add(Op::Vertices, Color(), {});
+    c.i[0] = int(type);
+    c.i[1] = mvertices.size();
+    c.i[2] = n;
+    for (unsigned int i = 0; i < n; i++)
+        mvertices.push_back(verts[indices[i]]);
+}
+
+void DrawList::draw_ninepatch_tinted(const NinePatch& np, const Color& col, int dx, int dy,
+                                     const Size& content_size) {
+    Command& c = add(Op::NinePatch, col, {float(dx), float(dy)});
+    c.i[0] = content_size.w();
+    c.i[1] = content_size.h();
+    c.res = &np;
+}
+
+void DrawList::draw_tinted_bmp_region(const Bitmap& bitmap, int dx, int dy, int sx, int sy, int sw, int sh,
+                                      Color col, int flip) {
+    Command& c = add(Op::BitmapRegion, col, {float(dx), float(dy)});
+    c.i[0] = sx;
+    c.i[1] = sy;
+    c.i[2] = sw;
+    c.i[3] = sh;
+    c.i[4] = flip;
+    c.res = &bitmap;
+}
+
+void DrawList::draw_tinted_scaled_bmp(const Bitmap& bitmap, int dx, int dy, int dw, int dh, Color col, int flip) {
+    Command& c = add(Op::ScaledBitmap, col, {float(dx), float(dy)});
+    c.i[0] = dw;
+    c.i[1] = dh;
+    c.i[2] = flip;
+    c.res = &bitmap;
+}
+
+void DrawList::draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, float dx, float dy, float sx, float sy,
+                                                      float sw, float sh, float crx, float cry, Color col) {
+    Command& c = add(Op::BitmapRegionRoundedCorners, col, {dx, dy, sx, sy, sw, sh, crx, cry});
+    c.res = &bitmap;
+}
+
+void DrawList::draw_text(Op op, const FontImplementation& font, float x, float y, Color col,
+                         const std::string& text) {
+    Command& c = add(op, col, {x, y});
+    c.i[0] = mtexts.size();
+    c.res = &font;
+    mtexts.push_back(text);
+}
+
+void DrawList::draw_text_clipped_to_rect(const FontImplementation& font, float x, float y, Color col,
+                                         const Rect& clip_rect, const std::string& text) {
+    draw_text(Op::TextClipped, font, x, y, col, text);
+    Command& c = mcommands.back();
+    c.i[1] = clip_rect.x();
+    c.i[2] = clip_rect.y();
+    c.i[3] = clip_rect.w();
+    c.i[4] = clip_rect.h();
+}
+
+void DrawList::draw_text_run(const FontImplementation& font, float x, float y, Color col,
+                             const TextRunImplementation& run) {
+    Command& c = add(Op::TextRun, col, {x, y});
+    c.i[0] = mruns.size();
+    c.res = &font;
+    mruns.push_back(run);
+}
+
+void DrawList::draw_text_run_clipped_to_rect(const FontImplementation& font, float x, float y, Color col,
+                                             const Rect& clip_rect, const TextRunImplementation& run) {
+    draw_text_run(font, x, y, col, run);
+    Command& c = mcommands.back();
+    c.op = Op::TextRunClipped;
+    c.i[1] = clip_rect.x();
+    c.i[2] = clip_rect.y();
+    c.i[3] = clip_rect.w();
+    c.i[4] = clip_rect.h();
+}
+
+void DrawList::replay(Graphics& gfx, float opacity) const {
+    ASSERT(mopen_areas.empty());
+    int issued = 0;
+    for (size_t idx = 0; idx < mcommands.size(); idx++) {
+        const Command& c = mcommands[idx];
+        Color col1 = mult_opacity(c.col1, opacity);
+        issued++;
+        switch (c.op) {
+            case Op::PushArea: {
+                Rect r(c.i[0], c.i[1], c.i[2], c.i[3]);
+                const Transform* t = c.i[4] >= 0 ? &mtransforms[c.i[4]] : nullptr;
+                // Anything may be drawn outside of areas without cull bounds.
+                bool visible = true;
+                if (c.f[2] >= 0) {
+                    Rect bounds(int(c.f[0]), int(c.f[1]), int(c.f[2]), int(c.f[3]));
+                    visible = t ? gfx.is_area_visible(Rect(r.pos(), bounds.size()), *t) :
+                              gfx.is_area_visible(bounds.translated(r.pos()));
+                }
+                if (!visible) {
+                    gfx._increment_culled_count();
+                    idx = c.i[5]; // continue after the matching PopArea
+                    break;
+                }
+                if (t)
+                    gfx.push_draw_area(r, *t, c.clip);
+                else
+                    gfx.push_draw_area(r, c.clip);
+                break;
+            }
+            case Op::PopArea:
+                gfx.pop_draw_area();
+                break;
+            case Op::Clear:
+                gfx.clear(col1);
+                break;
+            case Op::FillDrawArea:
+                gfx.fill_draw_area(col1);
+                break;
+            case Op::Rect:
+                gfx.rect(c.f[0], c.f[1], c.f[2], c.f[3], col1, c.f[4]);
+                break;
+            case Op::FilledRect:
+                gfx.filled_rect(c.f[0], c.f[1], c.f[2], c.f[3], col1);
+                break;
+            case Op::FilledTriangle:
+                gfx.filled_triangle(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1);
+                break;
+            case Op::RoundedRect:
+                gfx.rounded_rect(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1, c.f[6]);
+                break;
+            case Op::FilledRoundedRect:
+                gfx.filled_rounded_rect(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1);
+                break;
+            case Op::FilledRoundedRectGradient:
+                gfx.filled_rounded_rect_gradient(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1,
+                                                 mult_opacity(c.col2, opacity), GradientDirection(c.i[0]));
+                break;
+            case Op::FilledRectGradient:
+                gfx.filled_rect_gradient(c.f[0], c.f[1], c.f[2], c.f[3], col1, mult_opacity(c.col2, opacity),
+                                         GradientDirection(c.i[0]));
+                break;
+            case Op::RoundedRectSpecCorners:
+                gfx.rounded_rect_spec_corners(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1, c.f[6],
+                                              c.i[0]);
+                break;
+            case Op::FilledRoundedRectSpecCorners:
+                gfx.filled_rounded_rect_spec_corners(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1,
+                                                     c.i[0]);
+                break;
+            case Op::RoundedRectBracket:
+                gfx.rounded_rect_bracket(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1, c.f[6],
+                                         OpenEdge(c.i[0]));
+                break;
+            case Op::RectBracket:
+                gfx.rect_bracket(c.f[0], c.f[1], c.f[2], c.f[3], col1, c.f[4], OpenEdge(c.i[0]));
+                break;
+            case Op::FilledRoundedRectBracket:
+                gfx.filled_rounded_rect_bracket(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1,
+                                                OpenEdge(c.i[0]));
+                break;
+            case Op::FilledRoundedRectBracketGradient:
+                gfx.filled_rounded_rect_bracket_gradient(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], c.f[5], col1,
+                                                         mult_opacity(c.col2, opacity), OpenEdge(c.i[0]),
+                                                         GradientDirection(c.i[1]));
+                break;
+            case Op::Circle:
+                gfx.circle(c.f[0], c.f[1], c.f[2], col1, c.f[3]);
+                break;
+            case Op::FilledCircle:
+                gfx.filled_circle(c.f[0], c.f[1], c.f[2], col1);
+                break;
+            case Op::Line:
+                gfx.line(c.f[0], c.f[1], c.f[2], c.f[3], col1, c.f[4]);
+                break;
+            case Op::VisiblePixel:
+                gfx.draw_visible_pixel(c.f[0], c.f[1], col1);
+                break;
+            case Op::FilledPieslice:
+                gfx.draw_filled_pieslice(c.f[0], c.f[1], c.f[2], c.f[3], c.f[4], col1);
+                break;
+            case Op::Vertices: {
+                const PrimVertex* first = &mvertices[c.i[1]];
+                if (opacity != 1.0f) {
+                    mscratch_vertices.assign(first, first + c.i[2]);
+                    for (PrimVertex& v : mscratch_vertices)
+                        v.color = mult_opacity(v.color, opacity);
+                    first = mscratch_vertices.data();
+                }
+                gfx.draw_vertices(PrimType(c.i[0]), first, 0, c.i[2]);
+                break;
+            }
+            case Op::NinePatch:
+                gfx.draw_ninepatch_tinted(*static_cast<const NinePatch*>(c.res), col1, int(c.f[0]), int(c.f[1]),
+                                          Size(c.i[0], c.i[1]));
+                break;
+            case Op::BitmapRegion:
+                gfx.draw_tinted_bmp_region(*static_cast<const Bitmap*>(c.res), int(c.f[0]), int(c.f[1]),
+                                           c.i[0], c.i[1], c.i[2], c.i[3], col1, c.i[4]);
+                break;
+            case Op::ScaledBitmap:
+                gfx.draw_tinted_scaled_bmp(*static_cast<const Bitmap*>(c.res), int(c.f[0]), int(c.f[1]),
+                                           c.i[0], c.i[1], col1, c.i[2]);
+                break;
+            case Op::BitmapRegionRoundedCorners:
+                gfx.draw_tinted_bmp_region_rounded_corners(*static_cast<const Bitmap*>(c.res), c.f[0], c.f[1],
+                                                           c.f[2], c.f[3], c.f[4], c.f[5], c.f[6], c.f[7], col1);
+                break;
+            case Op::Text:
+                gfx.draw_text(*static_cast<const FontImplementation*>(c.res), c.f[0], c.f[1], col1,
+                              mtexts[c.i[0]]);
+                break;
+            case Op::TextRight:
+                gfx.draw_textr(*static_cast<const FontImplementation*>(c.res), c.f[0], c.f[1], col1,
+                               mtexts[c.i[0]]);
+                break;
+            case Op::TextCenter:
+                gfx.draw_textc(*static_cast<const FontImplementation*>(c.res), c.f[0], c.f[1], col1,
+                               mtexts[c.i[0]]);
+                break;
+            case Op::TextClipped:
+                gfx.draw_text_clipped_to_rect(*static_cast<const FontImplementation*>(c.res), c.f[0], c.f[1],
+                                              col1, Rect(c.i[1], c.i[2], c.i[3], c.i[4]), mtexts[c.i[0]]);
+                break;
+            case Op::TextRun:
+                gfx.draw_text_run(*static_cast<const FontImplementation*>(c.res), c.f[0], c.f[1], col1,
+                                  mruns[c.i[0]]);
+                break;
+            case Op::TextRunClipped:
+                gfx.draw_text_run_clipped_to_rect(*static_cast<const FontImplementation*>(c.res), c.f[0],
+                                                  c.f[1], col1, Rect(c.i[1], c.i[2], c.i[3], c.i[4]),
+                                                  mruns[c.i[0]]);
+                break;
+        }
+    }
+    LGUI_PROFILE_COUNT(DrawListCommands, issued);
+}
+
+}
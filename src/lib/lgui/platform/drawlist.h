@@ -0,0 +1,167 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_DRAWLIST_H
+#define LGUI_DRAWLIST_H
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "primhelper.h"
+#include "font.h"
+#include "textrun.h"
+#include "transform.h"
+
+namespace lgui {
+
+class Graphics;
+class Bitmap;
+class NinePatch;
+
+/** A list of drawing commands recorded from a Graphics object, see Graphics::begin_recording(). The
+ *  commands are given relative to the origin of the draw area that was active when recording began and
+ *  include the draw areas pushed in between. Replaying the list into a Graphics object issues the same
+ *  calls again, without running the code that produced them, so it can be done at a different position,
+ *  with a different transformation or with a different opacity.
+ *
+ *  Bitmaps, fonts and nine-patches are referenced, not copied: they have to stay alive as long as the list
+ *  is replayed. Texts and text runs are copied. */
+class DrawList {
+        friend class Graphics;
+
+    public:
+        DrawList() = default;
+
+        /** Remove all commands. The storage is kept for recording again. */
+        void clear();
+
+        bool empty() const { return mcommands.empty(); }
+        /** Return the number of commands recorded. */
+        int no_commands() const { return mcommands.size(); }
+
+        /** Issue all commands to `gfx`, with all colors multiplied by `opacity`. Draw areas that aren't
+         *  visible are culled, skipping all commands issued within them. */
+        void replay(Graphics& gfx, float opacity = 1.0) const;
+
+    private:
+        enum class Op : unsigned char {
+            PushArea, PopArea,
+            Clear, FillDrawArea,
+            Rect, FilledRect, FilledTriangle,
+            RoundedRect, FilledRoundedRect, FilledRoundedRectGradient, FilledRectGradient,
+            RoundedRectSpecCorners, FilledRoundedRectSpecCorners,
+            RoundedRectBracket, RectBracket, FilledRoundedRectBracket, FilledRoundedRectBracketGradient,
+            Circle, FilledCircle, Line, VisiblePixel, FilledPieslice, Vertices,
+            NinePatch, BitmapRegion, ScaledBitmap, BitmapRegionRoundedCorners,
+            Text, TextRight, TextCenter, TextClipped, TextRun, TextRunClipped
+        };
+
+        struct Command {
+            Op op;
+            bool clip;      // PushArea only
+            int i[6];       // integer arguments: enums, flags, sizes and indices into the pools
+            float f[8];     // coordinates; for PushArea, f[0] to f[3] are the cull bounds, if any
+            Color col1, col2;
+            const void* res; // bitmap, nine-patch or font
+        };
+
+        // Recording, called by Graphics:
+        void push_area(int offsx, int offsy, int w, int h, const Transform* transform, bool clip,
+                       const Rect* cull_bounds);
+        void pop_area();
+        void clear_to_color(Color col);
+        void fill_draw_area(Color col);
+        void rect(float x1, float y1, float x2, float y2, Color col, float thickness);
+        void filled_rect(float x1, float y1, float x2, float y2, Color col);
+        void filled_triangle(float x1, float y1, float x2, float y2, float x3, float y3, Color col);
+        void rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, Color col, float thickness);
+        void filled_rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, Color col);
+        void filled_rounded_rect_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                          const Color& col1, const Color& col2, GradientDirection dir);
+        void filled_rect_gradient(float x1, float y1, float x2, float y2, const Color& col1, const Color& col2,
+                                  GradientDirection dir);
+        void rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry, Color col,
+                                       float thickness, int corners);
+        void filled_rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
+                                              Color col, int corners);
+        void rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry, Color col,
+                                  float thickness, OpenEdge oe);
+        void rect_bracket(float x1, float y1, float x2, float y2, Color col, float thickness, OpenEdge oe);
+        void filled_rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry,
+                                         Color col, OpenEdge oe);
+        void filled_rounded_rect_bracket_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                  const Color& col1, const Color& col2, OpenEdge oe,
+                                                  GradientDirection dir);
+        void circle(float cx, float cy, float r, Color col, float thickness);
+        void filled_circle(float cx, float cy, float r, Color col);
+        void line(float x1, float y1, float x2, float y2, Color col, float thickness);
+        void draw_visible_pixel(float px, float py, Color col);
+        void draw_filled_pieslice(float cx, float cy, float r, float start_theta, float delta_theta, Color col);
+        void draw_vertices(PrimType type, const PrimVertex* first, unsigned int start, unsigned int end);
+        void draw_vertices_indexed(PrimType type, const std::vector<PrimVertex>& verts,
+                                   const std::vector<int>& indices, unsigned int n);
+        void draw_ninepatch_tinted(const NinePatch& np, const Color& col, int dx, int dy, const Size& content_size);
+        void draw_tinted_bmp_region(const Bitmap& bitmap, int dx, int dy, int sx, int sy, int sw, int sh,
+                                    Color col, int flip);
+        void draw_tinted_scaled_bmp(const Bitmap& bitmap, int dx, int dy, int dw, int dh, Color col, int flip);
+        void draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, float dx, float dy, float sx, float sy,
+                                                    float sw, float sh, float crx, float cry, Color col);
+        void draw_text(Op op, const FontImplementation& font, float x, float y, Color col, const std::string& text);
+        void draw_text_clipped_to_rect(const FontImplementation& font, float x, float y, Color col,
+                                       const Rect& clip_rect, const std::string& text);
+        void draw_text_run(const FontImplementation& font, float x, float y, Color col,
+                           const TextRunImplementation& run);
+        void draw_text_run_clipped_to_rect(const FontImplementation& font, float x, float y, Color col,
+                                           const Rect& clip_rect, const TextRunImplementation& run);
+
+        Command& add(Op op, const Color& col1, std::initializer_list<float> f);
+
+        std::vector<Command> mcommands;
+        // Pools for the arguments that don't fit into a Command.
+        std::vector<PrimVertex> mvertices;
+        std::vector<Transform> mtransforms;
+        std::vector<std::string> mtexts;
+        std::vector<TextRunImplementation> mruns;
+        std::vector<int> mopen_areas; // indices of the PushArea commands not popped yet
+        mutable std::vector<PrimVertex> mscratch_vertices;
+};
+
+}
+
+#endif // LGUI_DRAWLIST_H
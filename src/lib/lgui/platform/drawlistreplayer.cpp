@@ -0,0 +1,75 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "drawlistreplayer.h"
+
+namespace lgui {
+namespace dtl {
+
+static std::mutex replayers_mutex;
+static std::vector<DrawListReplayer*> replayers;
+static std::atomic<int> no_replayers(0);
+
+void add_draw_list_replayer(DrawListReplayer& replayer) {
+    std::lock_guard<std::mutex> lock(replayers_mutex);
+    replayers.push_back(&replayer);
+    no_replayers = replayers.size();
+}
+
+void remove_draw_list_replayer(DrawListReplayer& replayer) {
+    std::lock_guard<std::mutex> lock(replayers_mutex);
+    replayers.erase(std::remove(replayers.begin(), replayers.end(), &replayer), replayers.end());
+    no_replayers = replayers.size();
+}
+
+void wait_for_draw_list_replayers() {
+    if (no_replayers == 0)
+        return;
+    std::lock_guard<std::mutex> lock(replayers_mutex);
+    for (DrawListReplayer* r : replayers)
+        r->wait_until_replayed();
+}
+
+}
+}
@@ -0,0 +1,70 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_DRAWLISTREPLAYER_H
+#define LGUI_DRAWLISTREPLAYER_H
+
+namespace lgui {
+namespace dtl {
+
+/** Something replaying DrawList objects on a thread of its own (see RenderThread). Draw lists reference
+ *  bitmaps, fonts and nine-patches by pointer, so these must not go away while a list referencing them may
+ *  still be replayed. */
+class DrawListReplayer {
+    public:
+        /** Block until nothing handed over to the replaying thread is left to be replayed. Must return
+         *  immediately if called on the replaying thread itself. */
+        virtual void wait_until_replayed() = 0;
+
+    protected:
+        ~DrawListReplayer() = default;
+};
+
+/** Register a replayer, so that wait_for_draw_list_replayers() will wait for it. */
+void add_draw_list_replayer(DrawListReplayer& replayer);
+void remove_draw_list_replayer(DrawListReplayer& replayer);
+
+/** Wait for all registered replayers. Called by the destructors and move constructors of Bitmap, Font and
+ *  NinePatch; doesn't lock anything if there are no replayers. */
+void wait_for_draw_list_replayers();
+
+}
+}
+
+#endif // LGUI_DRAWLISTREPLAYER_H
@@ -40,7 +40,11 @@
 #ifndef LGUI_ERROR_H
 #define LGUI_ERROR_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlerror.h"
+#else
 #include "a5/a5error.h"
+#endif
 
 namespace lgui {
 
@@ -86,6 +86,10 @@ struct ExternalEvent {
 
 }
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlevents.h"
+#else
 #include "a5/a5events.h"
+#endif
 
 #endif // LGUI_EVENTS_H
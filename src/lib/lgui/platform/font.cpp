@@ -95,30 +95,66 @@ std::pair<size_t, size_t> Font::hit_char(const std::string& str, int px) const {
 }
 
 
+size_t Font::fitting_prefix(const std::string& str, size_t offs, size_t n, int max_width, int* out_width) const {
+    if (offs >= str.size())
+        n = 0;
+    else if (n > str.size() - offs) // will catch npos
+        n = str.size() - offs;
+    const size_t end = offs + n;
+
+    size_t fit = offs, pos = offs;
+    int w = 0;
+    int32_t cp = (pos < end) ? utf8::get_cp_next(str, pos) : -1;
+    while (cp >= 0) {
+        size_t cp_end = pos;
+        if (cp_end > end)
+            break;
+        int32_t next_cp = (pos < end) ? utf8::get_cp_next(str, pos) : -1;
+        int nw = w + glyph_advance(cp, next_cp);
+        if (nw > max_width)
+            break;
+        w = nw;
+        fit = cp_end;
+        cp = next_cp;
+    }
+    if (out_width)
+        *out_width = w;
+    return fit - offs;
+}
+
+int Font::do_wordwrap(const std::string& text, int max_width, std::vector<std::string>& out_lines) const {
+    std::vector<TextSpan> spans;
+    int widest = do_wordwrap(text, max_width, spans);
+    out_lines.reserve(out_lines.size() + spans.size());
+    for (const TextSpan& span : spans)
+        out_lines.emplace_back(text, span.offs, span.size);
+    return widest;
+}
+
 // helper for WordWrap
 struct LineAdder {
-    LineAdder(const Font& font, std::vector<std::string>& out_lines)
-            : mfont(font), mout_lines(out_lines),
+    LineAdder(const std::string& text, std::vector<TextSpan>& out_lines)
+            : mtext(text), mout_lines(out_lines),
               mwidest_line(0) {}
 
-    void add(const std::string& text, size_t offs, size_t size) {
-        std::string line = text.substr(offs, size);
-        mout_lines.emplace_back(line);
-        int w = mfont.text_width(mout_lines.back());
-        mwidest_line = std::max(mwidest_line, w);
+    void add(size_t offs, size_t size, int width) {
+        if (size > mtext.size() - offs) // will catch npos
+            size = mtext.size() - offs;
+        mout_lines.emplace_back(TextSpan{offs, size, width});
+        mwidest_line = std::max(mwidest_line, width);
     }
 
     int widest_line() const { return mwidest_line; }
 
-    const Font& mfont;
-    std::vector<std::string>& mout_lines;
+    const std::string& mtext;
+    std::vector<TextSpan>& mout_lines;
     int mwidest_line;
 };
 
-int Font::do_wordwrap(const std::string& text, int max_width, std::vector<std::string>& out_lines) const {
+int Font::do_wordwrap(const std::string& text, int max_width, std::vector<TextSpan>& out_lines) const {
     const char* whitespace = " \t\r\n";
 
-    LineAdder la(*this, out_lines);
+    LineAdder la(text, out_lines);
 
     if (text.empty() || max_width <= 0)
         return 0;
@@ -130,10 +166,18 @@ int Font::do_wordwrap(const std::string& text, int max_width, std::vector<std::s
     size_t line_start = 0, last_word = 0,
             next_word = text.find_first_of(whitespace);
     int line_width = 0;
+    // The width of the rest of a word that has been split, carried forward instead of measuring the rest
+    // again after each split, which would be quadratic in the length of the word.
+    size_t rest_start = npos;
+    int rest_width = 0;
 
     while (!finished) {
-        int word_width = text_width(text, last_word,
-                                    (next_word != npos) ? next_word - last_word : npos);
+        int word_width;
+        // Only use the carried width while the rest is clearly too wide: its last line is measured exactly.
+        if (last_word == rest_start && rest_width > 2 * max_width)
+            word_width = rest_width;
+        else
+            word_width = text_width(text, last_word, (next_word != npos) ? next_word - last_word : npos);
         if (line_width + word_width > max_width) {
             // Line would be too long with this word.
             bool split_word = word_width > max_width;
@@ -144,30 +188,32 @@ int Font::do_wordwrap(const std::string& text, int max_width, std::vector<std::s
                     word_size = next_word - last_word;
                 else
                     word_size = text.size() - last_word;
-                unsigned int split_idx = 1;
-                for (; split_idx < word_size; split_idx++) {
-                    int part_word_w = text_width(text, last_word, split_idx);
-                    if (part_word_w + line_width > max_width) {
-                        break;
-                    }
-                }
-                split_idx--;
+                int part_word_w;
+                // Never split after the last character, the word is too wide anyway.
+                size_t split_idx = fitting_prefix(text, last_word, word_size - 1, max_width - line_width,
+                                                  &part_word_w);
 
                 // In case even one character won't fit:
                 // Force emitting at least one character to avoid endless loop
-                if (split_idx == 0 && line_start == last_word)
-                    split_idx++;
+                if (split_idx == 0 && line_start == last_word) {
+                    size_t pos = last_word;
+                    utf8::next_cp(text, pos);
+                    split_idx = pos - last_word;
+                    part_word_w = text_width(text, last_word, split_idx);
+                }
 
                 // Avoid trailing spaces that destroy our max width when split_idx == 0
                 // (this is different from TextBox::make_rows).
-                la.add(text, line_start,
-                       last_word + split_idx - line_start - ((split_idx == 0) ? 1 : 0));
+                la.add(line_start, last_word + split_idx - line_start - ((split_idx == 0) ? 1 : 0),
+                       (split_idx == 0) ? line_width - space_width : line_width + part_word_w);
                 last_word = last_word + split_idx;
+                rest_start = last_word;
+                rest_width = word_width - part_word_w;
             }
             else {
                 if (line_start < last_word) {
                     // Emit start of line until current word
-                    la.add(text, line_start, last_word - line_start - 1);
+                    la.add(line_start, last_word - line_start - 1, line_width - space_width);
                 }
             }
             line_start = last_word;
@@ -175,14 +221,14 @@ int Font::do_wordwrap(const std::string& text, int max_width, std::vector<std::s
         }
         else if (next_word != npos && text[next_word] == '\n') {
             // New line: make new line in any case.
-            la.add(text, line_start, next_word - line_start);
+            la.add(line_start, next_word - line_start, line_width + word_width);
             last_word = line_start = next_word + 1;
             line_width = 0;
             next_word = text.find_first_of(whitespace, next_word + 1);
         }
         else if (next_word == npos) {
             // Finished: add last line
-            la.add(text, line_start, next_word); // Will clip npos
+            la.add(line_start, next_word, line_width + word_width); // Will clip npos
             finished = true;
         }
         else {
@@ -40,15 +40,32 @@
 #ifndef LGUI_FONT_H
 #define LGUI_FONT_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlfont.h"
+
+namespace lgui {
+using FontImplementation = HLFont;
+}
+#else
 #include "a5/a5font.h"
 
 namespace lgui {
 using FontImplementation = A5Font;
 }
+#endif
+
+#include "drawlistreplayer.h"
 
 namespace lgui {
 
-/** Class representing a font resource. */
+/** A line of text produced by word wrapping, given as a span of the source text. */
+struct TextSpan {
+    size_t offs, size; ///< in bytes
+    int width;
+};
+
+/** Class representing a font resource. Destroying a font waits until no draw list that may reference it is
+ *  replayed on another thread anymore (see RenderThread). */
 class Font : public FontImplementation {
     public:
         /** Load a font resource from disk. */
@@ -59,6 +76,8 @@ class Font : public FontImplementation {
         Font(Font&& other)
                 : FontImplementation(std::forward<Font>(other)) {}
 
+        ~Font() { dtl::wait_for_draw_list_replayers(); }
+
         /** Breaks a UTF8-string into lines at word boundaries. Words that do not fit
          *  on a single line are split at any location.
          *  @param text the text to process
@@ -73,6 +92,17 @@ class Font : public FontImplementation {
          */
         int do_wordwrap(const std::string& text, int max_width, std::vector<std::string>& out_lines) const;
 
+        /** Same as above, but output the lines as spans of `text`, along with their widths. */
+        int do_wordwrap(const std::string& text, int max_width, std::vector<TextSpan>& out_lines) const;
+
+        /** Return how many bytes of the substring starting at offs, n bytes long, fit into max_width.
+         *  Only whole code points are counted. Walks the glyph advances once, so this is linear in the length
+         *  of the fitting part, as opposed to measuring every prefix.
+         *  @param out_width if not nullptr, the width of the fitting part is stored here
+         */
+        size_t fitting_prefix(const std::string& str, size_t offs, size_t n, int max_width,
+                              int* out_width = nullptr) const;
+
         /** Return offset (first) and codepoint index (second) of the character
          *  hit by a point with x-coordinate px.
          *  There is no failure, the return value will always be between
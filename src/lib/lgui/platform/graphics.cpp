@@ -38,25 +38,57 @@
 */
 
 #include "graphics.h"
+#include "drawlist.h"
+#include "bitmap.h"
 #include "error.h"
 
 namespace lgui {
 
 Graphics::Graphics()
-        : mclip(false) {
+        : mclip(false), mtransformed(false), mculled_count(0), mrecording(nullptr), mrecording_culled(false),
+          mrecord_only(false) {
     mtransform.set_identity();
+    reserve_stacks();
+    set_prim_helper(&mprim_helper);
+}
+
+Graphics::Graphics(RecordOnly, const Size& size)
+        : GraphicsImplementation(size.w(), size.h()), mclip(false), mtransformed(false), mculled_count(0),
+          mrecording(nullptr), mrecording_culled(false), mrecord_only(true) {
+    mtransform.set_identity();
+    reserve_stacks();
+    set_prim_helper(&mprim_helper);
+}
+
+void Graphics::reserve_stacks() {
+    mdraw_areas.reserve(DRAW_AREA_STACK_CAPACITY);
+    mclip_rects.reserve(DRAW_AREA_STACK_CAPACITY);
+    mtransforms.reserve(TRANSFORM_STACK_CAPACITY);
+    mlayers.reserve(LAYER_STACK_CAPACITY);
+    mculled_areas.reserve(DRAW_AREA_STACK_CAPACITY);
 }
 
 void Graphics::push_draw_area(const lgui::Rect& r, bool clip) {
-    push_draw_area(r.x(), r.y(), r.w(), r.h(), clip);
+    Rect bounds(Point(), r.size());
+    push_untransformed_area(r, clip, clip ? &bounds : nullptr);
+}
+
+void Graphics::push_draw_area(int offsx, int offsy, int w, int h, bool clip) {
+    push_draw_area(Rect(offsx, offsy, w, h), clip);
+}
+
+void Graphics::push_draw_area(const Rect& r, bool clip, const Rect& cull_bounds) {
+    push_untransformed_area(r, clip, &cull_bounds);
 }
 
 void Graphics::push_draw_area(const Rect& r, const Transform& transform, bool clip) {
     push_draw_area(r.x(), r.y(), r.w(), r.h(), transform, clip);
 }
 
-void Graphics::push_draw_area(int offsx, int offsy, int w, int h, bool clip) {
-    mdraw_areas.push(DrawAreaStackEntry{mtransform, lgui::Rect(moffsx, moffsy, mw, mh), mclip});
+void Graphics::push_area_entry(int offsx, int offsy, int w, int h, bool clip) {
+    mdraw_areas.push_back(DrawAreaStackEntry{lgui::Rect(moffsx, moffsy, mw, mh), mclip, mtransformed});
+    if (mtransformed)
+        mtransforms.push_back(mtransform);
     if (clip) {
         update_clip_rect(offsx, offsy, w, h);
     }
@@ -65,51 +97,207 @@ void Graphics::push_draw_area(int offsx, int offsy, int w, int h, bool clip) {
     mw = w;
     mh = h;
     mclip = clip;
+}
 
-    mtransform.translate_pre(PointF(offsx, offsy));
-    use_transform(mtransform);
+void Graphics::push_untransformed_area(const Rect& r, bool clip, const Rect* cull_bounds) {
+    int offsx = r.x(), offsy = r.y(), w = r.w(), h = r.h();
+    if (mrecording) {
+        mrecording->push_area(offsx, offsy, w, h, nullptr, clip, cull_bounds);
+        if (is_culling_recording()) {
+            const CulledAreaEntry& top = mculled_areas.back();
+            mculled_areas.push_back(CulledAreaEntry{top.offs + Point(offsx, offsy), top.exact});
+        }
+        return;
+    }
+    push_area_entry(offsx, offsy, w, h, clip);
+    if (mtransformed) {
+        mtransform.translate_pre(PointF(offsx, offsy));
+        set_transform_deferred(mtransform);
+    }
+    else
+        set_translation_deferred(moffsx, moffsy);
 }
 
 void Graphics::push_draw_area(int offsx, int offsy, int w, int h, const Transform& transform, bool clip) {
-    mdraw_areas.push(DrawAreaStackEntry{mtransform, lgui::Rect(moffsx, moffsy, mw, mh), mclip});
-    if (clip) {
-        update_clip_rect(offsx, offsy, w, h);
+    if (mrecording) {
+        Rect bounds(0, 0, w, h);
+        mrecording->push_area(offsx, offsy, w, h, &transform, clip, clip ? &bounds : nullptr);
+        if (is_culling_recording())
+            mculled_areas.push_back(CulledAreaEntry{Point(), false});
+        return;
     }
-    moffsx += offsx;
-    moffsy += offsy;
-    mw = w;
-    mh = h;
-    mclip = clip;
+    if (!mtransformed) {
+        // Materialize the offset so far.
+        mtransform.set_identity();
+        mtransform.translate_post(PointF(moffsx, moffsy));
+    }
+    push_area_entry(offsx, offsy, w, h, clip);
+    mtransformed = true;
 
     Transform t(transform);
     t.translate_post(PointF(offsx, offsy));
     mtransform.compose_pre(t);
-    use_transform(mtransform);
+    set_transform_deferred(mtransform);
 }
 
 void Graphics::pop_draw_area() {
+    if (mrecording) {
+        mrecording->pop_area();
+        if (is_culling_recording())
+            mculled_areas.pop_back();
+        return;
+    }
     ASSERT(!mdraw_areas.empty());
-    const auto& last = mdraw_areas.top();
+    ASSERT(mlayers.empty() || mdraw_areas.size() > mlayers.back().draw_areas_base);
+    const auto& last = mdraw_areas.back();
     if (mclip) {
         ASSERT(!mclip_rects.empty());
-        const auto& lcr = mclip_rects.top();
+        const auto& lcr = mclip_rects.back();
         set_clip_rect(lcr.x(), lcr.y(), lcr.w(), lcr.h());
-        mclip_rects.pop();
+        mclip_rects.pop_back();
     }
-    mtransform = last.transform;
-    use_transform(mtransform);
     moffsx = last.rect.x();
     moffsy = last.rect.y();
     mw = last.rect.w();
     mh = last.rect.h();
     mclip = last.is_clipped;
-    mdraw_areas.pop();
+    mtransformed = last.was_transformed;
+    if (mtransformed) {
+        ASSERT(!mtransforms.empty());
+        mtransform = mtransforms.back();
+        mtransforms.pop_back();
+        set_transform_deferred(mtransform);
+    }
+    else
+        set_translation_deferred(moffsx, moffsy);
+    mdraw_areas.pop_back();
+}
+
+void Graphics::use_current_transform() {
+    if (!mtransformed) {
+        mtransform.set_identity();
+        mtransform.translate_post(PointF(moffsx, moffsy));
+    }
+    use_transform(mtransform);
+}
+
+void Graphics::begin_layer(Bitmap& bmp) {
+    ASSERT(!mrecord_only);
+    if (mtransformed)
+        mtransforms.push_back(mtransform);
+    mlayers.push_back(LayerStackEntry{mdraw_areas.size(), mclip_rects.size(), mtransforms.size(),
+                                      Rect(moffsx, moffsy, mw, mh), mclip, mtransformed, mrecording});
+    mrecording = nullptr;
+
+    push_target(bmp);
+    moffsx = moffsy = 0;
+    mw = bmp.w();
+    mh = bmp.h();
+    mclip = false;
+    mtransformed = false;
+    use_current_transform();
+    set_clip_rect(0, 0, mw, mh);
+}
+
+void Graphics::end_layer() {
+    ASSERT(!mlayers.empty());
+    const LayerStackEntry& e = mlayers.back();
+    ASSERT(mdraw_areas.size() == e.draw_areas_base);
+    ASSERT(mclip_rects.size() == e.clip_rects_base);
+    ASSERT(mtransforms.size() == e.transforms_base);
+    pop_target();
+    moffsx = e.rect.x();
+    moffsy = e.rect.y();
+    mw = e.rect.w();
+    mh = e.rect.h();
+    mclip = e.is_clipped;
+    mtransformed = e.is_transformed;
+    if (mtransformed) {
+        mtransform = mtransforms.back();
+        mtransforms.pop_back();
+    }
+    mrecording = e.recording;
+    mlayers.pop_back();
+    // The clipping rectangle is restored along with the target.
+    use_current_transform();
+}
+
+bool Graphics::is_area_visible(const Rect& r) {
+    if (mrecording) {
+        if (!is_culling_recording() || !mculled_areas.back().exact)
+            return true;
+        Rect area = r.translated(mculled_areas.back().offs);
+        return is_recorded_area_visible(area.x(), area.y(), area.x() + area.w(), area.y() + area.h());
+    }
+    if (mtransformed)
+        return is_area_visible(r, Transform::get_identity());
+    float x = moffsx + r.x(), y = moffsy + r.y();
+    return is_screen_area_visible(x, y, x + r.w(), y + r.h());
+}
+
+bool Graphics::is_area_visible(const Rect& r, const Transform& transform) {
+    bool recorded = mrecording != nullptr;
+    if (recorded && (!is_culling_recording() || !mculled_areas.back().exact))
+        return true;
+    PointF corners[4] = {PointF(0, 0), PointF(r.w(), 0), PointF(0, r.h()), PointF(r.w(), r.h())};
+    float x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    PointF offs = recorded ? PointF(mculled_areas.back().offs) : PointF(moffsx, moffsy);
+    for (int i = 0; i < 4; i++) {
+        PointF p = transform.map(corners[i]) + PointF(r.pos());
+        p = mtransformed && !recorded ? mtransform.map(p) : p + offs;
+        if (i == 0 || p.x() < x1)
+            x1 = p.x();
+        if (i == 0 || p.y() < y1)
+            y1 = p.y();
+        if (i == 0 || p.x() > x2)
+            x2 = p.x();
+        if (i == 0 || p.y() > y2)
+            y2 = p.y();
+    }
+    return recorded ? is_recorded_area_visible(x1, y1, x2, y2) : is_screen_area_visible(x1, y1, x2, y2);
+}
+
+bool Graphics::is_recorded_area_visible(float x1, float y1, float x2, float y2) const {
+    const Rect& c = mrecording_cull_rect;
+    return x2 >= c.x() && y2 >= c.y() && x1 < c.x() + c.w() && y1 < c.y() + c.h();
+}
+
+bool Graphics::is_screen_area_visible(float x1, float y1, float x2, float y2) {
+    int cx, cy, cw, ch;
+    get_clip_rect(cx, cy, cw, ch);
+    return x2 >= cx && y2 >= cy && x1 < cx + cw && y1 < cy + ch;
+}
+
+void Graphics::begin_recording(DrawList& list) {
+    ASSERT(&list != mrecording);
+    msuspended_recordings.push_back(mrecording);
+    list.clear();
+    mrecording = &list;
+}
+
+void Graphics::begin_recording(DrawList& list, const Rect& cull_rect) {
+    ASSERT(!mrecording && msuspended_recordings.empty());
+    begin_recording(list);
+    mrecording_culled = true;
+    mrecording_cull_rect = cull_rect;
+    mculled_areas.push_back(CulledAreaEntry{Point(), true});
+}
+
+void Graphics::end_recording() {
+    ASSERT(mrecording && !msuspended_recordings.empty());
+    ASSERT(mrecording->mopen_areas.empty());
+    if (msuspended_recordings.size() == 1 && mrecording_culled) {
+        mculled_areas.clear();
+        mrecording_culled = false;
+    }
+    mrecording = msuspended_recordings.back();
+    msuspended_recordings.pop_back();
 }
 
 void Graphics::update_clip_rect(int offsx, int offsy, int& w, int& h) {
     int cx, cy, cw, ch;
     get_clip_rect(cx, cy, cw, ch);
-    mclip_rects.push(Rect(cx, cy, cw, ch));
+    mclip_rects.push_back(Rect(cx, cy, cw, ch));
     int ncx = moffsx + offsx;
     int ncy = moffsy + offsy;
 
@@ -135,275 +323,415 @@ void Graphics::update_clip_rect(int offsx, int offsy, int& w, int& h) {
     set_clip_rect(ncx, ncy, w, h);
 }
 
+void Graphics::clear(Color col) {
+    if (mrecording)
+        mrecording->clear_to_color(col);
+    else
+        GraphicsImplementation::clear(col);
+}
+
+void Graphics::draw_bmp(const Bitmap& bitmap, int dx, int dy, int flip) {
+    if (mrecording)
+        mrecording->draw_tinted_bmp_region(bitmap, dx, dy, 0, 0, bitmap.w(), bitmap.h(), rgb(1.0, 1.0, 1.0), flip);
+    else
+        GraphicsImplementation::draw_bmp(bitmap, dx, dy, flip);
+}
+
+void Graphics::draw_tinted_bmp(const Bitmap& bitmap, int dx, int dy, Color col, int flip) {
+    if (mrecording)
+        mrecording->draw_tinted_bmp_region(bitmap, dx, dy, 0, 0, bitmap.w(), bitmap.h(), col, flip);
+    else
+        GraphicsImplementation::draw_tinted_bmp(bitmap, dx, dy, col, flip);
+}
+
+void Graphics::draw_bmp_region(const Bitmap& bitmap, int dx, int dy, int sx, int sy, int sw, int sh, int flip) {
+    if (mrecording)
+        mrecording->draw_tinted_bmp_region(bitmap, dx, dy, sx, sy, sw, sh, rgb(1.0, 1.0, 1.0), flip);
+    else
+        GraphicsImplementation::draw_bmp_region(bitmap, dx, dy, sx, sy, sw, sh, flip);
+}
+
+void Graphics::draw_tinted_bmp_region(const Bitmap& bitmap, int dx, int dy, int sx, int sy, int sw, int sh,
+                                      Color col, int flip) {
+    if (mrecording)
+        mrecording->draw_tinted_bmp_region(bitmap, dx, dy, sx, sy, sw, sh, col, flip);
+    else
+        GraphicsImplementation::draw_tinted_bmp_region(bitmap, dx, dy, sx, sy, sw, sh, col, flip);
+}
+
+void Graphics::draw_scaled_bmp(const Bitmap& bitmap, int dx, int dy, int dw, int dh, int flip) const {
+    if (mrecording)
+        mrecording->draw_tinted_scaled_bmp(bitmap, dx, dy, dw, dh, rgb(1.0, 1.0, 1.0), flip);
+    else
+        GraphicsImplementation::draw_scaled_bmp(bitmap, dx, dy, dw, dh, flip);
+}
+
+void Graphics::draw_tinted_scaled_bmp(const Bitmap& bitmap, int dx, int dy, int dw, int dh, Color col,
+                                      int flip) const {
+    if (mrecording)
+        mrecording->draw_tinted_scaled_bmp(bitmap, dx, dy, dw, dh, col, flip);
+    else
+        GraphicsImplementation::draw_tinted_scaled_bmp(bitmap, dx, dy, dw, dh, col, flip);
+}
+
+void Graphics::draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, float dx, float dy, float sx, float sy,
+                                                      float sw, float sh, float crx, float cry, Color col) {
+    if (mrecording)
+        mrecording->draw_tinted_bmp_region_rounded_corners(bitmap, dx, dy, sx, sy, sw, sh, crx, cry, col);
+    else
+        GraphicsImplementation::draw_tinted_bmp_region_rounded_corners(bitmap, dx, dy, sx, sy, sw, sh, crx, cry,
+                                                                       col);
+}
+
+void Graphics::draw_text(const FontImplementation& font, float x, float y, Color color, const std::string& text) {
+    if (mrecording)
+        mrecording->draw_text(DrawList::Op::Text, font, x, y, color, text);
+    else
+        GraphicsImplementation::draw_text(font, x, y, color, text);
+}
+
+void Graphics::draw_textr(const FontImplementation& font, float x, float y, Color color, const std::string& text) {
+    if (mrecording)
+        mrecording->draw_text(DrawList::Op::TextRight, font, x, y, color, text);
+    else
+        GraphicsImplementation::draw_textr(font, x, y, color, text);
+}
+
+void Graphics::draw_textc(const FontImplementation& font, float x, float y, Color color, const std::string& text) {
+    if (mrecording)
+        mrecording->draw_text(DrawList::Op::TextCenter, font, x, y, color, text);
+    else
+        GraphicsImplementation::draw_textc(font, x, y, color, text);
+}
+
+void Graphics::draw_text_clipped_to_rect(const FontImplementation& font, float x, float y, Color color,
+                                         const Rect& clip_rect, const std::string& text) {
+    if (mrecording)
+        mrecording->draw_text_clipped_to_rect(font, x, y, color, clip_rect, text);
+    else
+        GraphicsImplementation::draw_text_clipped_to_rect(font, x, y, color, clip_rect, text);
+}
+
+void Graphics::draw_text_run(const FontImplementation& font, float x, float y, Color color,
+                             const TextRunImplementation& run) {
+    if (mrecording)
+        mrecording->draw_text_run(font, x, y, color, run);
+    else
+        GraphicsImplementation::draw_text_run(font, x, y, color, run);
+}
+
+void Graphics::draw_text_run_clipped_to_rect(const FontImplementation& font, float x, float y, Color color,
+                                             const Rect& clip_rect, const TextRunImplementation& run) {
+    if (mrecording)
+        mrecording->draw_text_run_clipped_to_rect(font, x, y, color, clip_rect, run);
+    else
+        GraphicsImplementation::draw_text_run_clipped_to_rect(font, x, y, color, clip_rect, run);
+}
+
 void Graphics::draw_ninepatch(const lgui::NinePatch& np, const lgui::Position& pos,
                               const lgui::Size& content_size) const {
-    np.draw_tinted(lgui::rgb(1.0, 1.0, 1.0), pos.x(), pos.y(), content_size);
+    draw_ninepatch_tinted(np, lgui::rgb(1.0, 1.0, 1.0), pos.x(), pos.y(), content_size);
 }
 
 void Graphics::draw_ninepatch(const lgui::NinePatch& np, int dx, int dy, const lgui::Size& content_size) const {
-    np.draw_tinted(lgui::rgb(1.0, 1.0, 1.0), dx, dy, content_size);
+    draw_ninepatch_tinted(np, lgui::rgb(1.0, 1.0, 1.0), dx, dy, content_size);
 }
 
 void Graphics::draw_ninepatch(const lgui::NinePatch& np, int dx, int dy, int content_w, int content_h) const {
-    np.draw_tinted(lgui::rgb(1.0, 1.0, 1.0), dx, dy, lgui::Size(content_w, content_h));
+    draw_ninepatch_tinted(np, lgui::rgb(1.0, 1.0, 1.0), dx, dy, lgui::Size(content_w, content_h));
 }
 
 void Graphics::draw_ninepatch_tinted(const lgui::NinePatch& np, const lgui::Color& col, int dx, int dy,
                                      int content_w, int content_h) const {
-    np.draw_tinted(col, dx, dy, lgui::Size(content_w, content_h));
+    draw_ninepatch_tinted(np, col, dx, dy, lgui::Size(content_w, content_h));
 }
 
 void Graphics::draw_ninepatch_tinted(const lgui::NinePatch& np, const lgui::Color& col, int dx, int dy,
                                      const lgui::Size& content_size) const {
+    if (mrecording) {
+        mrecording->draw_ninepatch_tinted(np, col, dx, dy, content_size);
+        return;
+    }
+    prepare_bitmaps();
     np.draw_tinted(col, dx, dy, content_size);
 }
 
 void Graphics::draw_ninepatch_tinted(const lgui::NinePatch& np, const lgui::Color& col, const lgui::Position& pos,
                                      const lgui::Size& content_size) const {
-    np.draw_tinted(col, pos.x(), pos.y(), content_size);
+    draw_ninepatch_tinted(np, col, pos.x(), pos.y(), content_size);
 }
 
 void Graphics::draw_ninepatch_outer_size(const lgui::NinePatch& np, const lgui::Position& pos,
                                          const lgui::Size& total_size) const {
     lgui::Size cs = np.content_for_total_size(total_size);
-    np.draw_tinted(lgui::rgb(1.0, 1.0, 1.0), pos.x(), pos.y(), cs);
+    draw_ninepatch_tinted(np, lgui::rgb(1.0, 1.0, 1.0), pos.x(), pos.y(), cs);
 }
 
 void Graphics::draw_ninepatch_outer_size(const lgui::NinePatch& np, int dx, int dy,
                                          const lgui::Size& total_size) const {
     lgui::Size cs = np.content_for_total_size(total_size);
-    np.draw_tinted(lgui::rgb(1.0, 1.0, 1.0), dx, dy, cs);
+    draw_ninepatch_tinted(np, lgui::rgb(1.0, 1.0, 1.0), dx, dy, cs);
 }
 
 void Graphics::draw_tinted_ninepatch_outer_size(const lgui::NinePatch& np, const lgui::Color& col,
                                                 const lgui::Position& pos, const lgui::Size& total_size) const {
     lgui::Size cs = np.content_for_total_size(total_size);
-    np.draw_tinted(col, pos.x(), pos.y(), cs);
+    draw_ninepatch_tinted(np, col, pos.x(), pos.y(), cs);
 }
 
 void Graphics::draw_tinted_ninepatch_outer_size(const lgui::NinePatch& np, const lgui::Color& col, int dx, int dy,
                                                 const lgui::Size& total_size) const {
     lgui::Size cs = np.content_for_total_size(total_size);
-    np.draw_tinted(col, dx, dy, cs);
+    draw_ninepatch_tinted(np, col, dx, dy, cs);
 }
 
 
 void Graphics::rect(float x1, float y1, float x2, float y2, lgui::Color col, float thickness) {
-    mprim_helper.rect(x1, y1, x2, y2, col, thickness);
+    if (mrecording)
+        mrecording->rect(x1, y1, x2, y2, col, thickness);
+    else
+        prims().rect(x1, y1, x2, y2, col, thickness);
 }
 
 void Graphics::rect(const lgui::Rect& r, lgui::Color col, float thickness) {
     // we add 0.5 for a width of one
-    mprim_helper.rect(r.x1() + 0.5, r.y1() + 0.5, r.x2() + 0.5, r.y2() + 0.5,
-                      col, thickness);
+    rect(r.x1() + 0.5, r.y1() + 0.5, r.x2() + 0.5, r.y2() + 0.5, col, thickness);
 }
 
 
 void Graphics::filled_rect(float x1, float y1, float x2, float y2, lgui::Color col) {
-    mprim_helper.filled_rect(x1, y1, x2, y2, col);
+    if (mrecording)
+        mrecording->filled_rect(x1, y1, x2, y2, col);
+    else
+        prims().filled_rect(x1, y1, x2, y2, col);
 }
 
 void Graphics::filled_rect(const lgui::Rect& r, lgui::Color col) {
-    mprim_helper.filled_rect(r.x1(), r.y1(), r.x2() + 1, r.y2() + 1, col);
+    filled_rect(r.x1(), r.y1(), r.x2() + 1, r.y2() + 1, col);
 }
 
 void Graphics::filled_triangle(lgui::Point v1, lgui::Point v2, lgui::Point v3, lgui::Color col) {
-    mprim_helper.filled_triangle(v1.x(), v1.y(),
-                                 v2.x(), v2.y(),
-                                 v3.x(), v3.y(), col);
+    filled_triangle(v1.x(), v1.y(), v2.x(), v2.y(), v3.x(), v3.y(), col);
 }
 
 void Graphics::filled_triangle(float x1, float y1, float x2, float y2, float x3, float y3, lgui::Color col) {
-    mprim_helper.filled_triangle(x1, y1, x2, y2, x3, y3, col);
+    if (mrecording)
+        mrecording->filled_triangle(x1, y1, x2, y2, x3, y3, col);
+    else
+        prims().filled_triangle(x1, y1, x2, y2, x3, y3, col);
 }
 
 void Graphics::fill_draw_area(lgui::Color col) {
-    mprim_helper.filled_rect(0, 0, mw, mh, col);
+    if (mrecording)
+        mrecording->fill_draw_area(col);
+    else
+        prims().filled_rect(0, 0, mw, mh, col);
 }
 
 void Graphics::fill_draw_area_black(float alpha) {
-    mprim_helper.filled_rect(0, 0, mw, mh, lgui::rgba(0, 0, 0, alpha));
+    fill_draw_area(lgui::rgba(0, 0, 0, alpha));
 }
 
 
 void Graphics::rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col,
                             float thickness) {
-    mprim_helper.rounded_rect(x1, y1, x2, y2,
-                              rx, ry, col, thickness);
+    if (mrecording)
+        mrecording->rounded_rect(x1, y1, x2, y2, rx, ry, col, thickness);
+    else
+        prims().rounded_rect(x1, y1, x2, y2, rx, ry, col, thickness);
 }
 
 void Graphics::rounded_rect(const lgui::Rect& r, float rx, float ry, lgui::Color col, float thickness) {
     // for a 1px line
-    mprim_helper.rounded_rect(r.x1() + 0.5, r.y1() + 0.5, r.x2() + 0.5,
-                              r.y2() + 0.5,
-                              rx, ry, col, thickness);
+    rounded_rect(r.x1() + 0.5, r.y1() + 0.5, r.x2() + 0.5, r.y2() + 0.5, rx, ry, col, thickness);
 }
 
 void Graphics::filled_rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col) {
-    mprim_helper.filled_rounded_rect(x1, y1, x2, y2, rx, ry, col);
+    if (mrecording)
+        mrecording->filled_rounded_rect(x1, y1, x2, y2, rx, ry, col);
+    else
+        prims().filled_rounded_rect(x1, y1, x2, y2, rx, ry, col);
 }
 
 void Graphics::filled_rounded_rect(const lgui::Rect& r, float rx, float ry, lgui::Color col) {
-    mprim_helper.filled_rounded_rect(r.x1(), r.y1(), r.x() + r.w(), r.y() + r.h(),
-                                     rx, ry, col);
+    filled_rounded_rect(r.x1(), r.y1(), r.x() + r.w(), r.y() + r.h(), rx, ry, col);
 }
 
 void Graphics::circle(float cx, float cy, float r, lgui::Color col, float thickness) {
-    mprim_helper.circle(cx, cy, r, col, thickness);
+    if (mrecording)
+        mrecording->circle(cx, cy, r, col, thickness);
+    else
+        prims().circle(cx, cy, r, col, thickness);
 }
 
 void Graphics::filled_circle(float cx, float cy, float r, lgui::Color col) {
-    mprim_helper.filled_circle(cx, cy, r, col);
+    if (mrecording)
+        mrecording->filled_circle(cx, cy, r, col);
+    else
+        prims().filled_circle(cx, cy, r, col);
 }
 
 void Graphics::line(float x1, float y1, float x2, float y2, lgui::Color col, float thickness) {
-    mprim_helper.line(x1, y1, x2, y2, col, thickness);
+    if (mrecording)
+        mrecording->line(x1, y1, x2, y2, col, thickness);
+    else
+        prims().line(x1, y1, x2, y2, col, thickness);
 }
 
 void Graphics::line_p05(float x1, float y1, float x2, float y2, lgui::Color col, float thickness) {
-    mprim_helper.line(x1 + 0.5, y1 + 0.5, x2 + 0.5, y2 + 0.5, col, thickness);
+    line(x1 + 0.5, y1 + 0.5, x2 + 0.5, y2 + 0.5, col, thickness);
 }
 
 void Graphics::draw_visible_pixel(float px, float py, lgui::Color col) {
-    mprim_helper.draw_visible_pixel(px, py, col);
+    if (mrecording)
+        mrecording->draw_visible_pixel(px, py, col);
+    else
+        prims().draw_visible_pixel(px, py, col);
 }
 
 void Graphics::draw_filled_pieslice(float cx, float cy, float r, float start_theta, float delta_theta,
                                     lgui::Color color) {
-    mprim_helper.draw_filled_pieslice(cx, cy, r, start_theta, delta_theta, color);
+    if (mrecording)
+        mrecording->draw_filled_pieslice(cx, cy, r, start_theta, delta_theta, color);
+    else
+        prims().draw_filled_pieslice(cx, cy, r, start_theta, delta_theta, color);
 }
 
 void Graphics::draw_vertices(lgui::PrimType type, const PrimVertex* first, unsigned int start,
                              unsigned int end) const {
-    mprim_helper.draw_vertices(type, first, start, end);
+    if (mrecording)
+        mrecording->draw_vertices(type, first, start, end);
+    else
+        prims().draw_vertices(type, first, start, end);
 }
 
 void Graphics::draw_vertices(lgui::PrimType type, const std::vector<PrimVertex>& verts, unsigned int start,
                              unsigned int end) const {
-    mprim_helper.draw_vertices(type, verts, start, end);
+    if (mrecording)
+        mrecording->draw_vertices(type, verts.data(), start, end);
+    else
+        prims().draw_vertices(type, verts, start, end);
 }
 
 void Graphics::draw_vertices_indexed(lgui::PrimType type, const std::vector<PrimVertex>& verts,
                                      const std::vector<int>& indices, unsigned int n) const {
-    mprim_helper.draw_vertices_indexed(type, verts, indices, n);
+    if (mrecording)
+        mrecording->draw_vertices_indexed(type, verts, indices, n);
+    else
+        prims().draw_vertices_indexed(type, verts, indices, n);
 }
 
 void Graphics::filled_rounded_rect_gradient(const lgui::Rect& r, float rx, float ry, const lgui::Color& col1,
                                             const lgui::Color& col2, lgui::GradientDirection dir) {
-    mprim_helper.filled_rounded_rect_gradient(r.x1(), r.y1(),
-                                              r.x() + r.w(), r.y() + r.h(), rx, ry, col1, col2, dir);
+    filled_rounded_rect_gradient(r.x1(), r.y1(), r.x() + r.w(), r.y() + r.h(), rx, ry, col1, col2, dir);
 }
 
 void Graphics::filled_rounded_rect_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
                                             const lgui::Color& col1, const lgui::Color& col2,
                                             lgui::GradientDirection dir) {
-    mprim_helper.filled_rounded_rect_gradient(x1, y1,
-                                              x2, y2, rx, ry, col1, col2, dir);
+    if (mrecording)
+        mrecording->filled_rounded_rect_gradient(x1, y1, x2, y2, rx, ry, col1, col2, dir);
+    else
+        prims().filled_rounded_rect_gradient(x1, y1, x2, y2, rx, ry, col1, col2, dir);
 }
 
 void Graphics::filled_rect_gradient(const lgui::Rect& r, const lgui::Color& col1, const lgui::Color& col2,
                                     lgui::GradientDirection dir) {
-    mprim_helper.filled_rect_gradient(r.x(), r.y(),
-                                      r.x() + r.w(), r.y() + r.h(),
-                                      col1, col2, dir);
+    filled_rect_gradient(r.x(), r.y(), r.x() + r.w(), r.y() + r.h(), col1, col2, dir);
 }
 
 void Graphics::filled_rect_gradient(float x1, float y1, float x2, float y2,
                                     const lgui::Color& col1, const lgui::Color& col2,
                                     lgui::GradientDirection dir) {
-    mprim_helper.filled_rect_gradient(x1, y1,
-                                      x2, y2,
-                                      col1, col2, dir);
+    if (mrecording)
+        mrecording->filled_rect_gradient(x1, y1, x2, y2, col1, col2, dir);
+    else
+        prims().filled_rect_gradient(x1, y1, x2, y2, col1, col2, dir);
 }
 
 void Graphics::rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
                                          lgui::Color color, float thickness, int corners) {
-    mprim_helper.rounded_rect_spec_corners(x1, y1,
-                                           x2, y2,
-                                           rx, ry, color, thickness, corners);
+    if (mrecording)
+        mrecording->rounded_rect_spec_corners(x1, y1, x2, y2, rx, ry, color, thickness, corners);
+    else
+        prims().rounded_rect_spec_corners(x1, y1, x2, y2, rx, ry, color, thickness, corners);
 }
 
 void Graphics::rounded_rect_spec_corners(const lgui::Rect& r, float rx, float ry, lgui::Color color,
                                          float thickness, int corners) {
     // we add 0.5 for a width of one
-    mprim_helper.rounded_rect_spec_corners(r.x() + 0.5, r.y() + 0.5,
-                                           r.x2() + 0.5, r.y2() + 0.5,
-                                           rx, ry, color, thickness, corners);
+    rounded_rect_spec_corners(r.x() + 0.5, r.y() + 0.5, r.x2() + 0.5, r.y2() + 0.5, rx, ry, color, thickness, corners);
 }
 
 void Graphics::filled_rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
                                                 lgui::Color color, int corners) {
-    mprim_helper.filled_rounded_rect_spec_corners(x1, y1,
-                                                  x2, y2,
-                                                  rx, ry, color, corners);
+    if (mrecording)
+        mrecording->filled_rounded_rect_spec_corners(x1, y1, x2, y2, rx, ry, color, corners);
+    else
+        prims().filled_rounded_rect_spec_corners(x1, y1, x2, y2, rx, ry, color, corners);
 }
 
 void Graphics::filled_rounded_rect_spec_corners(const lgui::Rect& r, float rx, float ry, lgui::Color color,
                                                 int corners) {
-    mprim_helper.filled_rounded_rect_spec_corners(r.x(), r.y(),
-                                                  r.x() + r.w(), r.y() + r.h(),
-                                                  rx, ry, color, corners);
+    filled_rounded_rect_spec_corners(r.x(), r.y(), r.x() + r.w(), r.y() + r.h(), rx, ry, color, corners);
 }
 
 
 void Graphics::rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color color,
                                     float thickness, lgui::OpenEdge oe) {
-    mprim_helper.rounded_rect_bracket(x1, y1,
-                                      x2, y2,
-                                      rx, ry, color, thickness, oe);
-
+    if (mrecording)
+        mrecording->rounded_rect_bracket(x1, y1, x2, y2, rx, ry, color, thickness, oe);
+    else
+        prims().rounded_rect_bracket(x1, y1, x2, y2, rx, ry, color, thickness, oe);
 }
 
 void Graphics::rounded_rect_bracket(const lgui::Rect& r, float rx, float ry, lgui::Color color, float thickness,
                                     lgui::OpenEdge oe) {
     // we add 0.5 for a width of one
-    mprim_helper.rounded_rect_bracket(r.x1() + 0.5, r.y1() + 0.5,
-                                      r.x2() + 0.5, r.y2() + 0.5,
-                                      rx, ry, color, thickness, oe);
+    rounded_rect_bracket(r.x1() + 0.5, r.y1() + 0.5, r.x2() + 0.5, r.y2() + 0.5, rx, ry, color, thickness, oe);
 }
 
 
 void Graphics::rect_bracket(float x1, float y1, float x2, float y2, lgui::Color color, float thickness,
                             lgui::OpenEdge oe) {
-    mprim_helper.rect_bracket(x1, y1,
-                              x2, y2,
-                              color, thickness, oe);
+    if (mrecording)
+        mrecording->rect_bracket(x1, y1, x2, y2, color, thickness, oe);
+    else
+        prims().rect_bracket(x1, y1, x2, y2, color, thickness, oe);
 }
 
 void Graphics::rect_bracket(const lgui::Rect& r, lgui::Color color, float thickness, lgui::OpenEdge oe) {
     // we add 0.5 for a width of one
-    mprim_helper.rect_bracket(r.x1() + 0.5, r.y1() + 0.5,
-                              r.x2() + 0.5, r.y2() + 0.5,
-                              color, thickness, oe);
+    rect_bracket(r.x1() + 0.5, r.y1() + 0.5, r.x2() + 0.5, r.y2() + 0.5, color, thickness, oe);
 }
 
 void Graphics::filled_rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry,
                                            lgui::Color color, lgui::OpenEdge oe) {
-    mprim_helper.filled_rounded_rect_bracket(x1, y1,
-                                             x2, y2,
-                                             rx, ry, color, oe);
+    if (mrecording)
+        mrecording->filled_rounded_rect_bracket(x1, y1, x2, y2, rx, ry, color, oe);
+    else
+        prims().filled_rounded_rect_bracket(x1, y1, x2, y2, rx, ry, color, oe);
 }
 
 void Graphics::filled_rounded_rect_bracket(const lgui::Rect& r, float rx, float ry, lgui::Color color,
                                            lgui::OpenEdge oe) {
-    mprim_helper.filled_rounded_rect_bracket(r.x(), r.y(),
-                                             r.x() + r.w(), r.y() + r.h(),
-                                             rx, ry, color, oe);
+    filled_rounded_rect_bracket(r.x(), r.y(), r.x() + r.w(), r.y() + r.h(), rx, ry, color, oe);
 }
 
 
 void Graphics::filled_rounded_rect_bracket_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
                                                     const lgui::Color& col1, const lgui::Color& col2,
                                                     lgui::OpenEdge oe, lgui::GradientDirection dir) {
-    mprim_helper.filled_rounded_rect_bracket_gradient(x1, y1,
-                                                      x2, y2,
-                                                      rx, ry, col1, col2, oe, dir);
+    if (mrecording)
+        mrecording->filled_rounded_rect_bracket_gradient(x1, y1, x2, y2, rx, ry, col1, col2, oe, dir);
+    else
+        prims().filled_rounded_rect_bracket_gradient(x1, y1, x2, y2, rx, ry, col1, col2, oe, dir);
 }
 
 void Graphics::filled_rounded_rect_bracket_gradient(const lgui::Rect& r, float rx, float ry,
                                                     const lgui::Color& col1, const lgui::Color& col2,
                                                     lgui::OpenEdge oe, lgui::GradientDirection dir) {
-    mprim_helper.filled_rounded_rect_bracket_gradient(r.x(), r.y(),
+    prims().filled_rounded_rect_bracket_gradient(r.x(), r.y(),
                                                       r.x() + r.w(), r.y() + r.h(),
                                                       rx, ry, col1, col2, oe, dir);
 }
@@ -40,33 +40,111 @@
 #ifndef LGUI_GRAPHICS_H
 #define LGUI_GRAPHICS_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlgraphics.h"
+#include "headless/hltransform.h"
+
+namespace lgui {
+using GraphicsImplementation = HLGraphics;
+}
+#else
 #include "a5/a5graphics.h"
 #include "a5/a5transform.h"
 
 namespace lgui {
 using GraphicsImplementation = A5Graphics;
 }
+#endif
 
 
+#include "error.h"
 #include "primhelper.h"
 #include "ninepatch.h"
-#include <stack>
+#include <vector>
 
 namespace lgui {
 
+class DrawList;
+
 /** The graphics context object used to draw things. Provides methods to draw things and manages a stack of
-    clipping rectangles and transformations. */
+    clipping rectangles and transformations.
+
+    As long as no draw area with a (non-identity) transformation has been pushed, the draw areas are
+    tracked as a plain integer offset; a transformation matrix is only composed while one is active. The
+    stacks are preallocated and keep their storage, so pushing and popping draw areas won't allocate. */
 class Graphics : public GraphicsImplementation {
     public:
         Graphics();
         ~Graphics() = default;
 
+        /** Tag for the recording-only constructor. */
+        struct RecordOnly {};
+
+        /** Create a Graphics object that never accesses the backend, so that it may be used on another thread
+         *  than the one drawing to the display. It can only record: everything has to be drawn between
+         *  begin_recording() and end_recording(), and layers can't be used. `size` is the size of the initial
+         *  draw area. */
+        Graphics(RecordOnly, const Size& size);
+
+        /** Return whether the object has been created with the recording-only constructor. */
+        bool is_record_only() const { return mrecord_only; }
+
         void push_draw_area(int offsx, int offsy, int w, int h, bool clip = false);
         void push_draw_area(int offsx, int offsy, int w, int h, const Transform& transform, bool clip = false);
         void push_draw_area(const Rect& r, bool clip = false);
         void push_draw_area(const Rect& r, const Transform& transform, bool clip = false);
+        /** Like push_draw_area(r, clip), but promise that nothing will be drawn outside of `cull_bounds`, given
+         *  relative to the area, so that the area can be culled when a recording is replayed. Unclipped areas
+         *  pushed via the other overloads aren't culled on replay, since anything might be drawn outside of
+         *  them. */
+        void push_draw_area(const Rect& r, bool clip, const Rect& cull_bounds);
         void pop_draw_area();
 
+        /** Return whether a draw area that would be pushed via push_draw_area(r, transform) intersects the
+         *  active clip rectangle at all, i.e. whether anything drawn into it might be visible. This doesn't
+         *  modify the stack of draw areas. */
+        bool is_area_visible(const Rect& r, const Transform& transform);
+        bool is_area_visible(const Rect& r);
+
+        /** Return the number of draw areas culled (i.e. skipped because they were not visible) since the
+         *  last call to reset_culled_count(). GUI::draw_widgets() resets it at the beginning of each frame. */
+        int culled_count() const { return mculled_count; }
+        void reset_culled_count() { mculled_count = 0; }
+        void _increment_culled_count() { mculled_count++; }
+
+        /** Redirect all drawing into `bmp` until end_layer() is called. The current draw area stack, clipping
+         *  and transformation are saved; drawing starts out at the bitmap's origin, clipped to the bitmap.
+         *  Calls may be nested. */
+        void begin_layer(Bitmap& bmp);
+        /** Restore the state saved by the matching begin_layer(). */
+        void end_layer();
+
+        /** Record everything drawn into `list` instead of drawing it, until end_recording() is called. The
+         *  list is cleared first. The commands are recorded relative to the current draw area; draw areas
+         *  pushed in between are recorded, too, and aren't culled until the list is replayed. Recording
+         *  doesn't touch the backend: clipping and transformation stay as they are. Calls may be nested.
+         *  Layers begun while recording are rendered right away, only drawing them is recorded. */
+        void begin_recording(DrawList& list);
+        /** Like begin_recording(), but cull the draw areas that wouldn't be visible within `cull_rect`, given
+         *  relative to the current draw area, i.e. don't record them at all. Only use this if the list is
+         *  going to be replayed in the same place, e.g. for a snapshot of a whole frame. Clipping isn't taken
+         *  into account and nothing is culled within transformed draw areas. Can't be nested into another
+         *  recording; recordings nested into this one aren't culled. */
+        void begin_recording(DrawList& list, const Rect& cull_rect);
+        /** Stop recording into the list passed to the matching begin_recording(). */
+        void end_recording();
+        bool is_recording() const { return mrecording != nullptr; }
+
+        /** Return the number of draw calls issued for primitives since the last call to
+         *  reset_prim_draw_calls(). Useful to see the effect of set_batching(). */
+        int prim_draw_calls() const { return mprim_helper.draw_calls(); }
+        void reset_prim_draw_calls() { mprim_helper.reset_draw_calls(); }
+
+        /** Return the helper used to draw primitives, e.g. to configure its tessellation cache or to query
+         *  cache statistics. Don't draw with it directly. */
+        PrimHelper& prim_helper() { return mprim_helper; }
+        const PrimHelper& prim_helper() const { return mprim_helper; }
+
         void draw_ninepatch(const NinePatch& np, const Position& pos,
                             const Size& content_size) const;
         void draw_ninepatch(const NinePatch& np, int dx, int dy, const Size& content_size) const;
@@ -87,6 +165,28 @@ class Graphics : public GraphicsImplementation {
                                               int dx, int dy, const Size& total_size) const;
 
 
+        // These hide the backend's versions in order to be able to record them.
+        void clear(Color col);
+        void draw_bmp(const Bitmap& bitmap, int dx, int dy, int flip = 0);
+        void draw_tinted_bmp(const Bitmap& bitmap, int dx, int dy, Color col, int flip = 0);
+        void draw_bmp_region(const Bitmap& bitmap, int dx, int dy, int sx, int sy, int sw, int sh, int flip = 0);
+        void draw_tinted_bmp_region(const Bitmap& bitmap, int dx, int dy, int sx, int sy, int sw, int sh,
+                                    Color col, int flip = 0);
+        void draw_scaled_bmp(const Bitmap& bitmap, int dx, int dy, int dw, int dh, int flip = 0) const;
+        void draw_tinted_scaled_bmp(const Bitmap& bitmap, int dx, int dy, int dw, int dh, Color col,
+                                    int flip = 0) const;
+        void draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, float dx, float dy, float sx, float sy,
+                                                    float sw, float sh, float crx, float cry, Color col);
+        void draw_text(const FontImplementation& font, float x, float y, Color color, const std::string& text);
+        void draw_textr(const FontImplementation& font, float x, float y, Color color, const std::string& text);
+        void draw_textc(const FontImplementation& font, float x, float y, Color color, const std::string& text);
+        void draw_text_clipped_to_rect(const FontImplementation& font, float x, float y, Color color,
+                                       const Rect& clip_rect, const std::string& text);
+        void draw_text_run(const FontImplementation& font, float x, float y, Color color,
+                           const TextRunImplementation& run);
+        void draw_text_run_clipped_to_rect(const FontImplementation& font, float x, float y, Color color,
+                                           const Rect& clip_rect, const TextRunImplementation& run);
+
         void draw_vertices(PrimType type, const PrimVertex* first, unsigned int start, unsigned int end) const;
         void draw_vertices(PrimType type, const std::vector<PrimVertex>& verts, unsigned int start = 0,
                            unsigned int end = 0) const;
@@ -152,18 +252,69 @@ class Graphics : public GraphicsImplementation {
 
     private:
         void update_clip_rect(int offsx, int offsy, int& w, int& h);
+        void reserve_stacks();
+        void push_area_entry(int offsx, int offsy, int w, int h, bool clip);
+        void push_untransformed_area(const Rect& r, bool clip, const Rect* cull_bounds);
+        bool is_screen_area_visible(float x1, float y1, float x2, float y2);
+        /** Apply the current offset or transformation immediately. */
+        void use_current_transform();
+        /** Return whether draw areas are being culled while recording: only within the outermost recording
+         *  begun with a cull rectangle. */
+        bool is_culling_recording() const { return mrecording_culled && msuspended_recordings.size() == 1; }
+        bool is_recorded_area_visible(float x1, float y1, float x2, float y2) const;
+
+        PrimHelper& prims() {
+            ASSERT(!mrecord_only);
+            prepare_prims();
+            return mprim_helper;
+        }
+        const PrimHelper& prims() const {
+            ASSERT(!mrecord_only);
+            prepare_prims();
+            return mprim_helper;
+        }
+
+        // Initial capacities of the stacks; deeper nesting will still work, but grow the storage once.
+        static constexpr int DRAW_AREA_STACK_CAPACITY = 64;
+        static constexpr int TRANSFORM_STACK_CAPACITY = 16;
+        static constexpr int LAYER_STACK_CAPACITY = 8;
 
         struct DrawAreaStackEntry {
-            Transform transform;
             Rect rect;
             bool is_clipped;
+            bool was_transformed; // mtransform has been saved to mtransforms
+        };
+
+        // The layers share the other stacks: they only remember where their part begins.
+        struct LayerStackEntry {
+            size_t draw_areas_base, clip_rects_base, transforms_base;
+            Rect rect;
+            bool is_clipped, is_transformed;
+            DrawList* recording; // suspended while drawing to the layer
         };
 
         PrimHelper mprim_helper;
-        std::stack<DrawAreaStackEntry> mdraw_areas;
-        std::stack<Rect> mclip_rects;
+        std::vector<DrawAreaStackEntry> mdraw_areas;
+        std::vector<Rect> mclip_rects;
+        std::vector<Transform> mtransforms;
         bool mclip;
+        // Whether a transformation is active. If not, the current transformation is a translation by
+        // (moffsx, moffsy) and mtransform is not kept up to date.
+        bool mtransformed;
         Transform mtransform;
+        int mculled_count;
+        std::vector<LayerStackEntry> mlayers;
+        DrawList* mrecording;
+        std::vector<DrawList*> msuspended_recordings;
+        // The draw areas pushed while culling a recording: their offsets, and whether they are untransformed.
+        struct CulledAreaEntry {
+            Point offs;
+            bool exact;
+        };
+        std::vector<CulledAreaEntry> mculled_areas;
+        Rect mrecording_cull_rect;
+        bool mrecording_culled;
+        bool mrecord_only;
 };
 
 }
@@ -0,0 +1,169 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "../bitmap.h"
+#include "../error.h"
+#include "hldevice.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace lgui {
+
+HLBitmap::HLBitmap(const char* filename, bool filter)
+        : mw(0), mh(0), mloaded(false), mname(filename) {
+    (void) filter;
+    load(filename);
+}
+
+HLBitmap::HLBitmap(HLBitmap&& bmp) noexcept
+        : mw(bmp.mw), mh(bmp.mh), mloaded(bmp.mloaded), mpixels(std::move(bmp.mpixels)),
+          mname(std::move(bmp.mname)), mclip(bmp.mclip), mtransform(bmp.mtransform) {
+    HLDevice::get()._release_target(&bmp);
+    bmp.mloaded = false;
+    bmp.mname = "";
+}
+
+HLBitmap::HLBitmap(int w, int h)
+        : mw(w), mh(h), mloaded(true), mclip(0, 0, w, h) {
+    ASSERT(w > 0 && h > 0);
+    mtransform.set_identity();
+}
+
+void HLBitmap::load(const char* filename) {
+    if (!load_tga(filename)) {
+        error("Error loading file", "Couldn't load file \"%s\"!", filename);
+    }
+    mloaded = true;
+    mclip = Rect(0, 0, mw, mh);
+    mtransform.set_identity();
+}
+
+bool HLBitmap::load_tga(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (!f)
+        return false;
+    unsigned char header[18] = {0};
+    bool ok = fread(header, 1, 18, f) == 18;
+    int id_length = header[0], color_map_type = header[1], image_type = header[2];
+    int color_map_length = header[5] | (header[6] << 8), color_map_entry_bits = header[7];
+    int w = header[12] | (header[13] << 8), h = header[14] | (header[15] << 8);
+    int bpp = header[16] / 8;
+    bool top_down = header[17] & 0x20;
+    ok = ok && (image_type == 2 || image_type == 10) && (bpp == 3 || bpp == 4) && w > 0 && h > 0;
+    int skip = id_length + (color_map_type == 1 ? color_map_length * ((color_map_entry_bits + 7) / 8) : 0);
+    ok = ok && fseek(f, skip, SEEK_CUR) == 0;
+
+    std::vector<uint32_t> pixels(ok ? w * h : 0);
+    unsigned char px[4] = {0, 0, 0, 255};
+    int n = 0, run = 0;
+    bool repeat = false;
+    while (ok && n < w * h) {
+        if (image_type == 10 && run == 0) {
+            int c = fgetc(f);
+            ok = c != EOF;
+            repeat = c & 0x80;
+            run = (c & 0x7f) + 1;
+            if (ok && repeat)
+                ok = fread(px, 1, bpp, f) == size_t(bpp);
+        }
+        else if (image_type == 2 || !repeat)
+            ok = fread(px, 1, bpp, f) == size_t(bpp);
+        if (!ok)
+            break;
+        // BGR(A) as stored; premultiply alpha like Allegro does when loading.
+        unsigned int a = bpp == 4 ? px[3] : 255;
+        unsigned int r = px[2] * a / 255, g = px[1] * a / 255, b = px[0] * a / 255;
+        int y = top_down ? n / w : h - 1 - n / w;
+        pixels[y * w + n % w] = (r << 24) | (g << 16) | (b << 8) | a;
+        n++;
+        if (run > 0)
+            run--;
+    }
+    fclose(f);
+    if (!ok)
+        return false;
+    mw = w;
+    mh = h;
+    mpixels = std::move(pixels);
+    return true;
+}
+
+int HLBitmap::w() const {
+    ASSERT(mloaded);
+    return mw;
+}
+
+int HLBitmap::h() const {
+    ASSERT(mloaded);
+    return mh;
+}
+
+void HLBitmap::clear_to_transparent() {
+    ASSERT(mloaded);
+    if (!mpixels.empty())
+        std::fill(mpixels.begin(), mpixels.end(), 0);
+}
+
+lgui::Color HLBitmap::getpixel(int x, int y) const {
+    ASSERT(mloaded);
+    if (mpixels.empty() || x < 0 || y < 0 || x >= mw || y >= mh)
+        return rgba(0, 0, 0, 0);
+    uint32_t p = mpixels[y * mw + x];
+    return rgba_i(p >> 24, (p >> 16) & 255, (p >> 8) & 255, p & 255);
+}
+
+void HLBitmap::reload() {
+    ASSERT(!mname.empty());
+    ASSERT(!mloaded);
+    load(mname.c_str());
+}
+
+void HLBitmap::unload() {
+    HLDevice::get()._release_target(this);
+    mpixels.clear();
+    mpixels.shrink_to_fit();
+    mloaded = false;
+}
+
+HLBitmap::~HLBitmap() {
+    HLDevice::get()._release_target(this);
+}
+
+}
@@ -0,0 +1,107 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HLBITMAP_H
+#define LGUI_HLBITMAP_H
+
+#include "hlcolor.h"
+#include "hltransform.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lgui {
+
+/** Class representing a bitmap of the headless backend. Do not use this class directly, but rather use Bitmap.
+ *
+ *  Only pixels loaded from a file are stored, so that 9-patches can be read; drawing to a bitmap is just
+ *  recorded. Truecolor TGA files (uncompressed or RLE) are supported. */
+class HLBitmap {
+        friend class HLNinepatch;
+        friend class HLGraphics;
+        friend class HLDevice;
+
+    public:
+        /** Load a file from disk. `filter` has no effect. */
+        explicit HLBitmap(const char* filename, bool filter = false);
+        /** Creates a new bitmap with the specified width and height. */
+        HLBitmap(int w, int h);
+        /** Move constructor. */
+        explicit HLBitmap(HLBitmap&& bmp) noexcept;
+
+        ~HLBitmap();
+
+        HLBitmap(const HLBitmap& other) = delete;
+        HLBitmap operator=(const HLBitmap& other) = delete;
+
+        int w() const;
+        int h() const;
+
+        /** Does nothing, there for compatibility. */
+        void lock_for_reading() {}
+        /** Return the color value of a pixel. Bitmaps that have not been loaded from a file are transparent. */
+        lgui::Color getpixel(int x, int y) const;
+        /** Does nothing, there for compatibility. */
+        void unlock() {}
+
+        /** Unloads the bitmap. The object will remember how to reload it. */
+        void unload();
+        /** Reloads the bitmap from disk. */
+        void reload();
+
+        /** Clears the bitmap to transparent color. */
+        void clear_to_transparent();
+
+    private:
+        void load(const char* filename);
+        bool load_tga(const char* filename);
+
+        int mw, mh;
+        bool mloaded;
+        std::vector<uint32_t> mpixels; // RGBA, 8 bits each, row by row from the top
+        std::string mname;
+        // Target state, see HLDevice.
+        Rect mclip;
+        HLTransform mtransform;
+};
+
+}
+
+
+#endif // LGUI_HLBITMAP_H
@@ -0,0 +1,168 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "hldevice.h"
+#include "../bitmap.h"
+#include "../error.h"
+
+namespace lgui {
+
+HLDevice& HLDevice::get() {
+    // Never destroyed, so that bitmaps with static storage duration can still unregister.
+    static HLDevice* device = new HLDevice();
+    return *device;
+}
+
+HLDevice::HLDevice()
+        : mw(1024), mh(576), mtarget(nullptr), mclip(0, 0, 1024, 576), mholding(false), mheld_drawn(false),
+          mrecording(true) {
+    mtransform.set_identity();
+    reset();
+}
+
+void HLDevice::set_display_size(int w, int h) {
+    ASSERT(w > 0 && h > 0);
+    mw = w;
+    mh = h;
+    mclip = Rect(0, 0, w, h);
+}
+
+void HLDevice::set_target(HLBitmap* bmp) {
+    hold_bitmap_drawing(false);
+    mtarget = bmp;
+}
+
+Rect& HLDevice::current_clip() {
+    return mtarget ? mtarget->mclip : mclip;
+}
+
+Rect HLDevice::target_rect() const {
+    return mtarget ? Rect(0, 0, mtarget->mw, mtarget->mh) : Rect(0, 0, mw, mh);
+}
+
+void HLDevice::set_clip_rect(int x, int y, int w, int h) {
+    Rect r(x, y, w, h);
+    r.clip_to(target_rect());
+    current_clip() = r;
+}
+
+void HLDevice::get_clip_rect(int& x, int& y, int& w, int& h) const {
+    const Rect& r = mtarget ? mtarget->mclip : mclip;
+    x = r.x();
+    y = r.y();
+    w = r.w();
+    h = r.h();
+}
+
+void HLDevice::reset_clip_rect() {
+    current_clip() = target_rect();
+}
+
+void HLDevice::use_transform(const HLTransform& transform) {
+    if (mtarget)
+        mtarget->mtransform = transform;
+    else
+        mtransform = transform;
+}
+
+const HLTransform& HLDevice::transform() const {
+    return mtarget ? mtarget->mtransform : mtransform;
+}
+
+void HLDevice::hold_bitmap_drawing(bool hold) {
+    if (!hold && mholding && mheld_drawn)
+        submit();
+    mholding = hold;
+    mheld_drawn = false;
+}
+
+void HLDevice::record(HLDrawCommand::Type type, const char* op, float x1, float y1, float x2, float y2,
+                      const Color& col) {
+    const HLTransform& t = transform();
+    PointF corners[4] = {t.map(PointF(x1, y1)), t.map(PointF(x2, y1)), t.map(PointF(x1, y2)),
+                         t.map(PointF(x2, y2))};
+    float bx1 = corners[0].x(), by1 = corners[0].y(), bx2 = bx1, by2 = by1;
+    for (const PointF& p : corners) {
+        bx1 = std::min(bx1, p.x());
+        by1 = std::min(by1, p.y());
+        bx2 = std::max(bx2, p.x());
+        by2 = std::max(by2, p.y());
+    }
+    int ix = floorf(bx1), iy = floorf(by1);
+    Rect bounds(ix, iy, int(ceilf(bx2)) - ix, int(ceilf(by2)) - iy);
+    bounds.clip_to(current_clip());
+
+    mstats.commands[type]++;
+    mstats.pixels += int64_t(bounds.w()) * bounds.h();
+    if (bounds.w() <= 0 || bounds.h() <= 0)
+        mstats.invisible++;
+    if (type == HLDrawCommand::Bitmap || type == HLDrawCommand::Text) {
+        if (mholding)
+            mheld_drawn = true;
+        else
+            submit();
+    }
+    if (mrecording)
+        mcommands.push_back(HLDrawCommand{type, op, mtarget, bounds, col});
+}
+
+void HLDevice::clear(const Color& col) {
+    hold_bitmap_drawing(false);
+    const Rect& r = current_clip();
+    mstats.commands[HLDrawCommand::Clear]++;
+    mstats.pixels += int64_t(r.w()) * r.h();
+    submit();
+    if (mrecording)
+        mcommands.push_back(HLDrawCommand{HLDrawCommand::Clear, "clear", mtarget, r, col});
+}
+
+void HLDevice::reset() {
+    mcommands.clear();
+    mstats = HLDrawStats();
+}
+
+void HLDevice::_release_target(const HLBitmap* bmp) {
+    if (mtarget == bmp)
+        set_target(nullptr);
+}
+
+}
@@ -0,0 +1,160 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HLDEVICE_H
+#define LGUI_HLDEVICE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "hlcolor.h"
+#include "hltransform.h"
+#include "lgui/lgui_types.h"
+
+namespace lgui {
+
+class HLBitmap;
+
+/** A draw operation recorded by the headless backend. */
+struct HLDrawCommand {
+    enum Type {
+        Clear, Primitive, Bitmap, Text, NoTypes
+    };
+
+    Type type;
+    const char* op;         ///< name of the operation, e.g. "filled_rounded_rect"
+    const HLBitmap* target; ///< the bitmap drawn to, nullptr for the display; only for comparison, it may
+                            ///< have been destroyed since
+    Rect bounds;            ///< area covered in target coordinates, clipped to the clipping rectangle
+    Color color;
+};
+
+/** Counters kept by the headless backend. */
+struct HLDrawStats {
+    int commands[HLDrawCommand::NoTypes]; ///< number of commands per type
+    int draw_calls;  ///< submissions: batched primitives and held bitmaps count once
+    int invisible;   ///< commands entirely outside the clipping rectangle
+    int flips;
+    int64_t pixels;  ///< sum of the areas of all commands' bounds
+
+    int total_commands() const {
+        int n = 0;
+        for (int c : commands)
+            n += c;
+        return n;
+    }
+};
+
+/** The state Allegro keeps globally for the current display - its size, the target bitmap and the target's
+ *  clipping rectangle and transformation - and the record of what has been drawn. The headless Graphics,
+ *  NinePatch and TextRun implementations draw through it, much like the Allegro ones use the current
+ *  target. The display has a fixed size (default: 1024x576) until set_display_size() is called.
+ *
+ *  By default, every draw operation is appended to commands(). Disable that with set_recording() to only
+ *  update the counters, e.g. for benchmarks. */
+class HLDevice {
+    public:
+        static HLDevice& get();
+
+        HLDevice(const HLDevice& other) = delete;
+        HLDevice& operator=(const HLDevice& other) = delete;
+
+        /** Resize the display. This resets the display's clipping rectangle. */
+        void set_display_size(int w, int h);
+        int display_width() const { return mw; }
+        int display_height() const { return mh; }
+
+        /** Make `bmp` the target, or the display if nullptr is passed. */
+        void set_target(HLBitmap* bmp);
+        HLBitmap* target() const { return mtarget; }
+
+        void set_clip_rect(int x, int y, int w, int h);
+        void get_clip_rect(int& x, int& y, int& w, int& h) const;
+        /** Reset the target's clipping rectangle to cover the whole target. */
+        void reset_clip_rect();
+
+        void use_transform(const HLTransform& transform);
+        const HLTransform& transform() const;
+
+        /** While holding, drawing bitmaps and text is counted as one draw call, issued on releasing. */
+        void hold_bitmap_drawing(bool hold);
+        bool is_bitmap_drawing_held() const { return mholding; }
+
+        /** Record an operation covering the rectangle from (x1, y1) to (x2, y2) in the coordinates of the
+         *  target's transformation. Unless bitmap drawing is held, bitmaps and text are submitted right away;
+         *  primitives have to be submitted by the caller. */
+        void record(HLDrawCommand::Type type, const char* op, float x1, float y1, float x2, float y2,
+                    const Color& col);
+        /** Fill the target's clipping rectangle. */
+        void clear(const Color& col);
+        /** Count a draw call. */
+        void submit() { mstats.draw_calls++; }
+        void flip() { mstats.flips++; }
+
+        void set_recording(bool recording) { mrecording = recording; }
+        bool is_recording() const { return mrecording; }
+
+        /** Return the commands recorded since the last call to reset(). */
+        const std::vector<HLDrawCommand>& commands() const { return mcommands; }
+        const HLDrawStats& stats() const { return mstats; }
+        /** Forget the recorded commands and reset the counters. */
+        void reset();
+
+        /** Called by bitmaps that are about to be destroyed or unloaded. */
+        void _release_target(const HLBitmap* bmp);
+
+    private:
+        HLDevice();
+
+        Rect& current_clip();
+        Rect target_rect() const;
+
+        int mw, mh;
+        HLBitmap* mtarget;
+        Rect mclip;
+        HLTransform mtransform;
+        bool mholding, mheld_drawn;
+        bool mrecording;
+        std::vector<HLDrawCommand> mcommands;
+        HLDrawStats mstats;
+};
+
+}
+
+#endif // LGUI_HLDEVICE_H
@@ -0,0 +1,76 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#include "../font.h"
+#include "../utf8.h"
+
+namespace lgui {
+
+static std::atomic<uint64_t> next_font_id(1);
+
+HLFont::HLFont(const std::string& filename, int size)
+        : msize(std::max(std::abs(size), 1)), mid(next_font_id++) {
+    (void) filename;
+}
+
+int HLFont::text_width(const std::string& str) const {
+    return text_width(str, 0, str.size());
+}
+
+int HLFont::text_width(const char* str) const {
+    return text_width(std::string(str));
+}
+
+int HLFont::text_width(const std::string& str, size_t offs, size_t n) const {
+    if (offs >= str.size())
+        return 0;
+    if (n > str.size() - offs) // will catch npos
+        n = str.size() - offs;
+    return utf8::length_cps_substr(str, offs, offs + n) * advance();
+}
+
+lgui::Rect HLFont::text_dims(const std::string& str) const {
+    return lgui::Rect(0, 0, text_width(str), str.empty() ? 0 : line_height());
+}
+
+}
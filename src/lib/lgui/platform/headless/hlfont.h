@@ -0,0 +1,108 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HLFONT_H
+#define LGUI_HLFONT_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "lgui/lgui_types.h"
+
+namespace lgui {
+
+/** Font of the headless backend with fixed metrics derived from the size only: every code point advances by
+ *  half the size (rounded up), the ascent is four fifths of the size and the line height is the size. No file is
+ *  read, so text measures the same everywhere. Do not use this class directly, but rather use Font. */
+class HLFont {
+        friend class HLGraphics;
+        friend class HLTextRun;
+
+    public:
+        /** Creates a font with the specified size. The file is not loaded. */
+        HLFont(const std::string& filename, int size);
+
+        /** Move constructor. */
+        HLFont(HLFont&& other)
+                : msize(other.msize), mid(other.mid) {}
+
+        HLFont& operator=(const HLFont& other) = delete;
+        HLFont(const HLFont& other) = delete;
+
+        int ascent() const { return (msize * 4 + 2) / 5; }
+        int descent() const { return msize - ascent(); }
+        /** Return the line height of the font. */
+        int line_height() const { return msize; }
+
+        /** Returns the width of an 'M'-character. */
+        int char_width_hint() const { return advance(); }
+
+        /** Return the width the given text will occupy using this font. */
+        int text_width(const std::string& str) const;
+        /** Return the width the given text will occupy using this font. */
+        int text_width(const char* str) const;
+
+        /** Return the width a substring of the given text will occupy using this font.
+         * @return the width of the substring starting at offs, n bytes(!) long.
+         */
+        int text_width(const std::string& str, size_t offs, size_t n) const;
+        lgui::Rect text_dims(const std::string& str) const;
+
+        /** Return how far to advance after drawing code point `cp`. There is no kerning, `next_cp` is
+         *  ignored. */
+        int glyph_advance(int32_t cp, int32_t next_cp) const {
+            (void) cp;
+            (void) next_cp;
+            return advance();
+        }
+
+        /** Return an ID identifying the font. Unlike the font's address, it is never reused by another font,
+         *  so measurements may be cached under it (see HLTextRun). */
+        uint64_t id() const { return mid; }
+
+    private:
+        int advance() const { return (msize + 1) / 2; }
+
+        int msize;
+        uint64_t mid;
+};
+
+}
+#endif // LGUI_HLFONT_H
@@ -0,0 +1,397 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include "../bitmap.h"
+#include "../font.h"
+#include "../error.h"
+#include "../graphics.h"
+#include "lgui/profiler.h"
+#include "hlgraphics.h"
+
+
+namespace lgui {
+
+HLGraphics::HLGraphics()
+        : moffsx(0), moffsy(0), mprims(nullptr), mbatching(false), mtransform_dirty(false),
+          mholding_bitmaps(false), mpending_is_offset(false), mapplied_is_offset(false) {
+    mw = display_width();
+    mh = display_height();
+    mpending_transform.set_identity();
+    mapplied_transform.set_identity();
+}
+
+HLGraphics::HLGraphics(int w, int h)
+        : moffsx(0), moffsy(0), mprims(nullptr), mbatching(false), mtransform_dirty(false),
+          mholding_bitmaps(false), mpending_is_offset(false), mapplied_is_offset(false) {
+    mw = w;
+    mh = h;
+    mpending_transform.set_identity();
+    mapplied_transform.set_identity();
+}
+
+void HLGraphics::get_clip_rect(int& x, int& y, int& w, int& h) {
+    HLDevice::get().get_clip_rect(x, y, w, h);
+}
+
+void HLGraphics::set_clip_rect(int x, int y, int w, int h) {
+    if (mbatching) {
+        int cx, cy, cw, ch;
+        HLDevice::get().get_clip_rect(cx, cy, cw, ch);
+        if (cx == x && cy == y && cw == w && ch == h)
+            return;
+        flush();
+    }
+    HLDevice::get().set_clip_rect(x, y, w, h);
+}
+
+void HLGraphics::reset_clip_rect() {
+    flush();
+    HLDevice::get().reset_clip_rect();
+}
+
+void HLGraphics::clear(lgui::Color col) {
+    flush();
+    HLDevice::get().clear(col);
+}
+
+void HLGraphics::flip() {
+    flush();
+    HLDevice::get().flip();
+}
+
+void HLGraphics::set_batching(bool batching) {
+    flush();
+    mbatching = batching;
+    if (mprims)
+        mprims->set_batching(batching);
+}
+
+void HLGraphics::flush() {
+    release_bitmaps();
+    if (mprims)
+        mprims->flush();
+    apply_pending_transform();
+}
+
+void HLGraphics::set_transform_deferred(const Transform& transform) {
+    if (!mbatching) {
+        use_transform(transform);
+        return;
+    }
+    mpending_transform = transform;
+    mpending_is_offset = false;
+    mtransform_dirty = true;
+}
+
+void HLGraphics::set_translation_deferred(int x, int y) {
+    Point offs(x, y);
+    bool unchanged = mtransform_dirty ? mpending_is_offset && mpending_offs == offs :
+                     mapplied_is_offset && mapplied_offs == offs;
+    if (unchanged)
+        return;
+    mpending_offs = offs;
+    mpending_is_offset = true;
+    mtransform_dirty = true;
+    if (!mbatching)
+        apply_pending_transform();
+}
+
+void HLGraphics::apply_pending_transform() const {
+    if (mtransform_dirty) {
+        if (mpending_is_offset) {
+            mpending_transform.set_identity();
+            mpending_transform.translate_post(PointF(mpending_offs));
+        }
+        HLDevice::get().use_transform(mpending_transform);
+        mapplied_transform = mpending_transform;
+        mapplied_is_offset = mpending_is_offset;
+        mapplied_offs = mpending_offs;
+        mtransform_dirty = false;
+    }
+    if (mprims)
+        mprims->set_batch_offset(0, 0);
+}
+
+bool HLGraphics::pending_translation_delta(PointF& d) const {
+    PointF pending, applied;
+    if (mpending_is_offset)
+        pending = PointF(mpending_offs);
+    else if (mpending_transform.is_translation())
+        pending = mpending_transform.translation();
+    else
+        return false;
+    if (mapplied_is_offset)
+        applied = PointF(mapplied_offs);
+    else if (mapplied_transform.is_translation())
+        applied = mapplied_transform.translation();
+    else
+        return false;
+    d = pending - applied;
+    return true;
+}
+
+void HLGraphics::release_bitmaps() const {
+    if (mholding_bitmaps) {
+        HLDevice::get().hold_bitmap_drawing(false);
+        mholding_bitmaps = false;
+    }
+}
+
+void HLGraphics::prepare_prims() const {
+    LGUI_PROFILE_COUNT(DrawCalls, 1);
+    if (!mbatching)
+        return;
+    release_bitmaps();
+    if (!mtransform_dirty)
+        return;
+    PointF d;
+    if (pending_translation_delta(d)) {
+        // Translate when recording so that the batch can continue.
+        mprims->set_batch_offset(d.x(), d.y());
+    }
+    else {
+        mprims->flush();
+        apply_pending_transform();
+    }
+}
+
+void HLGraphics::prepare_bitmaps() const {
+    LGUI_PROFILE_COUNT(DrawCalls, 1);
+    if (!mbatching)
+        return;
+    if (mprims)
+        mprims->flush();
+    if (mholding_bitmaps && !mtransform_dirty)
+        return;
+    release_bitmaps();
+    apply_pending_transform();
+    HLDevice::get().hold_bitmap_drawing(true);
+    mholding_bitmaps = true;
+}
+
+int HLGraphics::display_width() const {
+    return HLDevice::get().display_width();
+}
+
+int HLGraphics::display_height() const {
+    return HLDevice::get().display_height();
+}
+
+void HLGraphics::record_text(const char* op, float x, float y, int width, int height, lgui::Color color,
+                             const Rect* clip_rect) const {
+    float x1 = x, y1 = y, x2 = x + width, y2 = y + height;
+    if (clip_rect) {
+        x1 = std::max(x1, float(clip_rect->x1()));
+        y1 = std::max(y1, float(clip_rect->y1()));
+        x2 = std::min(x2, float(clip_rect->x2() + 1));
+        y2 = std::min(y2, float(clip_rect->y2() + 1));
+        if (x2 < x1)
+            x2 = x1;
+        if (y2 < y1)
+            y2 = y1;
+    }
+    HLDevice::get().record(HLDrawCommand::Text, op, x1, y1, x2, y2, color);
+}
+
+void HLGraphics::draw_text(const HLFont& font, float x, float y, lgui::Color color, const std::string& text) {
+    prepare_bitmaps();
+    record_text("draw_text", x, y, font.text_width(text), font.line_height(), color, nullptr);
+}
+
+void HLGraphics::draw_textr(const HLFont& font, float x, float y, lgui::Color color, const std::string& text) {
+    prepare_bitmaps();
+    int w = font.text_width(text);
+    record_text("draw_textr", x - w, y, w, font.line_height(), color, nullptr);
+}
+
+void HLGraphics::draw_textc(const HLFont& font, float x, float y, lgui::Color color, const std::string& text) {
+    prepare_bitmaps();
+    int w = font.text_width(text);
+    record_text("draw_textc", x - w / 2, y, w, font.line_height(), color, nullptr);
+}
+
+void HLGraphics::start_deferred_drawing() {
+    HLDevice::get().hold_bitmap_drawing(true);
+}
+
+void HLGraphics::end_deferred_drawing() {
+    HLDevice::get().hold_bitmap_drawing(false);
+}
+
+void HLGraphics::set_blender(Blender blender) {
+    (void) blender;
+    flush();
+}
+
+void HLGraphics::_error_shutdown() {
+}
+
+void HLGraphics::start_drawing_to_bmp(lgui::Bitmap& bmp) {
+    flush();
+    HLDevice::get().set_target(&bmp);
+}
+
+void HLGraphics::end_drawing_to_bmp(lgui::Bitmap& bmp) {
+    (void) bmp;
+    ASSERT(HLDevice::get().target() == &bmp);
+    restore_drawing_to_backbuffer();
+}
+
+void HLGraphics::end_drawing_to_bmp_perm(lgui::Bitmap& bmp) {
+    end_drawing_to_bmp(bmp);
+}
+
+void HLGraphics::restore_drawing_to_backbuffer() {
+    flush();
+    HLDevice::get().set_target(nullptr);
+}
+
+void HLGraphics::push_target(lgui::Bitmap& bmp) {
+    flush();
+    mtarget_stack.push_back(HLDevice::get().target());
+    HLDevice::get().set_target(&bmp);
+}
+
+void HLGraphics::pop_target() {
+    ASSERT(!mtarget_stack.empty());
+    flush();
+    HLDevice::get().set_target(mtarget_stack.back());
+    mtarget_stack.pop_back();
+}
+
+void HLGraphics::draw_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int flip) {
+    (void) flip;
+    prepare_bitmaps();
+    HLDevice::get().record(HLDrawCommand::Bitmap, "draw_bmp", dx, dy, dx + bitmap.w(), dy + bitmap.h(),
+                           rgb(1, 1, 1));
+}
+
+void HLGraphics::draw_tinted_bmp(const lgui::Bitmap& bitmap, int dx, int dy, lgui::Color col,
+                                 int flip) {
+    (void) flip;
+    prepare_bitmaps();
+    HLDevice::get().record(HLDrawCommand::Bitmap, "draw_tinted_bmp", dx, dy, dx + bitmap.w(), dy + bitmap.h(),
+                           col);
+}
+
+void HLGraphics::draw_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int sx, int sy,
+                                 int sw, int sh, int flip) {
+    (void) bitmap;
+    (void) sx;
+    (void) sy;
+    (void) flip;
+    prepare_bitmaps();
+    HLDevice::get().record(HLDrawCommand::Bitmap, "draw_bmp_region", dx, dy, dx + sw, dy + sh, rgb(1, 1, 1));
+}
+
+void HLGraphics::draw_tinted_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int sx, int sy,
+                                        int sw, int sh, lgui::Color col, int flip) {
+    (void) bitmap;
+    (void) sx;
+    (void) sy;
+    (void) flip;
+    prepare_bitmaps();
+    HLDevice::get().record(HLDrawCommand::Bitmap, "draw_tinted_bmp_region", dx, dy, dx + sw, dy + sh, col);
+}
+
+void HLGraphics::draw_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int dw, int dh,
+                                 int flip) const {
+    (void) bitmap;
+    (void) flip;
+    prepare_bitmaps();
+    HLDevice::get().record(HLDrawCommand::Bitmap, "draw_scaled_bmp", dx, dy, dx + dw, dy + dh, rgb(1, 1, 1));
+}
+
+void HLGraphics::draw_tinted_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int dw, int dh,
+                                        lgui::Color col, int flip) const {
+    (void) bitmap;
+    (void) flip;
+    prepare_bitmaps();
+    HLDevice::get().record(HLDrawCommand::Bitmap, "draw_tinted_scaled_bmp", dx, dy, dx + dw, dy + dh, col);
+}
+
+void HLGraphics::draw_tinted_bmp_region_rounded_corners(const Bitmap& bitmap, float dx, float dy, float sx,
+                                                        float sy, float sw, float sh, float crx, float cry,
+                                                        lgui::Color col) {
+    (void) bitmap;
+    (void) sx;
+    (void) sy;
+    ASSERT(crx > 0);
+    ASSERT(cry > 0);
+    // Drawn as a textured primitive by Allegro, which doesn't batch.
+    flush();
+    HLDevice::get().submit();
+    HLDevice::get().record(HLDrawCommand::Primitive, "draw_tinted_bmp_region_rounded_corners", dx, dy,
+                           dx + sw, dy + sh, col);
+}
+
+void HLGraphics::use_transform(const Transform& transform) {
+    flush();
+    HLDevice::get().use_transform(transform);
+    mapplied_transform = transform;
+    mpending_transform = transform;
+    mapplied_is_offset = mpending_is_offset = false;
+}
+
+void HLGraphics::draw_text_clipped_to_rect(const HLFont& font, float x, float y, lgui::Color color,
+                                           const Rect& clip_rect, const std::string& text) {
+    if (y >= clip_rect.y2())
+        return;
+    prepare_bitmaps();
+    record_text("draw_text_clipped_to_rect", x, y, font.text_width(text), font.line_height(), color, &clip_rect);
+}
+
+void HLGraphics::draw_text_run(const HLFont& font, float x, float y, lgui::Color color, const HLTextRun& run) {
+    run.shape(font);
+    prepare_bitmaps();
+    record_text("draw_text_run", x, y, run.mwidth, font.line_height(), color, nullptr);
+}
+
+void HLGraphics::draw_text_run_clipped_to_rect(const HLFont& font, float x, float y, lgui::Color color,
+                                               const Rect& clip_rect, const HLTextRun& run) {
+    if (y >= clip_rect.y2())
+        return;
+    run.shape(font);
+    prepare_bitmaps();
+    record_text("draw_text_run_clipped_to_rect", x, y, run.mwidth, font.line_height(), color, &clip_rect);
+}
+
+}
@@ -0,0 +1,180 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HL_GRAPHICS_H
+#define LGUI_HL_GRAPHICS_H
+
+#include <vector>
+
+#include "../font.h"
+#include "../textrun.h"
+#include "../color.h"
+#include "../transform.h"
+#include "hldevice.h"
+
+namespace lgui {
+
+class Bitmap;
+class HLBitmap;
+class HLPrimHelper;
+
+/** Graphics context of the headless backend: instead of drawing, it records what would be drawn on HLDevice.
+ *  Batching and targets are handled like with Allegro 5, so draw call counts are comparable. Do not use this
+ *  class directly, but rather use graphics. */
+class HLGraphics {
+    public:
+        enum Blender {
+            BLENDER_STD, BLENDER_ADD, BLENDER_MULTIPLY
+        };
+
+        HLGraphics();
+
+        HLGraphics(const HLGraphics& other) = delete;
+        HLGraphics(const HLGraphics&& other) = delete;
+        HLGraphics operator=(const HLGraphics& other) = delete;
+
+        int display_width() const;
+        int display_height() const;
+        void set_clip_rect(int x, int y, int w, int h);
+        void get_clip_rect(int& x, int& y, int& w, int& h);
+        void reset_clip_rect();
+
+        void start_drawing_to_bmp(lgui::Bitmap& bmp);
+        void end_drawing_to_bmp(lgui::Bitmap& bmp);
+        void end_drawing_to_bmp_perm(lgui::Bitmap& bmp);
+
+        void restore_drawing_to_backbuffer();
+
+        /** Make `bmp` the drawing target, remembering the current one. Transformation and clipping rectangle
+         *  are properties of the target, so they will be those of `bmp` until pop_target() is called. */
+        void push_target(lgui::Bitmap& bmp);
+        /** Make the target that was current before the last call to push_target() the target again. */
+        void pop_target();
+
+        void start_deferred_drawing();
+        void end_deferred_drawing();
+
+        void set_blender(Blender blender);
+
+        void use_transform(const Transform& transform);
+
+        /** Enable or disable batching (off by default). Batches are formed like with Allegro 5, so that the
+         *  number of draw calls is the same. */
+        void set_batching(bool batching);
+        bool is_batching() const { return mbatching; }
+
+        /** Submit everything that has been batched so far and apply the current transformation. */
+        void flush();
+
+        void clear(lgui::Color col);
+
+        void flip();
+
+        void draw_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int flip = 0);
+        void draw_tinted_bmp(const lgui::Bitmap& bitmap, int dx, int dy, lgui::Color col,
+                             int flip = 0);
+        void draw_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int sx, int sy,
+                             int sw, int sh, int flip = 0);
+        void draw_tinted_bmp_region(const lgui::Bitmap& bitmap, int dx, int dy, int sx, int sy,
+                                    int sw, int sh, lgui::Color col, int flip = 0);
+
+        void draw_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int dw, int dh, int flip = 0) const;
+
+        void draw_tinted_scaled_bmp(const lgui::Bitmap& bitmap, int dx, int dy, int dw, int dh, lgui::Color col,
+                                    int flip = 0) const;
+        void draw_tinted_bmp_region_rounded_corners(const lgui::Bitmap& bitmap, float dx, float dy,
+                                                    float sx, float sy, float sw, float sh,
+                                                    float crx, float cry, lgui::Color col);
+
+        void draw_text(const HLFont& font, float x, float y, lgui::Color color, const std::string& text);
+        void draw_textr(const HLFont& font, float x, float y, lgui::Color color, const std::string& text);
+        void draw_textc(const HLFont& font, float x, float y, lgui::Color color, const std::string& text);
+
+        /** Draw text that is clipped to a rectangle. */
+        void draw_text_clipped_to_rect(const HLFont& font, float x, float y, lgui::Color color,
+                                       const Rect& clip_rect, const std::string& text);
+
+        /** Draw a text run, shaping it for `font` first if necessary. */
+        void draw_text_run(const HLFont& font, float x, float y, lgui::Color color, const HLTextRun& run);
+        /** Draw a text run clipped to a rectangle, see draw_text_clipped_to_rect(). */
+        void draw_text_run_clipped_to_rect(const HLFont& font, float x, float y, lgui::Color color,
+                                           const Rect& clip_rect, const HLTextRun& run);
+
+        static void _error_shutdown();
+
+    protected:
+        /** Construct without accessing the display, assuming a target of w x h pixels. Used for Graphics
+         *  objects that only record. */
+        HLGraphics(int w, int h);
+
+        void set_prim_helper(HLPrimHelper* prims) { mprims = prims; }
+
+        /** Make `transform` the current transformation. When batching, it may be applied lazily by
+         *  prepare_prims() or prepare_bitmaps(). */
+        void set_transform_deferred(const Transform& transform);
+        /** Make a translation by (x, y) the current transformation. Like set_transform_deferred(), but the
+         *  matrix is only built when it actually needs to be applied. */
+        void set_translation_deferred(int x, int y);
+        /** To be called before drawing primitives via the prim helper. */
+        void prepare_prims() const;
+        /** To be called before drawing bitmaps or text. */
+        void prepare_bitmaps() const;
+
+        int moffsx, moffsy, mw, mh;
+
+    private:
+        void apply_pending_transform() const;
+        bool pending_translation_delta(PointF& d) const;
+        void release_bitmaps() const;
+        void record_text(const char* op, float x, float y, int width, int height, lgui::Color color,
+                         const Rect* clip_rect) const;
+
+        std::vector<HLBitmap*> mtarget_stack;
+        HLPrimHelper* mprims;
+        bool mbatching;
+        mutable bool mtransform_dirty, mholding_bitmaps;
+        mutable Transform mpending_transform, mapplied_transform;
+        // Set if the respective transformation is a translation by the offset (the pending matrix is not
+        // built in that case).
+        mutable bool mpending_is_offset, mapplied_is_offset;
+        mutable Point mpending_offs, mapplied_offs;
+};
+
+}
+#endif // LGUI_HL_GRAPHICS_H
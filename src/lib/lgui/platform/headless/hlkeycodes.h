@@ -0,0 +1,200 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HL_KEYCODES_H
+#define LGUI_HL_KEYCODES_H
+
+namespace lgui {
+/** Provide key codes. The headless backend uses the same values as Allegro 5, so recorded events can be
+ *  replayed with either backend. */
+
+using KeyCode = int;
+
+namespace Keycodes {
+    // No enum class, since there's nothing wrong with them decaying to int.
+    const KeyCode
+    KEY_UNDEFINED = 0,
+
+    KEY_A = 1,
+    KEY_B = 2,
+    KEY_C = 3,
+    KEY_D = 4,
+    KEY_E = 5,
+    KEY_F = 6,
+    KEY_G = 7,
+    KEY_H = 8,
+    KEY_I = 9,
+    KEY_J = 10,
+    KEY_K = 11,
+    KEY_L = 12,
+    KEY_M = 13,
+    KEY_N = 14,
+    KEY_O = 15,
+    KEY_P = 16,
+    KEY_Q = 17,
+    KEY_R = 18,
+    KEY_S = 19,
+    KEY_T = 20,
+    KEY_U = 21,
+    KEY_V = 22,
+    KEY_W = 23,
+    KEY_X = 24,
+    KEY_Y = 25,
+    KEY_Z = 26,
+
+    KEY_0 = 27,
+    KEY_1 = 28,
+    KEY_2 = 29,
+    KEY_3 = 30,
+    KEY_4 = 31,
+    KEY_5 = 32,
+    KEY_6 = 33,
+    KEY_7 = 34,
+    KEY_8 = 35,
+    KEY_9 = 36,
+
+    KEY_PAD_0 = 37,
+    KEY_PAD_1 = 38,
+    KEY_PAD_2 = 39,
+    KEY_PAD_3 = 40,
+    KEY_PAD_4 = 41,
+    KEY_PAD_5 = 42,
+    KEY_PAD_6 = 43,
+    KEY_PAD_7 = 44,
+    KEY_PAD_8 = 45,
+    KEY_PAD_9 = 46,
+
+    KEY_F1 = 47,
+    KEY_F2 = 48,
+    KEY_F3 = 49,
+    KEY_F4 = 50,
+    KEY_F5 = 51,
+    KEY_F6 = 52,
+    KEY_F7 = 53,
+    KEY_F8 = 54,
+    KEY_F9 = 55,
+    KEY_F10 = 56,
+    KEY_F11 = 57,
+    KEY_F12 = 58,
+
+    KEY_ESC     = 59,
+    KEY_TILDE   = 60,
+    KEY_MINUS   = 61,
+    KEY_EQUALS  = 62,
+    KEY_BACKSPACE  = 63,
+    KEY_TAB        = 64,
+    KEY_OPENBRACE  = 65,
+    KEY_CLOSEBRACE = 66,
+    KEY_ENTER      = 67,
+    KEY_SEMICOLON  = 68,
+    KEY_QUOTE      = 69,
+    KEY_BACKSLASH  = 70,
+    KEY_BACKSLASH2 = 71,
+    KEY_COMMA      = 72,
+    KEY_FULLSTOP   = 73,
+    KEY_SLASH      = 74,
+    KEY_SPACE      = 75,
+
+    KEY_INSERT = 76,
+    KEY_DELETE = 77,
+    KEY_HOME   = 78,
+    KEY_END    = 79,
+    KEY_PGUP   = 80,
+    KEY_PGDN   = 81,
+    KEY_LEFT   = 82,
+    KEY_RIGHT  = 83,
+    KEY_UP     = 84,
+    KEY_DOWN   = 85,
+
+    KEY_PAD_SLASH    = 86,
+    KEY_PAD_ASTERISK = 87,
+    KEY_PAD_MINUS    = 88,
+    KEY_PAD_PLUS     = 89,
+    KEY_PAD_DELETE   = 90,
+    KEY_PAD_ENTER    = 91,
+    KEY_ENTER_PAD    = 91,
+
+    KEY_PRINTSCREEN = 92,
+    KEY_PAUSE       = 93,
+
+    KEY_ABNT_C1    = 94,
+    KEY_YEN        = 95,
+    KEY_KANA       = 96,
+    KEY_CONVERT    = 97,
+    KEY_NOCONVERT  = 98,
+    KEY_AT         = 99,
+    KEY_CIRCUMFLEX = 100,
+    KEY_COLON2     = 101,
+    KEY_KANJI      = 102,
+
+    KEY_PAD_EQUALS = 103,
+    KEY_BACKQUOTE  = 104,
+    KEY_SEMICOLON2 = 105,
+    KEY_COMMAND    = 106,
+
+    // Android back key
+    KEY_BACK = 107,
+
+    KEY_LSHIFT = 215,
+    KEY_RSHIFT = 216,
+    KEY_LCTRL  = 217,
+    KEY_RCTRL  = 218,
+    KEY_ALT    = 219,
+    KEY_ALTGR  = 220,
+    KEY_LWIN   = 221,
+    KEY_RWIN   = 222,
+    KEY_MENU   = 223,
+    KEY_SCROLLLOCK = 224,
+    KEY_NUMLOCK    = 225,
+    KEY_CAPSLOCK   = 226;
+}
+
+namespace KeyModifiers {
+    // No enum class, since we need them to decay to int for bitwise ops.
+    const int
+    KEYMOD_NONE    = 0,
+    KEYMOD_SHIFT   = 0x01,
+    KEYMOD_CTRL    = 0x02,
+    KEYMOD_ALT     = 0x04,
+    KEYMOD_ALTGR   = 0x40,
+    KEYMOD_COMMAND = 0x80;
+}
+}
+
+#endif // LGUI_HL_KEYCODES_H
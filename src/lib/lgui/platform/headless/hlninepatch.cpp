@@ -0,0 +1,72 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "../ninepatch.h"
+#include "hldevice.h"
+
+namespace lgui {
+
+HLNinepatch::HLNinepatch(Bitmap& src, int offsx, int offsy, int w, int h)
+        : NinepatchBase(src, offsx, offsy, w, h) {}
+
+
+HLNinepatch::HLNinepatch(Bitmap& src)
+        : NinepatchBase(src) {}
+
+HLNinepatch::HLNinepatch(HLNinepatch&& other) noexcept
+        : NinepatchBase(std::forward<HLNinepatch>(other)) {}
+
+void HLNinepatch::draw_tinted(const lgui::Color& col, float dx, float dy, const lgui::Size& content_size) const {
+    int strw = stretch_w(content_size.w());
+    int strh = stretch_h(content_size.h());
+    float xs[4] = {dx, dx + unscaled_left_w(), dx + unscaled_left_w() + strw,
+                   dx + unscaled_left_w() + strw + unscaled_right_w()};
+    float ys[4] = {dy, dy + unscaled_top_h(), dy + unscaled_top_h() + strh,
+                   dy + unscaled_top_h() + strh + unscaled_bottom_h()};
+
+    // Corners, center and sides, one bitmap region each.
+    HLDevice& device = HLDevice::get();
+    for (int row = 0; row < 3; row++)
+        for (int col_idx = 0; col_idx < 3; col_idx++)
+            device.record(HLDrawCommand::Bitmap, "ninepatch", xs[col_idx], ys[row], xs[col_idx + 1],
+                          ys[row + 1], col);
+}
+
+
+}
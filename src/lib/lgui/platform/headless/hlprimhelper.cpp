@@ -0,0 +1,278 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include "../primhelper.h"
+#include "../error.h"
+#include "hldevice.h"
+
+namespace lgui {
+
+HLPrimHelper::HLPrimHelper()
+    : mbatching(false), mbatch_dx(0), mbatch_dy(0), mbatch_pending(false), mbatch_kind(Kind::Triangles),
+      mdraw_calls(0), mtess_max_entries(256)
+{
+}
+
+void HLPrimHelper::set_batching(bool batching)
+{
+    if (!batching)
+        flush();
+    mbatching = batching;
+}
+
+void HLPrimHelper::flush() const
+{
+    if (mbatch_pending) {
+        mdraw_calls++;
+        HLDevice::get().submit();
+        mbatch_pending = false;
+    }
+}
+
+HLPrimHelper::Kind HLPrimHelper::kind_of(lgui::PrimType type)
+{
+    switch (type) {
+        case PrimType::PRIM_POINT_LIST:
+            return Kind::Points;
+        case PrimType::PRIM_LINE_LIST:
+        case PrimType::PRIM_LINE_STRIP:
+        case PrimType::PRIM_LINE_LOOP:
+            return Kind::Lines;
+        default:
+            return Kind::Triangles;
+    }
+}
+
+void HLPrimHelper::add(Kind kind, const char* op, float x1, float y1, float x2, float y2,
+                       const lgui::Color& col, float grow) const
+{
+    if (mbatching) {
+        if (mbatch_pending && mbatch_kind != kind)
+            flush();
+        mbatch_pending = true;
+        mbatch_kind = kind;
+        x1 += mbatch_dx;
+        x2 += mbatch_dx;
+        y1 += mbatch_dy;
+        y2 += mbatch_dy;
+    }
+    else {
+        mdraw_calls++;
+        HLDevice::get().submit();
+    }
+    HLDevice::get().record(HLDrawCommand::Primitive, op, std::min(x1, x2) - grow, std::min(y1, y2) - grow,
+                           std::max(x1, x2) + grow, std::max(y1, y2) + grow, col);
+}
+
+void HLPrimHelper::rect(float x1, float y1, float x2, float y2, lgui::Color col, float thickness)
+{
+    add(outline_kind(thickness), "rect", x1, y1, x2, y2, col, thickness / 2);
+}
+
+void HLPrimHelper::filled_rect(float x1, float y1, float x2, float y2, lgui::Color col)
+{
+    add(Kind::Triangles, "filled_rect", x1, y1, x2, y2, col);
+}
+
+void HLPrimHelper::filled_triangle(float x1, float y1, float x2, float y2, float x3, float y3, lgui::Color col)
+{
+    add(Kind::Triangles, "filled_triangle", std::min({x1, x2, x3}), std::min({y1, y2, y3}),
+        std::max({x1, x2, x3}), std::max({y1, y2, y3}), col);
+}
+
+void HLPrimHelper::rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col,
+                                float thickness)
+{
+    (void) rx;
+    (void) ry;
+    add(outline_kind(thickness), "rounded_rect", x1, y1, x2, y2, col, thickness / 2);
+}
+
+void HLPrimHelper::filled_rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col)
+{
+    (void) rx;
+    (void) ry;
+    add(Kind::Triangles, "filled_rounded_rect", x1, y1, x2, y2, col);
+}
+
+void HLPrimHelper::filled_rounded_rect_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                const lgui::Color& col1, const lgui::Color& col2,
+                                                lgui::GradientDirection dir)
+{
+    (void) rx;
+    (void) ry;
+    (void) col2;
+    (void) dir;
+    add(Kind::Triangles, "filled_rounded_rect_gradient", x1, y1, x2, y2, col1);
+}
+
+void HLPrimHelper::filled_rect_gradient(float x1, float y1, float x2, float y2, const lgui::Color& col1,
+                                        const lgui::Color& col2, lgui::GradientDirection dir)
+{
+    (void) col2;
+    (void) dir;
+    add(Kind::Triangles, "filled_rect_gradient", x1, y1, x2, y2, col1);
+}
+
+void HLPrimHelper::rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
+                                             lgui::Color col, float thickness, int corners)
+{
+    (void) rx;
+    (void) ry;
+    (void) corners;
+    add(outline_kind(thickness), "rounded_rect_spec_corners", x1, y1, x2, y2, col, thickness / 2);
+}
+
+void HLPrimHelper::filled_rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                    lgui::Color color, int corners)
+{
+    (void) rx;
+    (void) ry;
+    (void) corners;
+    add(Kind::Triangles, "filled_rounded_rect_spec_corners", x1, y1, x2, y2, color);
+}
+
+void HLPrimHelper::rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry,
+                                        lgui::Color color, float thickness, lgui::OpenEdge oe)
+{
+    (void) rx;
+    (void) ry;
+    (void) oe;
+    add(outline_kind(thickness), "rounded_rect_bracket", x1, y1, x2, y2, color, thickness / 2);
+}
+
+void HLPrimHelper::rect_bracket(float x1, float y1, float x2, float y2, lgui::Color color, float thickness,
+                                lgui::OpenEdge oe)
+{
+    (void) oe;
+    add(outline_kind(thickness), "rect_bracket", x1, y1, x2, y2, color, thickness / 2);
+}
+
+void HLPrimHelper::filled_rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry,
+                                               lgui::Color color, lgui::OpenEdge oe)
+{
+    (void) rx;
+    (void) ry;
+    (void) oe;
+    add(Kind::Triangles, "filled_rounded_rect_bracket", x1, y1, x2, y2, color);
+}
+
+void HLPrimHelper::filled_rounded_rect_bracket_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                        const lgui::Color& col1, const lgui::Color& col2,
+                                                        lgui::OpenEdge oe, lgui::GradientDirection dir)
+{
+    (void) rx;
+    (void) ry;
+    (void) col2;
+    (void) oe;
+    (void) dir;
+    add(Kind::Triangles, "filled_rounded_rect_bracket_gradient", x1, y1, x2, y2, col1);
+}
+
+void HLPrimHelper::circle(float cx, float cy, float r, lgui::Color col, float thickness)
+{
+    add(outline_kind(thickness), "circle", cx - r, cy - r, cx + r, cy + r, col, thickness / 2);
+}
+
+void HLPrimHelper::filled_circle(float cx, float cy, float r, lgui::Color col)
+{
+    add(Kind::Triangles, "filled_circle", cx - r, cy - r, cx + r, cy + r, col);
+}
+
+void HLPrimHelper::line(float x1, float y1, float x2, float y2, lgui::Color col, float thickness)
+{
+    add(outline_kind(thickness), "line", x1, y1, x2, y2, col, thickness / 2);
+}
+
+void HLPrimHelper::draw_visible_pixel(float px, float py, lgui::Color col)
+{
+    add(Kind::Points, "draw_visible_pixel", px, py, px + 1, py + 1, col);
+}
+
+void HLPrimHelper::draw_filled_pieslice(float cx, float cy, float r, float start_theta, float delta_theta,
+                                        lgui::Color color)
+{
+    (void) start_theta;
+    (void) delta_theta;
+    add(Kind::Triangles, "draw_filled_pieslice", cx - r, cy - r, cx + r, cy + r, color);
+}
+
+void HLPrimHelper::draw_vertices(lgui::PrimType type, const PrimVertex* first, unsigned int start,
+                                 unsigned int end) const
+{
+    if (end <= start)
+        return;
+    float x1 = first[start].x, y1 = first[start].y, x2 = x1, y2 = y1;
+    for (unsigned int i = start + 1; i < end; i++) {
+        x1 = std::min(x1, first[i].x);
+        y1 = std::min(y1, first[i].y);
+        x2 = std::max(x2, first[i].x);
+        y2 = std::max(y2, first[i].y);
+    }
+    add(kind_of(type), "draw_vertices", x1, y1, x2, y2, first[start].color);
+}
+
+void HLPrimHelper::draw_vertices(lgui::PrimType type, const std::vector<PrimVertex>& verts, unsigned int start,
+                                 unsigned int end) const
+{
+    ASSERT(start <= verts.size() && end <= verts.size());
+    draw_vertices(type, verts.data(), start, end);
+}
+
+void HLPrimHelper::draw_vertices_indexed(lgui::PrimType type, const std::vector<PrimVertex>& verts,
+                                         const std::vector<int>& indices, unsigned int n) const
+{
+    ASSERT(n <= indices.size());
+    if (n == 0)
+        return;
+    const PrimVertex& v0 = verts[indices[0]];
+    float x1 = v0.x, y1 = v0.y, x2 = x1, y2 = y1;
+    for (unsigned int i = 1; i < n; i++) {
+        const PrimVertex& v = verts[indices[i]];
+        x1 = std::min(x1, v.x);
+        y1 = std::min(y1, v.y);
+        x2 = std::max(x2, v.x);
+        y2 = std::max(y2, v.y);
+    }
+    add(kind_of(type), "draw_vertices_indexed", x1, y1, x2, y2, v0.color);
+}
+
+}
@@ -0,0 +1,160 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HL_PRIMHELPER_H
+#define LGUI_HL_PRIMHELPER_H
+
+#include "../color.h"
+#include <vector>
+
+namespace lgui {
+
+enum class PrimType {
+        PRIM_POINT_LIST,
+        PRIM_LINE_LIST,
+        PRIM_LINE_STRIP,
+        PRIM_LINE_LOOP,
+        PRIM_TRIANGLE_LIST,
+        PRIM_TRIANGLE_STRIP,
+        PRIM_TRIANGLE_FAN
+};
+
+/** Helper recording primitives for the headless backend. Do not use directly, but use the Graphics class to
+ *  draw everything. Every shape is recorded as one command covering its bounding box (see HLDevice); nothing
+ *  is tessellated. Draw calls are counted the way the Allegro 5 helper issues them: while batching,
+ *  consecutive shapes of the same kind (points, lines, triangles) share one. */
+class HLPrimHelper {
+    public:
+        HLPrimHelper();
+
+        HLPrimHelper(const HLPrimHelper& other) = delete;
+        HLPrimHelper(const HLPrimHelper&& other) = delete;
+        HLPrimHelper operator=(const HLPrimHelper& other) = delete;
+
+        void init() {}
+
+        /** Enable or disable batching. Disabling batching flushes. */
+        void set_batching(bool batching);
+        bool is_batching() const { return mbatching; }
+
+        /** Set an offset to be added to the coordinates of all primitives batched from now on. */
+        void set_batch_offset(float dx, float dy) {
+            mbatch_dx = dx;
+            mbatch_dy = dy;
+        }
+
+        /** Submit all batched primitives. */
+        void flush() const;
+
+        /** Return the number of draw calls issued since the last call to reset_draw_calls(). */
+        int draw_calls() const { return mdraw_calls; }
+        void reset_draw_calls() { mdraw_calls = 0; }
+
+        /** There is no tessellation cache; these only exist for compatibility. */
+        void set_tessellation_cache_size(unsigned int max_entries) { mtess_max_entries = max_entries; }
+        unsigned int tessellation_cache_size() const { return mtess_max_entries; }
+        void clear_tessellation_cache() {}
+        int tessellation_cache_hits() const { return 0; }
+        int tessellation_cache_misses() const { return 0; }
+        void reset_tessellation_cache_stats() {}
+
+        void rect(float x1, float y1, float x2, float y2, lgui::Color col, float thickness);
+        void filled_rect(float x1, float y1, float x2, float y2, lgui::Color col);
+        void filled_triangle(float x1, float y1, float x2, float y2, float x3, float y3, lgui::Color col);
+        void rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col, float thickness);
+        void filled_rounded_rect(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col);
+        void filled_rounded_rect_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                          const lgui::Color& col1, const lgui::Color& col2,
+                                          lgui::GradientDirection dir);
+        void filled_rect_gradient(float x1, float y1, float x2, float y2, const lgui::Color& col1,
+                                  const lgui::Color& col2,
+                                  lgui::GradientDirection dir);
+
+        void rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color col,
+                                       float thickness, int corners);
+        void filled_rounded_rect_spec_corners(float x1, float y1, float x2, float y2, float rx, float ry,
+                                              lgui::Color color, int corners);
+        void rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry, lgui::Color color,
+                                  float thickness, lgui::OpenEdge oe);
+        void rect_bracket(float x1, float y1, float x2, float y2, lgui::Color color, float thickness,
+                          lgui::OpenEdge oe);
+
+        void filled_rounded_rect_bracket(float x1, float y1, float x2, float y2, float rx, float ry,
+                                         lgui::Color color, lgui::OpenEdge oe);
+        void filled_rounded_rect_bracket_gradient(float x1, float y1, float x2, float y2, float rx, float ry,
+                                                  const lgui::Color& col1, const lgui::Color& col2, lgui::OpenEdge oe,
+                                                  lgui::GradientDirection dir);
+
+        void circle(float cx, float cy, float r, lgui::Color col, float thickness);
+        void filled_circle(float cx, float cy, float r, lgui::Color col);
+        void line(float x1, float y1, float x2, float y2, lgui::Color col, float thickness);
+        void draw_visible_pixel(float px, float py, lgui::Color col);
+        void draw_filled_pieslice(float cx, float cy, float r, float start_theta,
+                                  float delta_theta, lgui::Color color);
+
+        void draw_vertices(lgui::PrimType type, const PrimVertex* first, unsigned int start,
+                           unsigned int end) const;
+        void draw_vertices(lgui::PrimType type, const std::vector<PrimVertex>& verts, unsigned int start,
+                           unsigned int end) const;
+
+        void draw_vertices_indexed(lgui::PrimType type, const std::vector<PrimVertex>& verts,
+                                   const std::vector<int>& indices, unsigned int n) const;
+
+    private:
+        enum class Kind {
+                Points, Lines, Triangles
+        };
+
+        static Kind kind_of(lgui::PrimType type);
+        static Kind outline_kind(float thickness) { return thickness > 0 ? Kind::Triangles : Kind::Lines; }
+
+        /** Record a shape with the given bounding box, grown by `grow` in every direction. */
+        void add(Kind kind, const char* op, float x1, float y1, float x2, float y2, const lgui::Color& col,
+                 float grow = 0) const;
+
+        bool mbatching;
+        float mbatch_dx, mbatch_dy;
+        mutable bool mbatch_pending;
+        mutable Kind mbatch_kind;
+        mutable int mdraw_calls;
+        unsigned int mtess_max_entries;
+};
+
+}
+#endif // LGUI_HL_PRIMHELPER_H
@@ -0,0 +1,114 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include "../textrun.h"
+#include "../font.h"
+#include "../utf8.h"
+
+namespace lgui {
+
+HLTextRun::HLTextRun()
+        : mfont_id(0), mwidth(0) {}
+
+HLTextRun::HLTextRun(const std::string& text)
+        : mtext(text), mfont_id(0), mwidth(0) {}
+
+void HLTextRun::set_text(const std::string& text) {
+    if (text != mtext) {
+        mtext = text;
+        mfont_id = 0;
+    }
+}
+
+void HLTextRun::shape(const HLFont& font) const {
+    if (mfont_id == font.id())
+        return;
+    mfont_id = font.id();
+    mpen.clear();
+    moffs.clear();
+
+    size_t pos = 0, offs = 0;
+    int last_cp = -1;
+    float pen = 0;
+    int cp;
+    while ((cp = utf8::get_cp_next(mtext, pos)) >= 0) {
+        mpen.push_back(pen);
+        moffs.push_back(offs);
+        if (last_cp >= 0)
+            pen += font.glyph_advance(last_cp, cp);
+        last_cp = cp;
+        offs = pos;
+    }
+    if (last_cp >= 0)
+        pen += font.glyph_advance(last_cp, -1);
+    mpen.push_back(pen);
+    moffs.push_back(mtext.size());
+    mwidth = font.text_width(mtext);
+}
+
+int HLTextRun::width(const HLFont& font) const {
+    shape(font);
+    return mwidth;
+}
+
+int HLTextRun::cp_x(const HLFont& font, size_t cp_idx) const {
+    shape(font);
+    if (cp_idx >= mpen.size())
+        cp_idx = mpen.size() - 1;
+    return mpen[cp_idx];
+}
+
+std::pair<size_t, size_t> HLTextRun::hit_char(const HLFont& font, int px) const {
+    shape(font);
+    if (px <= 0 || mtext.empty())
+        return {0, 0};
+    // First code point starting at or after px.
+    auto it = std::lower_bound(mpen.begin(), mpen.end(), float(px));
+    if (it == mpen.end())
+        return {mtext.size(), mpen.size() - 1};
+    size_t idx = it - mpen.begin();
+    // Nearer to previous character?
+    if (idx > 0 && px - mpen[idx - 1] < mpen[idx] - px)
+        idx--;
+    return {moffs[idx], idx};
+}
+
+}
@@ -0,0 +1,142 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "hltransform.h"
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES
+#include <cmath>
+#else
+#include <cmath>
+#endif
+
+namespace lgui {
+
+HLTransform HLTransform::midentity = HLTransform::create_identity();
+
+void HLTransform::set_identity() {
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            m[i][j] = (i == j) ? 1.0f : 0.0f;
+}
+
+void HLTransform::translate_pre(PointF offset) {
+    m[3][0] += m[0][0] * offset.x() + m[1][0] * offset.y();
+    m[3][1] += m[0][1] * offset.x() + m[1][1] * offset.y();
+}
+
+void HLTransform::compose_post(const HLTransform& other) {
+    float tmp[4][4];
+    for (int x = 0; x < 4; x++)
+        for (int y = 0; y < 4; y++)
+            tmp[x][y] = other.m[0][y] * m[x][0] + other.m[1][y] * m[x][1] +
+                        other.m[2][y] * m[x][2] + other.m[3][y] * m[x][3];
+    for (int x = 0; x < 4; x++)
+        for (int y = 0; y < 4; y++)
+            m[x][y] = tmp[x][y];
+}
+
+void HLTransform::compose_pre(const HLTransform& other) {
+    float tmp[4][4];
+    for (int x = 0; x < 4; x++)
+        for (int y = 0; y < 4; y++)
+            tmp[x][y] = m[0][y] * other.m[x][0] + m[1][y] * other.m[x][1] +
+                        m[2][y] * other.m[x][2] + m[3][y] * other.m[x][3];
+    for (int x = 0; x < 4; x++)
+        for (int y = 0; y < 4; y++)
+            m[x][y] = tmp[x][y];
+}
+
+bool HLTransform::is_translation() const {
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            if (i == 3 && j < 2) // X and Y translation
+                continue;
+            if (m[i][j] != (i == j ? 1.0f : 0.0f))
+                return false;
+        }
+    }
+    return true;
+}
+
+void HLTransform::set_rotation(float degrees) {
+    set_rotation_3d(0, 0, 1, degrees);
+}
+
+void HLTransform::set_rotation_3d(float x, float y, float z, float degrees) {
+    float theta = degrees / 180.0 * M_PI;
+    float c = cosf(theta), s = sinf(theta), cc = 1 - c;
+    HLTransform r = create_identity();
+    r.m[0][0] = cc * x * x + c;
+    r.m[0][1] = cc * x * y + z * s;
+    r.m[0][2] = cc * x * z - y * s;
+    r.m[1][0] = cc * x * y - z * s;
+    r.m[1][1] = cc * y * y + c;
+    r.m[1][2] = cc * z * y + x * s;
+    r.m[2][0] = cc * x * z + y * s;
+    r.m[2][1] = cc * y * z - x * s;
+    r.m[2][2] = cc * z * z + c;
+    compose_post(r);
+}
+
+void HLTransform::set_scale(PointF scale) {
+    for (int i = 0; i < 4; i++) {
+        m[i][0] *= scale.x();
+        m[i][1] *= scale.y();
+    }
+}
+
+bool HLTransform::is_invertable() const {
+    float det = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    return fabsf(det) >= 1e-7;
+}
+
+void HLTransform::invert() {
+    float det = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    float t = m[3][0];
+    m[3][0] = (m[1][0] * m[3][1] - t * m[1][1]) / det;
+    m[3][1] = (t * m[0][1] - m[0][0] * m[3][1]) / det;
+    t = m[0][0];
+    m[0][0] = m[1][1] / det;
+    m[1][1] = t / det;
+    m[0][1] = -m[0][1] / det;
+    m[1][0] = -m[1][0] / det;
+}
+
+}
@@ -0,0 +1,129 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_HLTRANSFORM_H
+#define LGUI_HLTRANSFORM_H
+
+#include "lgui/lgui_types.h"
+
+namespace lgui {
+
+/** Transformation of the headless backend. Stores a 4x4 matrix laid out like ALLEGRO_TRANSFORM and does the
+ *  same math as Allegro 5, so widgets behave the same with both backends. Do not use this class directly, but
+ *  rather use Transformation. */
+class HLTransform {
+    public:
+        /** Set this transformation to be the identity transformation. */
+        void set_identity();
+
+        /** Modify the translation component of this transformation. Translation will happen last. */
+        void translate_post(PointF offset) {
+            m[3][0] += offset.x();
+            m[3][1] += offset.y();
+        }
+
+        /** Modify the translation component  of this transformation. Translation will happen last. */
+        void translate_post(PointF offset, float z_offset) {
+            translate_post(offset);
+            m[3][2] += z_offset;
+        }
+
+        /** Contrary to translate_post, this function will add a translation that will occurr first. */
+        void translate_pre(PointF offset);
+
+        /** Set the rotation around the Z axis. */
+        void set_rotation(float degrees);
+        /** Set a rotation around the vector given. */
+        void set_rotation_3d(float unit_x, float unit_y, float unit_z, float degrees);
+        /** Set the X and Y scale of this transformation. */
+        void set_scale(PointF scale);
+
+        /** Add the transformation that is passed so that it will happen after the current transformation. */
+        void compose_post(const HLTransform& other);
+
+        /** Add the transformation that is passed so that it will happen before the current transformation. */
+        void compose_pre(const HLTransform& other);
+
+        /** Map a 2D point. */
+        PointF map(PointF p) const {
+            return {m[0][0] * p.x() + m[1][0] * p.y() + m[3][0],
+                    m[0][1] * p.x() + m[1][1] * p.y() + m[3][1]};
+        }
+
+        /** Return whether the transformation is a pure 2D translation. */
+        bool is_translation() const;
+
+        /** Return the translation component of the transformation. */
+        PointF translation() const {
+            return {m[3][0], m[3][1]};
+        }
+
+        /** Return whether the transformation is invertable. Like Allegro, only the 2D part is considered. */
+        bool is_invertable() const;
+
+        /** Return the inverse transformation. */
+        HLTransform get_inverse() const {
+            HLTransform t(*this);
+            t.invert();
+            return t;
+        }
+
+        /** Invert the transformation. Like Allegro, this assumes a 2D transformation. */
+        void invert();
+
+        /** Get a (static) identity transformation. */
+        static const HLTransform& get_identity() {
+            return midentity;
+        }
+
+        /** Return an identity transformation. */
+        static HLTransform create_identity() {
+            HLTransform t;
+            t.set_identity();
+            return t;
+        }
+
+    private:
+        float m[4][4];
+        static HLTransform midentity;
+};
+
+}
+
+#endif //LGUI_HLTRANSFORM_H
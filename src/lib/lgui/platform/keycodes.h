@@ -40,6 +40,10 @@
 #ifndef LGUI_KEYCODES_H
 #define LGUI_KEYCODES_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlkeycodes.h"
+#else
 #include "a5/a5keycodes.h"
+#endif
 
 #endif // LGUI_KEYCODES_H
@@ -40,12 +40,21 @@
 #ifndef LGUI_NINEPATCH_H
 #define LGUI_NINEPATCH_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlninepatch.h"
+
+namespace lgui {
+using NinepatchImplementation = HLNinepatch;
+}
+#else
 #include "a5/a5ninepatch.h"
 
 namespace lgui {
 using NinepatchImplementation = A5Ninepatch;
 }
+#endif
 
+#include "drawlistreplayer.h"
 
 namespace lgui {
 class Graphics;
@@ -56,7 +65,8 @@ class Graphics;
  * and 4 not being stretched at all (corners). 9-patch images as used here have
  * another rectangle that specifies the fill area, i.e. where the content should go.
  *
- * Use the methods of the Graphics class to draw NinePatch images.
+ * Use the methods of the Graphics class to draw NinePatch images. Destroying a nine-patch waits until no draw
+ * list that may reference it is replayed on another thread anymore (see RenderThread).
 */
 class NinePatch : public NinepatchImplementation {
     public:
@@ -69,6 +79,8 @@ class NinePatch : public NinepatchImplementation {
         NinePatch(NinePatch&& other)
                 : NinepatchImplementation(std::forward<NinePatch>(other)) {}
 
+        ~NinePatch() { dtl::wait_for_draw_list_replayers(); }
+
 };
 
 }
@@ -64,10 +64,18 @@ struct PrimVertex {
 };
 }
 
+#ifdef LGUI_HEADLESS
+#include "headless/hlprimhelper.h"
+#else
 #include "a5/a5primhelper.h"
+#endif
 
 namespace lgui {
+#ifdef LGUI_HEADLESS
+using PrimHelperImplementation = HLPrimHelper;
+#else
 using PrimHelperImplementation = A5PrimHelper;
+#endif
 
 /** Helper for drawing primitives using a platform specific backend.
  *  Do not use this directly, but rather use the Graphics object to draw everything.
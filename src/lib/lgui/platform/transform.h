@@ -40,6 +40,15 @@
 #ifndef LGUI_TRANSFORM_H
 #define LGUI_TRANSFORM_H
 
+#ifdef LGUI_HEADLESS
+#include "headless/hltransform.h"
+
+namespace lgui {
+
+using Transform = HLTransform;
+
+}
+#else
 #include "a5/a5transform.h"
 
 namespace lgui {
@@ -47,5 +56,6 @@ namespace lgui {
 using Transform = A5Transform;
 
 }
+#endif
 
 #endif // LGUI_TRANSFORM_H
@@ -0,0 +1,248 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <ostream>
+#include "lgui/platform/error.h"
+
+namespace lgui {
+
+std::unique_ptr<Profiler> Profiler::minstance;
+
+static const int DEFAULT_FRAME_CAPACITY = 240;
+
+Profiler& Profiler::instance() {
+    if (!minstance)
+        minstance.reset(new Profiler());
+    return *minstance;
+}
+
+Profiler::Profiler()
+        : mnext_frame(0), mframes_recorded(0),
+          mepoch_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now().time_since_epoch()).count()),
+          menabled(true), mthread(std::this_thread::get_id()) {
+    mframes.resize(DEFAULT_FRAME_CAPACITY);
+    reset_frame(mcurrent, 0);
+    mcurrent.number = 0;
+}
+
+uint64_t Profiler::now_us() const {
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    return (ns - mepoch_ns) / 1000;
+}
+
+void Profiler::reset_frame(Frame& frame, uint64_t start_us) {
+    frame.start_us = frame.end_us = start_us;
+    std::fill(frame.counters, frame.counters + NoCounters, 0);
+    frame.zones.clear(); // keeps the capacity
+}
+
+void Profiler::set_frame_capacity(int frames) {
+    ASSERT(frames > 0);
+    mframes.clear();
+    mframes.resize(frames);
+    mnext_frame = mframes_recorded = 0;
+}
+
+void Profiler::next_frame() {
+    if (!menabled)
+        return;
+    uint64_t now = now_us();
+    mcurrent.end_us = now;
+    // Zones still open won't be closed in this frame: drop them (their durations would be bogus).
+    if (!mopen_zones.empty()) {
+        mcurrent.zones.resize(mopen_zones.front());
+        mopen_zones.clear();
+    }
+    // Swap into the ring so the zone vectors are reused instead of reallocated.
+    std::swap(mframes[mnext_frame], mcurrent);
+    uint64_t number = mframes[mnext_frame].number + 1;
+    mnext_frame = (mnext_frame + 1) % mframes.size();
+    mframes_recorded = std::min(mframes_recorded + 1, int(mframes.size()));
+    reset_frame(mcurrent, now);
+    mcurrent.number = number;
+}
+
+void Profiler::begin_zone(const char* name) {
+    if (!menabled)
+        return;
+    mopen_zones.push_back(mcurrent.zones.size());
+    mcurrent.zones.push_back(Zone{name, now_us(), 0, uint32_t(mopen_zones.size() - 1)});
+}
+
+void Profiler::end_zone() {
+    if (!menabled || mopen_zones.empty())
+        return; // begun before a new frame or while disabled
+    Zone& z = mcurrent.zones[mopen_zones.back()];
+    mopen_zones.pop_back();
+    z.duration_us = uint32_t(now_us() - z.start_us);
+}
+
+const Profiler::Frame& Profiler::frame(int idx) const {
+    ASSERT(idx >= 0 && idx < mframes_recorded);
+    int n = mframes.size();
+    return mframes[(mnext_frame - mframes_recorded + idx + n) % n];
+}
+
+std::map<std::string, Profiler::ZoneStats> Profiler::zone_stats() const {
+    std::map<std::string, ZoneStats> stats;
+    for (int i = 0; i < mframes_recorded; i++) {
+        for (const Zone& z : frame(i).zones) {
+            ZoneStats& s = stats[z.name];
+            double ms = z.duration_us / 1000.0;
+            s.calls++;
+            s.total_ms += ms;
+            s.max_ms = std::max(s.max_ms, ms);
+        }
+    }
+    return stats;
+}
+
+double Profiler::average_count(Counter counter) const {
+    if (mframes_recorded == 0)
+        return 0.0;
+    double sum = 0.0;
+    for (int i = 0; i < mframes_recorded; i++)
+        sum += frame(i).counters[counter];
+    return sum / mframes_recorded;
+}
+
+double Profiler::average_frame_ms() const {
+    if (mframes_recorded == 0)
+        return 0.0;
+    double sum = 0.0;
+    for (int i = 0; i < mframes_recorded; i++)
+        sum += frame(i).duration_ms();
+    return sum / mframes_recorded;
+}
+
+double Profiler::max_frame_ms() const {
+    double m = 0.0;
+    for (int i = 0; i < mframes_recorded; i++)
+        m = std::max(m, frame(i).duration_ms());
+    return m;
+}
+
+void Profiler::clear() {
+    for (Frame& f : mframes)
+        reset_frame(f, 0);
+    mnext_frame = mframes_recorded = 0;
+}
+
+const char* Profiler::counter_name(Counter counter) {
+    switch (counter) {
+        case DrawCalls:
+            return "draw_calls";
+        case WidgetsDrawn:
+            return "widgets_drawn";
+        case WidgetsMeasured:
+            return "widgets_measured";
+        case LayoutPasses:
+            return "layout_passes";
+        case SignalEmissions:
+            return "signal_emissions";
+        case AnimationsUpdated:
+            return "animations_updated";
+        case DrawListCommands:
+            return "draw_list_commands";
+        case DrawListsRecorded:
+            return "draw_lists_recorded";
+        default:
+            return "?";
+    }
+}
+
+static void write_json_string(std::ostream& os, const char* str) {
+    os << '"';
+    for (const char* c = str; *c; c++) {
+        switch (*c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) >= 0x20)
+                    os << *c;
+                break;
+        }
+    }
+    os << '"';
+}
+
+void Profiler::write_chrome_trace(std::ostream& os) const {
+    // Frames on thread 1, zones on thread 2, so the frame events don't interfere with the zones' nesting.
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"frames\"}},\n";
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"lgui\"}}";
+    for (int i = 0; i < mframes_recorded; i++) {
+        const Frame& f = frame(i);
+        os << ",\n{\"name\":\"frame " << f.number << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << f.start_us
+           << ",\"dur\":" << (f.end_us - f.start_us) << "}";
+        for (const Zone& z : f.zones) {
+            os << ",\n{\"name\":";
+            write_json_string(os, z.name);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":" << z.start_us << ",\"dur\":" << z.duration_us << "}";
+        }
+        os << ",\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << f.start_us << ",\"args\":{";
+        for (int c = 0; c < NoCounters; c++) {
+            if (c > 0)
+                os << ",";
+            os << "\"" << counter_name(Counter(c)) << "\":" << f.counters[c];
+        }
+        os << "}}";
+    }
+    os << "\n]}\n";
+}
+
+bool Profiler::write_chrome_trace(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file)
+        return false;
+    write_chrome_trace(file);
+    return bool(file);
+}
+
+}
@@ -0,0 +1,195 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_PROFILER_H
+#define LGUI_PROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <iosfwd>
+#include <memory>
+#include <thread>
+
+namespace lgui {
+
+/** Records where the time of each frame goes: scoped timings ("zones", e.g. drawing, layout, timer tick
+ *  distribution) and counters (draw calls, widgets drawn, ...), kept per frame in a ring buffer holding the
+ *  most recent frames. A frame starts with each call of GUI::draw_widgets().
+ *
+ *  The library is only instrumented if it has been compiled with `LGUI_ENABLE_PROFILING` defined (CMake
+ *  option `LGUI_PROFILING`); otherwise the LGUI_PROFILE_* macros expand to nothing and nothing is recorded.
+ *  The macros can be used in application code as well. Recording can additionally be paused at runtime.
+ *  The profiler is not thread-safe: only record from the GUI thread. Counts from other threads than the one
+ *  that first used the profiler (e.g. from a RenderThread) are ignored.
+ */
+class Profiler {
+    public:
+        enum Counter {
+            DrawCalls,         /**< primitive, bitmap and text drawing operations issued to the backend */
+            WidgetsDrawn,      /**< widgets drawn (i.e. not culled) */
+            WidgetsMeasured,   /**< measure() calls by layouts that weren't answered from the measure cache */
+            LayoutPasses,      /**< widgets relaid out by the GUI */
+            SignalEmissions,   /**< Signal::emit() calls */
+            AnimationsUpdated, /**< animation updates */
+            DrawListCommands,  /**< commands replayed from recorded draw lists (see DrawList) */
+            DrawListsRecorded, /**< widgets cached as draw lists that had to be recorded again, i.e. whose
+                                    draw() methods have been run (see Widget::set_cache_as_draw_list()) */
+            NoCounters
+        };
+
+        /** A timed scope. */
+        struct Zone {
+            const char* name;
+            uint64_t start_us; /**< relative to the profiler's creation */
+            uint32_t duration_us;
+            uint32_t depth;    /**< nesting depth, 0 for outermost zones */
+        };
+
+        struct Frame {
+            uint64_t number = 0;
+            uint64_t start_us = 0, end_us = 0;
+            uint64_t counters[NoCounters] = {};
+            std::vector<Zone> zones; /**< in order of their start */
+
+            double duration_ms() const { return (end_us - start_us) / 1000.0; }
+        };
+
+        /** Aggregated timings of all zones with the same name. */
+        struct ZoneStats {
+            uint64_t calls = 0;
+            double total_ms = 0.0, max_ms = 0.0;
+
+            double average_ms() const { return calls > 0 ? total_ms / calls : 0.0; }
+        };
+
+        static Profiler& instance();
+
+        /** Pause or resume recording at runtime. Recording is on by default. */
+        void set_enabled(bool enabled) { menabled = enabled; }
+        bool is_enabled() const { return menabled; }
+
+        /** Set the number of frames kept. Clears the recorded frames. The default is 240. */
+        void set_frame_capacity(int frames);
+        int frame_capacity() const { return mframes.size(); }
+
+        /** Finish the current frame and start a new one. Called by GUI::draw_widgets(). Zones still open are
+         *  not recorded. */
+        void next_frame();
+
+        void begin_zone(const char* name);
+        void end_zone();
+        void count(Counter counter, uint64_t n = 1) {
+            if (menabled && std::this_thread::get_id() == mthread)
+                mcurrent.counters[counter] += n;
+        }
+
+        /** Return the number of completed frames available, at most frame_capacity(). */
+        int frames_recorded() const { return mframes_recorded; }
+        /** Return a completed frame; 0 is the oldest one available, frames_recorded() - 1 the latest. */
+        const Frame& frame(int idx) const;
+
+        /** Return the stats of all zones over the recorded frames, by name. */
+        std::map<std::string, ZoneStats> zone_stats() const;
+        /** Return the average of a counter per recorded frame. */
+        double average_count(Counter counter) const;
+        /** Return the average and maximum duration of the recorded frames. */
+        double average_frame_ms() const;
+        double max_frame_ms() const;
+
+        /** Drop all recorded frames. */
+        void clear();
+
+        /** Write the recorded frames as Chrome trace event JSON (to be loaded into chrome://tracing or
+         *  Perfetto): zones as complete events, frames as events on a separate track and counters as counter
+         *  events. */
+        void write_chrome_trace(std::ostream& os) const;
+        /** Write a Chrome trace to a file. Return false if the file couldn't be written. */
+        bool write_chrome_trace(const std::string& filename) const;
+
+        static const char* counter_name(Counter counter);
+
+    private:
+        Profiler();
+
+        uint64_t now_us() const;
+        void reset_frame(Frame& frame, uint64_t start_us);
+
+        std::vector<Frame> mframes; // ring buffer
+        int mnext_frame, mframes_recorded;
+        Frame mcurrent;
+        std::vector<int> mopen_zones; // indices into mcurrent.zones
+        uint64_t mepoch_ns;
+        bool menabled;
+        std::thread::id mthread;
+
+        static std::unique_ptr<Profiler> minstance;
+};
+
+/** Times the enclosing scope as a zone of the Profiler. Use LGUI_PROFILE_SCOPE(). */
+class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name) { Profiler::instance().begin_zone(name); }
+        ~ProfileScope() { Profiler::instance().end_zone(); }
+
+        ProfileScope(const ProfileScope& other) = delete;
+        ProfileScope& operator=(const ProfileScope& other) = delete;
+};
+
+}
+
+#define LGUI_PROFILE_CONCAT2(a, b) a##b
+#define LGUI_PROFILE_CONCAT(a, b) LGUI_PROFILE_CONCAT2(a, b)
+
+#ifdef LGUI_ENABLE_PROFILING
+/** Time the rest of the enclosing scope as a zone named `name`, which must be a string literal (or outlive the
+ *  Profiler). */
+#define LGUI_PROFILE_SCOPE(name) ::lgui::ProfileScope LGUI_PROFILE_CONCAT(_lgui_profile_scope_, __LINE__)(name)
+/** Add `n` to one of the Profiler's counters, e.g. LGUI_PROFILE_COUNT(DrawCalls, 1). */
+#define LGUI_PROFILE_COUNT(counter, n) ::lgui::Profiler::instance().count(::lgui::Profiler::counter, n)
+/** Start a new frame. */
+#define LGUI_PROFILE_FRAME() ::lgui::Profiler::instance().next_frame()
+#else
+#define LGUI_PROFILE_SCOPE(name) do {} while (0)
+#define LGUI_PROFILE_COUNT(counter, n) do {} while (0)
+#define LGUI_PROFILE_FRAME() do {} while (0)
+#endif
+
+#endif // LGUI_PROFILER_H
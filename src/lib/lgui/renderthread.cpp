@@ -0,0 +1,182 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include "renderthread.h"
+#include "gui.h"
+#include "lgui/platform/error.h"
+#include "lgui/platform/events.h"
+
+namespace lgui {
+
+RenderThread::RenderThread()
+        : mback(&mframes[0]), mpending(&mframes[1]), mfront(&mframes[2]), mhas_pending(false), mstop(false),
+          mrendering(false),
+          mrecording_gfx(Graphics::RecordOnly(), Size()), mclear_color(rgb(0, 0, 0)), mbatching(false) {}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start(const std::function<void()>& on_start, const std::function<void()>& on_stop) {
+    ASSERT(!is_running());
+    mstop = false;
+    mhas_pending = false;
+    mstats = RenderLatencyStats();
+    mdisplay_size = Size();
+    dtl::add_draw_list_replayer(*this);
+    mthread = std::thread(&RenderThread::run, this, on_start, on_stop);
+}
+
+void RenderThread::stop() {
+    if (!is_running())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mmutex);
+        mstop = true;
+    }
+    mcondition.notify_one();
+    midle_condition.notify_all();
+    mthread.join();
+    dtl::remove_draw_list_replayer(*this);
+}
+
+void RenderThread::wait_until_replayed() {
+    std::unique_lock<std::mutex> lock(mmutex);
+    if (std::this_thread::get_id() == mthread_id)
+        return;
+    // Once stopping, a pending frame won't be rendered anymore.
+    midle_condition.wait(lock, [this] { return !mrendering && (!mhas_pending || mstop); });
+}
+
+bool RenderThread::submit_frame(GUI& gui) {
+    ASSERT(is_running());
+    double event_timestamp = gui.undrawn_event_timestamp();
+    Size display_size;
+    {
+        std::lock_guard<std::mutex> lock(mmutex);
+        display_size = mdisplay_size;
+    }
+    if (display_size.w() > 0 && display_size.h() > 0)
+        mrecording_gfx.begin_recording(mback->list, Rect(Point(), display_size));
+    else
+        mrecording_gfx.begin_recording(mback->list);
+    bool drawn = gui.draw_widgets(mrecording_gfx);
+    mrecording_gfx.end_recording();
+    if (!drawn)
+        return false;
+    mback->event_timestamp = event_timestamp;
+    {
+        std::lock_guard<std::mutex> lock(mmutex);
+        if (mhas_pending) {
+            // Replaced before being rendered: the events it has reflected are reflected by the new one, too.
+            mstats.frames_dropped++;
+            double dropped_timestamp = mpending->event_timestamp;
+            if (dropped_timestamp >= 0 && (event_timestamp < 0 || dropped_timestamp < event_timestamp))
+                mback->event_timestamp = dropped_timestamp;
+        }
+        std::swap(mback, mpending);
+        mhas_pending = true;
+    }
+    mcondition.notify_one();
+    return true;
+}
+
+RenderLatencyStats RenderThread::stats() const {
+    std::lock_guard<std::mutex> lock(mmutex);
+    return mstats;
+}
+
+void RenderThread::reset_stats() {
+    std::lock_guard<std::mutex> lock(mmutex);
+    mstats = RenderLatencyStats();
+}
+
+void RenderThread::run(const std::function<void()>& on_start, const std::function<void()>& on_stop) {
+    {
+        std::lock_guard<std::mutex> lock(mmutex);
+        mthread_id = std::this_thread::get_id();
+    }
+    if (on_start)
+        on_start();
+    {
+        Graphics gfx;
+        gfx.set_batching(mbatching);
+        {
+            std::lock_guard<std::mutex> lock(mmutex);
+            mdisplay_size = Size(gfx.display_width(), gfx.display_height());
+        }
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mmutex);
+                mcondition.wait(lock, [this] { return mhas_pending || mstop; });
+                if (mstop)
+                    break;
+                std::swap(mfront, mpending);
+                mhas_pending = false;
+                mrendering = true;
+            }
+            gfx.clear(mclear_color);
+            mfront->list.replay(gfx);
+            gfx.flip();
+            double now = get_time();
+            Size display_size(gfx.display_width(), gfx.display_height());
+
+            std::unique_lock<std::mutex> lock(mmutex);
+            mrendering = false;
+            mdisplay_size = display_size;
+            mstats.frames_rendered++;
+            if (mfront->event_timestamp >= 0) {
+                double latency = now - mfront->event_timestamp;
+                mstats.latency_samples++;
+                mstats.last_latency = latency;
+                mstats.max_latency = std::max(mstats.max_latency, latency);
+                mstats.total_latency += latency;
+            }
+            lock.unlock();
+            midle_condition.notify_all();
+        }
+    }
+    if (on_stop)
+        on_stop();
+}
+
+}
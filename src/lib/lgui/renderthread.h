@@ -0,0 +1,156 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_RENDERTHREAD_H
+#define LGUI_RENDERTHREAD_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "lgui/platform/color.h"
+#include "lgui/platform/drawlist.h"
+#include "lgui/platform/drawlistreplayer.h"
+#include "lgui/platform/graphics.h"
+
+namespace lgui {
+
+class GUI;
+
+/** Statistics collected by a RenderThread. Latencies are measured from the timestamp of the earliest
+ *  external event reflected in a frame (see GUI::undrawn_event_timestamp()) to the flip of that frame, in
+ *  seconds on the clock of get_time(). */
+struct RenderLatencyStats {
+    int frames_rendered = 0;     /**< frames replayed and flipped */
+    int frames_dropped = 0;      /**< snapshots replaced by a newer one before they could be rendered */
+    int latency_samples = 0;     /**< rendered frames that have reflected at least one external event */
+    double last_latency = 0.0;   /**< latency of the last of these frames */
+    double max_latency = 0.0;    /**< maximum latency */
+    double total_latency = 0.0;  /**< sum of all latencies */
+
+    double mean_latency() const { return latency_samples > 0 ? total_latency / latency_samples : 0.0; }
+};
+
+/** Draws the GUI on a thread of its own, so that a slow frame doesn't delay handling events and a slow
+ *  layout doesn't delay drawing.
+ *
+ *  The GUI thread handles events and layout as usual, but calls submit_frame() instead of
+ *  GUI::draw_widgets(). This records the widgets into a DrawList, an immutable snapshot of the frame
+ *  (geometry, colors, text), using a recording-only Graphics. Widgets outside of the display, as of the last
+ *  frame rendered, aren't recorded. The render thread replays the latest snapshot
+ *  and flips; a snapshot replaced by a newer one before the render thread could get to it is dropped. The
+ *  GUI thread records into one buffer while the render thread replays another one, so they never wait for
+ *  each other, except for handing over a snapshot.
+ *
+ *  The bitmaps, fonts and nine-patches referenced by a snapshot are used by the render thread while the GUI
+ *  thread goes on. Destroying one of them blocks until the frames submitted so far have been rendered, so
+ *  they may be freed at any time; they mustn't be moved or changed (e.g. drawn to) while a frame is pending,
+ *  though. Fonts are used by both threads: the GUI thread measures and shapes text, the render thread draws
+ *  it. The Allegro 5 backend serializes the lookups into a font's glyph cache with a mutex of the font and
+ *  only renders glyphs when drawing, i.e. on the render thread. Widgets cached as layers
+ *  (Widget::set_cache_as_layer()) are drawn directly, since layers need the backend. With damage tracking
+ *  enabled, a frame is only recorded if something has been damaged; it always contains everything, though.
+ *
+ *  With the Allegro 5 backend, the display must not be current on the GUI thread, but has to be made current
+ *  on the render thread by the `on_start` callback passed to start(). */
+class RenderThread : private dtl::DrawListReplayer {
+    public:
+        /** Create the render thread object; the thread isn't started yet. */
+        RenderThread();
+        /** Stop the thread if it is still running. */
+        ~RenderThread();
+
+        RenderThread(const RenderThread& other) = delete;
+        RenderThread& operator=(const RenderThread& other) = delete;
+
+        /** Start the thread. `on_start` is called on it before its Graphics object is created, `on_stop` after
+         *  it has been destroyed, e.g. to make the display current and to release it again. */
+        void start(const std::function<void()>& on_start = nullptr,
+                   const std::function<void()>& on_stop = nullptr);
+        /** Stop the thread after it has rendered the frame it is rendering, if any. */
+        void stop();
+        bool is_running() const { return mthread.joinable(); }
+
+        /** Set the color the display is cleared to before each frame. The default is black. Call before
+         *  start(). */
+        void set_clear_color(Color col) { mclear_color = col; }
+        /** Set whether the render thread's Graphics batches primitives. Call before start(). */
+        void set_batching(bool batching) { mbatching = batching; }
+
+        /** Record a snapshot of `gui` and hand it over to the render thread. Call this on the GUI thread
+         *  instead of GUI::draw_widgets(). Return whether a snapshot has been submitted, which is always the
+         *  case unless damage tracking is enabled and nothing has been damaged. */
+        bool submit_frame(GUI& gui);
+
+        /** Return the statistics collected since start() or the last call to reset_stats(). */
+        RenderLatencyStats stats() const;
+        void reset_stats();
+
+    private:
+        void run(const std::function<void()>& on_start, const std::function<void()>& on_stop);
+        void wait_until_replayed() override;
+
+        struct Frame {
+            DrawList list;
+            double event_timestamp; // negative if the frame doesn't reflect any event
+        };
+
+        Frame mframes[3];
+        Frame* mback;    // being recorded by the GUI thread
+        Frame* mpending; // the latest snapshot, waiting for the render thread
+        Frame* mfront;   // being rendered
+        bool mhas_pending, mstop, mrendering;
+        Graphics mrecording_gfx; // used by the GUI thread
+
+        Color mclear_color;
+        bool mbatching;
+        RenderLatencyStats mstats;
+        Size mdisplay_size; // as of the last frame rendered, to cull the next snapshot
+
+        mutable std::mutex mmutex;
+        std::condition_variable mcondition;
+        std::condition_variable midle_condition; // signalled when a frame has been rendered
+        std::thread mthread;
+        std::thread::id mthread_id; // set by the thread itself
+};
+
+}
+
+#endif // LGUI_RENDERTHREAD_H
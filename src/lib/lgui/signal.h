@@ -43,6 +43,7 @@
 #include <functional>
 #include <list>
 #include "lgui/platform/error.h"
+#include "lgui/profiler.h"
 #include <cstdint>
 
 namespace lgui {
@@ -187,9 +188,13 @@ class Signal {
             mnext_id = 1; // Can reuse them.
         }
 
+        /** Return whether any slots are connected. Can be used to avoid preparing expensive arguments. */
+        bool has_slots() const { return !mslots.empty(); }
+
         /** Emit the signal. */
         template<typename... Args>
         void emit(Args&& ... args) {
+            LGUI_PROFILE_COUNT(SignalEmissions, 1);
             if (mneed_cleanup)
                 cleanup();
             if (!mis_emitting) {
@@ -42,6 +42,7 @@
 
 #include "styleargs.h"
 #include "lgui/platform/color.h"
+#include "lgui/platform/textrun.h"
 
 namespace lgui {
 
@@ -109,18 +110,35 @@ class AbstractStyle {
                                        const std::string& text) const = 0;
 
         /** Return the minimum size a push button should occupy using the given font and label. */
-        virtual Size get_push_button_min_size(const Font& font, const std::string& text) const = 0;
+        virtual Size get_push_button_min_size(const Font& font, const TextRun& text) const = 0;
         /** Draw a push button. */
         virtual void draw_push_button(Graphics& gfx, const StyleArgs& args,
-                                      const std::string& text) const = 0;
+                                      const TextRun& text) const = 0;
+        /** Same as above, shaping the label on every call. Widgets only call the TextRun overloads, so
+         *  styles have to override those. */
+        virtual Size get_push_button_min_size(const Font& font, const std::string& text) const {
+            return get_push_button_min_size(font, TextRun(text));
+        }
+        virtual void draw_push_button(Graphics& gfx, const StyleArgs& args, const std::string& text) const {
+            draw_push_button(gfx, args, TextRun(text));
+        }
 
         /** Return the height of an item in a string list view widget using the specified font. */
         virtual int get_string_list_item_height(const Font& font) const = 0;
         /** Return the width of an item in a string list view widget. */
-        virtual int get_string_list_item_width(const Font& font, const std::string& str) const = 0;
+        virtual int get_string_list_item_width(const Font& font, const TextRun& str) const = 0;
         /** Draw an item of a string list widget. */
         virtual void draw_string_list_item(Graphics& gfx, const StyleArgs& args, int indent,
-                                           const std::string& str) const = 0;
+                                           const TextRun& str) const = 0;
+        /** Same as above, shaping the item on every call. Widgets only call the TextRun overloads, so
+         *  styles have to override those. */
+        virtual int get_string_list_item_width(const Font& font, const std::string& str) const {
+            return get_string_list_item_width(font, TextRun(str));
+        }
+        virtual void draw_string_list_item(Graphics& gfx, const StyleArgs& args, int indent,
+                                           const std::string& str) const {
+            draw_string_list_item(gfx, args, indent, TextRun(str));
+        }
 
         /** Return the padding for a list widget. */
         virtual Padding get_list_padding() const = 0;
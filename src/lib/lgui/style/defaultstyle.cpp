@@ -235,26 +235,26 @@ void DefaultStyle::draw_radio_button(Graphics& gfx, const StyleArgs& args,
                   col(DSE::DispText, args.state, args.opacity), text);
 }
 
-Size DefaultStyle::get_push_button_min_size(const Font& font, const std::string& text) const {
-    return Size(2 * PUSH_BUTTON_PADDING_X + font.text_width(text), 2 * PUSH_BUTTON_PADDING_Y + font.line_height());
+Size DefaultStyle::get_push_button_min_size(const Font& font, const TextRun& text) const {
+    return Size(2 * PUSH_BUTTON_PADDING_X + text.width(font), 2 * PUSH_BUTTON_PADDING_Y + font.line_height());
 }
 
-void DefaultStyle::draw_push_button(Graphics& gfx, const StyleArgs& args, const std::string& text) const {
+void DefaultStyle::draw_push_button(Graphics& gfx, const StyleArgs& args, const TextRun& text) const {
     draw_button_bg(gfx, args.rect, args.state, args.opacity);
-    gfx.draw_text(args.font, PUSH_BUTTON_PADDING_X, PUSH_BUTTON_PADDING_Y,
-                  col(DSE::ButtonText, args.state, args.opacity), text);
+    gfx.draw_text_run(args.font, PUSH_BUTTON_PADDING_X, PUSH_BUTTON_PADDING_Y,
+                      col(DSE::ButtonText, args.state, args.opacity), text);
 }
 
 int DefaultStyle::get_string_list_item_height(const Font& font) const {
     return font.line_height() + 2 * DEFAULT_PADDING;
 }
 
-int DefaultStyle::get_string_list_item_width(const Font& font, const std::string& str) const {
-    return font.text_width(str) + 2 * DEFAULT_PADDING;
+int DefaultStyle::get_string_list_item_width(const Font& font, const TextRun& str) const {
+    return str.width(font) + 2 * DEFAULT_PADDING;
 }
 
 void DefaultStyle::draw_string_list_item(Graphics& gfx, const StyleArgs& args,
-                                         int indent, const std::string& str) const {
+                                         int indent, const TextRun& str) const {
     // indent is negative -> default
     if (indent < 0)
         indent = DEFAULT_PADDING;
@@ -266,8 +266,8 @@ void DefaultStyle::draw_string_list_item(Graphics& gfx, const StyleArgs& args,
         bg_col = col(DSE::WidgetFillBg, args.state, args.opacity);
 
     gfx.filled_rect(args.rect, bg_col);
-    gfx.draw_text(args.font, args.rect.x() + indent, args.rect.y() + DEFAULT_PADDING,
-                  col(DSE::EditText, args.state, args.opacity), str);
+    gfx.draw_text_run(args.font, args.rect.x() + indent, args.rect.y() + DEFAULT_PADDING,
+                      col(DSE::EditText, args.state, args.opacity), str);
 }
 
 Padding DefaultStyle::get_list_padding() const {
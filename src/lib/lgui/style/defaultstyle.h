@@ -92,14 +92,18 @@ class DefaultStyle : public Style {
         void draw_radio_button(Graphics& gfx, const StyleArgs& args,
                                const std::string& text) const override;
 
-        Size get_push_button_min_size(const Font& font, const std::string& text) const override;
+        using Style::get_push_button_min_size;
+        using Style::draw_push_button;
+        Size get_push_button_min_size(const Font& font, const TextRun& text) const override;
         void draw_push_button(Graphics& gfx, const StyleArgs& args,
-                              const std::string& text) const override;
+                              const TextRun& text) const override;
 
         int get_string_list_item_height(const Font& font) const override;
-        int get_string_list_item_width(const Font& font, const std::string& str) const override;
+        using Style::get_string_list_item_width;
+        using Style::draw_string_list_item;
+        int get_string_list_item_width(const Font& font, const TextRun& str) const override;
         void draw_string_list_item(Graphics& gfx, const StyleArgs& args, int indent,
-                                   const std::string& str) const override;
+                                   const TextRun& str) const override;
         Padding get_list_padding() const override;
 
         Padding get_list_box_padding() const override;
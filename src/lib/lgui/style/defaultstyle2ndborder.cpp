@@ -123,16 +123,16 @@ void DefaultStyle2ndBorder::draw_scroll_bar_handle(Graphics& gfx, const StyleArg
     gfx.rect(args.rect.shrunk(1), col(DSE::ScrollBarHandleBorder, args.state, args.opacity), 1);
 }
 
-Size lgui::DefaultStyle2ndBorder::get_push_button_min_size(const Font& font, const std::string& text) const {
-    return Size(2 * PUSH_BUTTON_PADDING_X + font.text_width(text),
+Size lgui::DefaultStyle2ndBorder::get_push_button_min_size(const Font& font, const TextRun& text) const {
+    return Size(2 * PUSH_BUTTON_PADDING_X + text.width(font),
                 2 * (PUSH_BUTTON_PADDING_Y + 1) + font.line_height());
 }
 
 
-void DefaultStyle2ndBorder::draw_push_button(Graphics& gfx, const StyleArgs& args, const std::string& text) const {
+void DefaultStyle2ndBorder::draw_push_button(Graphics& gfx, const StyleArgs& args, const TextRun& text) const {
     draw_button_bg(gfx, args.rect, args.state, args.opacity);
-    gfx.draw_text(args.font, PUSH_BUTTON_PADDING_X, PUSH_BUTTON_PADDING_Y + 1,
-                  col(DSE::ButtonText, args.state, args.opacity), text);
+    gfx.draw_text_run(args.font, PUSH_BUTTON_PADDING_X, PUSH_BUTTON_PADDING_Y + 1,
+                      col(DSE::ButtonText, args.state, args.opacity), text);
 }
 
 
@@ -56,9 +56,11 @@ class DefaultStyle2ndBorder : public DefaultStyle {
         void draw_text_field_fg(Graphics& gfx, const StyleArgs& args) const override;
         void draw_scroll_bar_handle(Graphics& gfx, const StyleArgs& args, bool horizontal) const override;
 
-        Size get_push_button_min_size(const Font& font, const std::string& text) const override;
+        using DefaultStyle::get_push_button_min_size;
+        using DefaultStyle::draw_push_button;
+        Size get_push_button_min_size(const Font& font, const TextRun& text) const override;
 
-        void draw_push_button(Graphics& gfx, const StyleArgs& args, const std::string& text) const override;
+        void draw_push_button(Graphics& gfx, const StyleArgs& args, const TextRun& text) const override;
 
         Padding get_tab_padding() const override;
         void draw_tab(Graphics& gfx, const StyleArgs& args, const Padding& padding,
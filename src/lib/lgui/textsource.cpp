@@ -0,0 +1,184 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "textsource.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "lgui/platform/error.h"
+
+namespace lgui {
+
+std::string TextSource::substr(uint64_t offs, size_t n) const {
+    uint64_t sz = size();
+    if (offs >= sz)
+        return std::string();
+    n = size_t(std::min<uint64_t>(n, sz - offs));
+    if (const char* d = data())
+        return std::string(d + offs, n);
+    std::string s(n, '\0');
+    s.resize(read(offs, n, &s[0]));
+    return s;
+}
+
+MappedFileTextSource::MappedFileTextSource()
+        : mdata(nullptr), msize(0), mopen(false)
+#ifdef _WIN32
+        , mfile_handle(nullptr), mmapping_handle(nullptr)
+#endif
+{}
+
+MappedFileTextSource::MappedFileTextSource(const std::string& filename)
+        : MappedFileTextSource() {
+    open(filename);
+}
+
+MappedFileTextSource::~MappedFileTextSource() {
+    close();
+}
+
+size_t MappedFileTextSource::read(uint64_t offs, size_t n, char* dest) const {
+    if (offs >= msize)
+        return 0;
+    n = size_t(std::min<uint64_t>(n, msize - offs));
+    std::memcpy(dest, mdata + offs, n);
+    return n;
+}
+
+#ifdef _WIN32
+
+bool MappedFileTextSource::open(const std::string& filename) {
+    close();
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        warning("Could not open file \"%s\" for mapping.", filename.c_str());
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    mfile_handle = file;
+    msize = uint64_t(size.QuadPart);
+    mopen = true;
+    if (msize == 0) // cannot map empty files
+        return true;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+        mmapping_handle = mapping;
+        mdata = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!mdata) {
+        warning("Could not map file \"%s\".", filename.c_str());
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFileTextSource::close() {
+    if (mdata)
+        UnmapViewOfFile(mdata);
+    if (mmapping_handle)
+        CloseHandle(mmapping_handle);
+    if (mfile_handle)
+        CloseHandle(mfile_handle);
+    mdata = nullptr;
+    mmapping_handle = mfile_handle = nullptr;
+    msize = 0;
+    mopen = false;
+}
+
+#else
+
+bool MappedFileTextSource::open(const std::string& filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        warning("Could not open file \"%s\" for mapping.", filename.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    msize = uint64_t(st.st_size);
+    mopen = true;
+    if (msize == 0) { // cannot map empty files
+        ::close(fd);
+        return true;
+    }
+    void* p = mmap(nullptr, size_t(msize), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        warning("Could not map file \"%s\".", filename.c_str());
+        msize = 0;
+        mopen = false;
+        return false;
+    }
+    madvise(p, size_t(msize), MADV_SEQUENTIAL);
+    mdata = static_cast<const char*>(p);
+    return true;
+}
+
+void MappedFileTextSource::close() {
+    if (mdata)
+        munmap(const_cast<char*>(mdata), size_t(msize));
+    mdata = nullptr;
+    msize = 0;
+    mopen = false;
+}
+
+#endif
+
+}
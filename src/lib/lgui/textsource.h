@@ -0,0 +1,103 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_TEXTSOURCE_H
+#define LGUI_TEXTSOURCE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace lgui {
+
+/** Read-only source of UTF-8 text, for displaying large documents without loading them into memory. See
+ *  TextBox::set_source(). Derive from this class and implement size() and read() to provide text in chunks,
+ *  e.g. from a stream or a compressed file. Sources having the whole text in memory should also implement
+ *  data() to avoid copying. */
+class TextSource {
+    public:
+        virtual ~TextSource() = default;
+
+        /** Return the size of the text in bytes. */
+        virtual uint64_t size() const = 0;
+
+        /** Copy up to `n` bytes starting at byte offset `offs` to `dest`. Return the number of bytes copied.
+         *  It may be called from several threads at the same time (see TextBox::set_source()). */
+        virtual size_t read(uint64_t offs, size_t n, char* dest) const = 0;
+
+        /** Return a pointer to the whole text if it is contiguously available in memory, nullptr otherwise. */
+        virtual const char* data() const { return nullptr; }
+
+        /** Return up to `n` bytes starting at byte offset `offs` as a string. */
+        std::string substr(uint64_t offs, size_t n) const;
+};
+
+/** A TextSource memory-mapping a file. The operating system pages the file in on demand and may evict it
+ *  again, so memory usage doesn't grow with the file size. */
+class MappedFileTextSource : public TextSource {
+    public:
+        MappedFileTextSource();
+        explicit MappedFileTextSource(const std::string& filename);
+        ~MappedFileTextSource() override;
+
+        MappedFileTextSource(const MappedFileTextSource& other) = delete;
+        MappedFileTextSource& operator=(const MappedFileTextSource& other) = delete;
+
+        /** Map the file, closing any file mapped before. Returns false if the file couldn't be mapped. */
+        bool open(const std::string& filename);
+        void close();
+        bool is_open() const { return mopen; }
+
+        uint64_t size() const override { return msize; }
+        size_t read(uint64_t offs, size_t n, char* dest) const override;
+        const char* data() const override { return mdata; }
+
+    private:
+        const char* mdata;
+        uint64_t msize;
+        bool mopen;
+#ifdef _WIN32
+        void* mfile_handle;
+        void* mmapping_handle;
+#endif
+};
+
+}
+
+#endif // LGUI_TEXTSOURCE_H
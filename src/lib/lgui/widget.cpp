@@ -37,6 +37,8 @@
 * THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cmath>
+
 #include "widget.h"
 #include "lgui/internal/focusmanager.h"
 #include "lgui/platform/error.h"
@@ -48,20 +50,27 @@
 #include "focusevent.h"
 #include "iwidgetlistener.h"
 #include "layout/layouttransition.h"
+#include "internal/widgetlayer.h"
+#include "internal/widgetdrawlist.h"
+#include "profiler.h"
 
 namespace lgui {
 
 const Style* Widget::mdefault_style = nullptr;
 EventFilter* Widget::mdefault_filter = nullptr;
+bool Widget::mmeasure_cache_enabled = true;
+MeasureCacheStats Widget::mmeasure_cache_stats;
 
 Widget::Widget()
         : mflags(0), mparent(nullptr), mfocus_manager(nullptr),
           mgui(nullptr), mfilter(nullptr), mfocus_child(nullptr),
           mstyle(nullptr), mfont(nullptr), mopacity(1.0f), mfade_opacity(1.0f), mtimer_skip_ticks_mod(1),
-          mlayout_transition(nullptr) {
+          mlayout_transition(nullptr), mvisual_bounds_valid(false) {
+    mtransformation._set_owner(this);
 }
 
 Widget::~Widget() {
+    invalidate_placement();
     if (mparent)
         mparent->child_about_to_die(*this);
     if (mfocus_manager)
@@ -75,25 +84,63 @@ void Widget::draw(const DrawEvent& de) const {
 }
 
 void Widget::draw_child(const Widget& c, const DrawEvent& parent_de) {
+    // Cull children that wouldn't be visible anyway without touching the transformation stack. Unclipped
+    // children may draw outside of their rect, and so may their children, so their visual bounds are used.
+    // Transformed ones are only culled if they are clipped.
+    bool visible;
     if (c.transformation().is_identity())
-        parent_de.gfx().push_draw_area(c.rect(), c.is_clipped());
+        visible = parent_de.gfx().is_area_visible(c.visual_bounds().translated(c.rect().pos()));
+    else
+        visible = !c.is_clipped() || parent_de.gfx().is_area_visible(c.rect(), c.transformation().get_transform());
+    if (!visible) {
+        parent_de.gfx()._increment_culled_count();
+        return;
+    }
+    LGUI_PROFILE_COUNT(WidgetsDrawn, 1);
+    if (c.transformation().is_identity())
+        parent_de.gfx().push_draw_area(c.rect(), c.is_clipped(), c.visual_bounds());
     else
         parent_de.gfx().push_draw_area(c.rect(), c.transformation().get_transform(), c.is_clipped());
 
-    c.draw(DrawEvent(parent_de.gfx(), c.is_disabled() || parent_de.draw_disabled(),
-                     c.effective_opacity() * parent_de.opacity()));
+    DrawEvent de(parent_de.gfx(), c.is_disabled() || parent_de.draw_disabled(),
+                 c.effective_opacity() * parent_de.opacity());
+    if (c.mlayer)
+        c.mlayer->draw(c, de);
+    else if (c.mdraw_list)
+        c.mdraw_list->draw(c, de);
+    else
+        c.draw(de);
     parent_de.gfx().pop_draw_area();
 }
 
 void Widget::set_size(Size s) {
     lgui::Size old_size = mrect.size();
+    bool changed = s != old_size;
+    if (changed) {
+        invalidate();
+        // The default measure() depends on the size.
+        invalidate_measure_cache();
+    }
     mrect.set_size(s);
+    if (changed) {
+        invalidate();
+        if (mparent)
+            mparent->_child_placement_changed(*this);
+    }
     resized(old_size);
     _emit_size_changed();
 }
 
 void Widget::set_pos(Position p) {
+    bool changed = p != mrect.pos();
+    if (changed)
+        invalidate_placement();
     mrect.set_pos(p);
+    if (changed) {
+        invalidate_placement();
+        if (mparent)
+            mparent->_child_placement_changed(*this);
+    }
     _emit_pos_changed();
 }
 
@@ -129,6 +176,13 @@ void Widget::layout(const Rect& r) {
 }
 
 void Widget::request_layout() {
+    invalidate();
+    // Even if no layout process will be scheduled, remembered measure results may not be used anymore.
+    invalidate_measure_cache();
+    forward_layout_request();
+}
+
+void Widget::forward_layout_request() {
     if (layout_in_progress() || (layout_transition() && layout_transition()->is_transition_in_progress()))
         return;
 
@@ -143,13 +197,41 @@ void Widget::request_layout() {
         return;
     }
     if (parent() && parent()->has_layout())
-        parent()->request_layout();
+        parent()->forward_layout_request();
     else {
         if (!is_layout_scheduling_suppressed())
             mgui->_request_layout(*this);
     }
 }
 
+MeasureResults Widget::measure_cached(SizeConstraint wc, SizeConstraint hc) {
+    if (!mmeasure_cache_enabled) {
+        LGUI_PROFILE_COUNT(WidgetsMeasured, 1);
+        return measure(wc, hc);
+    }
+    MeasureResults result;
+    if (mmeasure_cache.lookup(wc, hc, result)) {
+        mmeasure_cache_stats.hits++;
+        return result;
+    }
+    mmeasure_cache_stats.misses++;
+    LGUI_PROFILE_COUNT(WidgetsMeasured, 1);
+    result = measure(wc, hc);
+    mmeasure_cache.store(wc, hc, result);
+    return result;
+}
+
+void Widget::invalidate_measure_cache() {
+    // The ancestors have to go too: their results depend on this widget's. Can't stop at an empty cache,
+    // since not every widget's measure() will measure all of its children.
+    for (Widget* w = this; w; w = w->mparent)
+        w->mmeasure_cache.clear();
+}
+
+void Widget::set_measure_cache_enabled(bool enabled) {
+    mmeasure_cache_enabled = enabled;
+}
+
 void Widget::_relayout() {
     if (needs_relayout()) {
         // Remeasure
@@ -162,6 +244,7 @@ void Widget::_relayout() {
 void Widget::set_active(bool active) {
     if (active != is_active()) {
         set_unset_flag(Flags::Inactive, !active);
+        invalidate();
         if (!active) {
             if (mfocus_manager)
                 mfocus_manager->widget_became_inactive(*this);
@@ -175,11 +258,13 @@ void Widget::set_disabled(bool disabled) {
     if (disabled != is_disabled()) {
         set_unset_flag(Flags::Disabled, disabled);
         set_active(!disabled);
+        invalidate();
     }
 }
 
 void Widget::_set_gone() {
     if (visibility() != Gone) {
+        invalidate_placement();
         set_unset_flag(Flags::_Visibility1, true);
         set_unset_flag(Flags::_Visibility2, true);
         request_layout();
@@ -194,6 +279,7 @@ void Widget::_set_gone() {
 void Widget::set_visibility(Visibility v) {
     Visibility oldv = visibility();
     if (oldv != v) {
+        invalidate_placement();
         bool gone_changed = (oldv == Gone);
         if (v == Invisible || v == Gone) {
             if (v == Gone) {
@@ -302,14 +388,23 @@ void Widget::configure_new_child(Widget& child) {
     child.mparent = this;
     ConfigInfo ci{this->mfocus_manager, this->mgui};
     child._recursive_configure(ci);
+    child.invalidate_placement();
 }
 
 void Widget::configure_child_to_be_removed(Widget& child) {
+    child.invalidate_placement();
     ConfigInfo ci{nullptr, nullptr};
     child._recursive_configure(ci);
     child.mparent = nullptr;
 }
 
+void Widget::visit_children(const std::function<void(const Widget& child)>& f) const {
+    const_cast<Widget*>(this)->visit_down([this, &f](Widget& w) {
+        if (w.mparent == this)
+            f(w);
+    });
+}
+
 // no children, reimplement for children
 Widget* Widget::get_child_at(PointF) {
     return nullptr;
@@ -324,6 +419,90 @@ void Widget::invalidate_under_mouse() {
         mgui->set_under_mouse_invalid();
 }
 
+void Widget::invalidate() {
+    invalidate_rect(visual_rect());
+}
+
+void Widget::invalidate_rect(const Rect& r) {
+    if (mlayer)
+        mlayer->invalidate();
+    if (mdraw_list)
+        mdraw_list->invalidate();
+    invalidate_area(r);
+}
+
+void Widget::invalidate_placement() {
+    invalidate_area(visual_bounds());
+}
+
+Rect Widget::visual_rect() const {
+    if (is_clipped())
+        return size_rect();
+    int o = visual_overflow();
+    return Rect(-o, -o, width() + 2 * o, height() + 2 * o);
+}
+
+Rect Widget::visual_bounds() const {
+    if (is_clipped())
+        return size_rect();
+    if (!mvisual_bounds_valid) {
+        Rect bounds = visual_rect();
+        visit_children([&bounds](const Widget& c) {
+            Rect r = c.visual_bounds();
+            PointF corners[4] = {PointF(r.x(), r.y()), PointF(r.x() + r.w(), r.y()),
+                                 PointF(r.x(), r.y() + r.h()), PointF(r.x() + r.w(), r.y() + r.h())};
+            float x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+            for (int i = 0; i < 4; i++) {
+                PointF p = c.map_to_parent(corners[i]);
+                x1 = i == 0 ? p.x() : std::min(x1, p.x());
+                y1 = i == 0 ? p.y() : std::min(y1, p.y());
+                x2 = i == 0 ? p.x() : std::max(x2, p.x());
+                y2 = i == 0 ? p.y() : std::max(y2, p.y());
+            }
+            int ix1 = int(std::floor(x1)), iy1 = int(std::floor(y1));
+            bounds = bounds.united(Rect(ix1, iy1, int(std::ceil(x2)) - ix1, int(std::ceil(y2)) - iy1));
+        });
+        mvisual_bounds = bounds;
+        mvisual_bounds_valid = true;
+    }
+    return mvisual_bounds;
+}
+
+void Widget::invalidate_area(const Rect& r) {
+    mvisual_bounds_valid = false;
+    for (Widget* p = mparent; p != nullptr; p = p->mparent) {
+        p->mvisual_bounds_valid = false;
+        if (p->mlayer)
+            p->mlayer->invalidate();
+        if (p->mdraw_list)
+            p->mdraw_list->invalidate();
+    }
+    if (mgui && mgui->is_damage_tracking_enabled())
+        mgui->_add_damage(map_rect_to_absolute(r));
+}
+
+void Widget::set_cache_as_layer(bool cache) {
+    if (cache && !mlayer)
+        mlayer = std::make_unique<dtl::WidgetLayer>();
+    else if (!cache && mlayer)
+        mlayer.reset();
+    invalidate_placement();
+}
+
+void Widget::set_cache_as_draw_list(bool cache) {
+    if (cache && !mdraw_list)
+        mdraw_list = std::make_unique<dtl::WidgetDrawList>();
+    else if (!cache && mdraw_list)
+        mdraw_list.reset();
+    invalidate_placement();
+}
+
+void Widget::_handle_transformation_change() {
+    invalidate_placement();
+    if (mparent)
+        mparent->_child_placement_changed(*this);
+}
+
 void Widget::close_popup() {
     if (mgui)
         mgui->pop_top_widget();
@@ -356,6 +535,7 @@ void Widget::set_style(const Style* style) {
     if (mstyle != style) {
         mstyle = style;
         style_changed();
+        invalidate();
     }
 }
 
@@ -424,6 +604,11 @@ void Widget::_emit_child_added(Widget& child) {
         wl->child_added_wl(*this, child);
 }
 
+void Widget::_emit_children_added(const std::vector<Widget*>& children) {
+    for (auto wl : mwidget_listeners)
+        wl->children_added_wl(*this, children);
+}
+
 void Widget::_emit_child_removed(Widget& child) {
     for (auto wl : mwidget_listeners)
         wl->child_removed_wl(*this, child);
@@ -497,6 +682,24 @@ Position Widget::get_absolute_position() const {
     return pos.to_point();
 }
 
+Rect Widget::map_rect_to_absolute(const Rect& r) const {
+    PointF corners[4] = {PointF(r.x(), r.y()), PointF(r.x() + r.w(), r.y()),
+                         PointF(r.x(), r.y() + r.h()), PointF(r.x() + r.w(), r.y() + r.h())};
+    for (const Widget* w = this; w != nullptr; w = w->parent()) {
+        for (PointF& c : corners)
+            c = w->map_to_parent(c);
+    }
+    float x1 = corners[0].x(), y1 = corners[0].y(), x2 = x1, y2 = y1;
+    for (const PointF& c : corners) {
+        x1 = std::min(x1, c.x());
+        y1 = std::min(y1, c.y());
+        x2 = std::max(x2, c.x());
+        y2 = std::max(y2, c.y());
+    }
+    int ix1 = int(std::floor(x1)), iy1 = int(std::floor(y1));
+    return Rect(ix1, iy1, int(std::ceil(x2)) - ix1, int(std::ceil(y2)) - iy1);
+}
+
 Rect Widget::get_absolute_rect() const {
     const Widget* w = this;
     ASSERT(w);
@@ -564,6 +767,8 @@ bool Widget::send_mouse_event(MouseEvent& event) {
             // error
             break;
     }
+    if (event.has_been_consumed())
+        invalidate();
     return event.has_been_consumed();
 }
 
@@ -588,6 +793,7 @@ void Widget::send_focus_event(FocusEvent& event) {
         default:
             break; // error
     }
+    invalidate();
 }
 
 bool Widget::send_dragdrop_event(DragDropEvent& event) {
@@ -614,6 +820,8 @@ bool Widget::send_dragdrop_event(DragDropEvent& event) {
         default:
             break; // error
     }
+    if (event.has_been_consumed())
+        invalidate();
     return event.has_been_consumed();
 }
 
@@ -636,6 +844,8 @@ bool Widget::send_key_event(KeyEvent& event) {
             // error
             break;
     }
+    if (event.has_been_consumed())
+        invalidate();
     return event.has_been_consumed();
 }
 
@@ -41,14 +41,17 @@
 #define LGUI_WIDGET_H
 
 #include <forward_list>
+#include <memory>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "lgui_layout_utils.h"
 #include "ieventlistener.h"
 #include "ilayoutelement.h"
 #include "widgettransformation.h"
+#include "internal/measurecache.h"
 
 namespace lgui {
 class EventFilter;
@@ -64,6 +67,8 @@ class AnimationFacilities;
 namespace dtl {
 class EventHandlerBase;
 class FocusManager;
+class WidgetLayer;
+class WidgetDrawList;
 }
 
 
@@ -140,6 +145,10 @@ class Widget : public IEventListener, public ILayoutElement {
          *  with children so that all children are visited */
         virtual void visit_down(const std::function<void(Widget& w)>& f) { f(*this); }
 
+        /** Call `f` for each direct child. The default implementation picks them out of visit_down(); widgets
+         *  with children can reimplement this to go through them directly. */
+        virtual void visit_children(const std::function<void(const Widget& child)>& f) const;
+
         /** Test all parents, going up the hierarchy recursively, whether w is among them.
          *  Also tests widget itself, i.e. `(this==w)` will `return true`. */
         bool is_child_of_recursive(const Widget* w) const;
@@ -196,7 +205,8 @@ class Widget : public IEventListener, public ILayoutElement {
          *  until it finds the top widget or a widget having a parent with no layout, which it will register
          *  with the GUI for deferred relayouting, setting Flags::NeedsRelayout on the way up. It will return
          *  immediately when the flag is already set. Apart from that, it will also never trigger a layout process when
-         *  one is currently in progress. */
+         *  one is currently in progress. The widget is invalidated as well (see invalidate()), since whatever has
+         *  changed its measurements will most likely change its looks, too. */
         void request_layout();
 
         /** Actually trigger a layout process. You shouldn't call this directly. Use request_layout()
@@ -205,6 +215,24 @@ class Widget : public IEventListener, public ILayoutElement {
          *  children. */
         void _relayout();
 
+        /** Measure the widget like measure(), but return a remembered result if the widget has already been
+         *  measured with the same constraints and nothing has changed since. This is what layouts call for their
+         *  children. The remembered results are dropped by request_layout() and by size changes, on the widget
+         *  and all its ancestors, so widgets must call request_layout() whenever measure() would return
+         *  different values (as they have to anyway). */
+        MeasureResults measure_cached(SizeConstraint wc, SizeConstraint hc);
+
+        /** Drop the remembered measure results of the widget and its ancestors. */
+        void invalidate_measure_cache();
+
+        /** Globally enable or disable the use of remembered measure results (enabled by default). */
+        static void set_measure_cache_enabled(bool enabled);
+        static bool is_measure_cache_enabled() { return mmeasure_cache_enabled; }
+
+        /** Return the hit and miss counts of measure_cached() since the last reset. */
+        static const MeasureCacheStats& measure_cache_stats() { return mmeasure_cache_stats; }
+        static void reset_measure_cache_stats() { mmeasure_cache_stats = MeasureCacheStats(); }
+
         /** Returns true when the widget has a layout. */
         virtual bool has_layout() const { return false; }
 
@@ -254,7 +282,10 @@ class Widget : public IEventListener, public ILayoutElement {
 
         /** Return the opacity of the widget. This is intended to be "stable", use the fade opacity for animation effects. */
         void set_opacity(float opacity) {
-            mopacity = opacity;
+            if (mopacity != opacity) {
+                mopacity = opacity;
+                invalidate_placement();
+            }
         }
 
         /** Return the fade opacity of the widget. This is intended for animations. */
@@ -264,7 +295,10 @@ class Widget : public IEventListener, public ILayoutElement {
 
         /** Set fade opacity of the widget. This is intended for animations. */
         void set_fade_opacity(float fade_opacity) {
-            mfade_opacity = fade_opacity;
+            if (mfade_opacity != fade_opacity) {
+                mfade_opacity = fade_opacity;
+                invalidate_placement();
+            }
         }
 
         /** Change the style of the widget. This will (usually) also recursively change the
@@ -289,6 +323,7 @@ class Widget : public IEventListener, public ILayoutElement {
         virtual void set_font(const Font* font) {
             mfont = font;
             request_layout();
+            invalidate();
         }
 
         /** Install an EventFilter on the widget. You can only register one event filter per widget. The
@@ -338,6 +373,48 @@ class Widget : public IEventListener, public ILayoutElement {
          *  an overhead, however, so don't call for every mouse move event. */
         void invalidate_under_mouse();
 
+        /** Mark the whole widget (i.e. its visual_rect()) as needing to be redrawn. This only has an effect if the widget is added to
+         *  a GUI that has damage tracking enabled. Most state changes (rect, visibility, style, opacity, input
+         *  events handled, timer ticks) already do this automatically; call it whenever the widget's
+         *  appearance changes for other reasons. This also invalidates the layers cached by the widget and its
+         *  parents.
+         *  @see GUI::set_damage_tracking, set_cache_as_layer */
+        void invalidate();
+
+        /** Mark a part of the widget, given in widget coordinates, as needing to be redrawn.
+         *  @see invalidate */
+        void invalidate_rect(const Rect& r);
+
+        /** Return the bounding box of `r`, given in widget coordinates, mapped to absolute coordinates.
+         *  Contrary to get_absolute_rect(), this takes transformations into account, but does not clip to the
+         *  parents' areas. */
+        Rect map_rect_to_absolute(const Rect& r) const;
+
+        /** Enable or disable caching the widget as a layer. If enabled, the widget and its children will be
+         *  rendered into an offscreen bitmap once, which is then drawn instead on subsequent frames until
+         *  something inside the widget changes (see invalidate()). Moving the widget or changing its opacity or
+         *  transformation does not require rendering it again. This is worthwhile for complex, but rarely
+         *  changing widgets. A widget cached as a layer will always be clipped to its rectangle. */
+        void set_cache_as_layer(bool cache);
+
+        /** Return whether the widget is cached as a layer. @see set_cache_as_layer */
+        bool is_cached_as_layer() const { return mlayer != nullptr; }
+
+        /** Enable or disable caching the widget's drawing commands. If enabled, the drawing commands issued by
+         *  the widget and its children are recorded into a DrawList once, which is then replayed on
+         *  subsequent frames instead of calling draw() until something inside the widget changes (see
+         *  invalidate()). Contrary to set_cache_as_layer(), the result is drawn exactly as without caching,
+         *  also when the widget is scaled by a transformation, and no bitmap is needed; the primitives are
+         *  still drawn every frame, though. Moving the widget or changing its opacity or transformation does
+         *  not require recording it again. If the widget is also cached as a layer, the layer is used. */
+        void set_cache_as_draw_list(bool cache);
+
+        /** Return whether the widget's drawing commands are cached. @see set_cache_as_draw_list */
+        bool is_cached_as_draw_list() const { return mdraw_list != nullptr; }
+
+        /** Called by the widget's WidgetTransformation before and after it changes. */
+        void _handle_transformation_change();
+
         /** Return the GUI's animation facilities. Can be used to create animations which will be owned by the GUI's
          * animation context. Only available if widget is added to a GUI. */
          AnimationFacilities& animate() const;
@@ -438,6 +515,22 @@ class Widget : public IEventListener, public ILayoutElement {
         /** Return whether the widget will be drawn with clipping enabled. */
         bool is_clipped() const { return is_flag_set(Flags::ClipMe); }
 
+        /** Return the area the widget may draw to in widget coordinates. For clipped widgets, that's
+         *  size_rect(). Unclipped widgets may draw outside of their rect, so it is grown by visual_overflow()
+         *  on each side for them. Used for culling and for damage tracking. */
+        Rect visual_rect() const;
+
+        /** Return the area the widget and all of its children may draw to in widget coordinates. For clipped
+         *  widgets, that's visual_rect(); otherwise, the visual bounds of the children (which may be placed
+         *  anywhere) are added. The result is cached until the widget or one of its children is invalidated.
+         *  Used for culling and for damage tracking. */
+        Rect visual_bounds() const;
+
+        /** Return by how many pixels the widget may draw outside of its rect if it isn't clipped, e.g. for
+         *  outlines, focus indicators or shadows. The default covers the outlines drawn by the default
+         *  styles; override this for widgets that draw further outside. */
+        virtual int visual_overflow() const { return 2; }
+
         /** Return whether the widget is located outside its parent's children
          *  area. I.e. its position is relative to its parent position, not the position
          *  of the parent's children area. */
@@ -510,14 +603,20 @@ class Widget : public IEventListener, public ILayoutElement {
 
         /** Change whether the widget shall be drawn with clipping enabled. */
         void set_clipped(bool clipme) {
+            invalidate_placement();
             set_unset_flag(Flags::ClipMe, clipme);
+            invalidate_placement();
         }
 
         /** Change whether the widget should be considered to be located outside its parent's children area.
          * Its position is then relative to its parent's position, not the position of the children area of
          * its parent. */
         void set_outside_children_area(bool outside) {
+            invalidate_placement();
             set_unset_flag(Flags::ChildOutsideChildrenArea, outside);
+            invalidate_placement();
+            if (mparent)
+                mparent->_child_placement_changed(*this);
         }
 
         /** Change whether the widget shall be able to receive focus. */
@@ -551,7 +650,10 @@ class Widget : public IEventListener, public ILayoutElement {
 
         /** This is called by the GUI to facilitate keeping track of being hovered. */
         void set_hovered(bool hovered) {
-            set_unset_flag(Flags::Hovered, hovered);
+            if (hovered != is_hovered()) {
+                set_unset_flag(Flags::Hovered, hovered);
+                invalidate();
+            }
         }
 
         /** This is set to indicate the widget needs to be laid out. You normally don't need to call this
@@ -683,6 +785,9 @@ class Widget : public IEventListener, public ILayoutElement {
         /** Emits a child added event to widget listeners. */
         void _emit_child_added(Widget& child);
 
+        /** Emits one event for several children added at once to widget listeners. */
+        void _emit_children_added(const std::vector<Widget*>& children);
+
         /** Emits a child removed devent to widget listeners. */
         void _emit_child_removed(Widget& child);
 
@@ -695,9 +800,19 @@ class Widget : public IEventListener, public ILayoutElement {
         virtual void _bring_child_to_front(Widget& child) { (void) child; }
         virtual void _send_child_to_back(Widget& child) { (void) child; }
 
+        /** Called when a child's position, size or transformation has changed. */
+        virtual void _child_placement_changed(Widget& child) { (void) child; }
+
     private:
         void set_focus_manager(dtl::FocusManager* focus_mngr);
 
+        /** Like invalidate(), but for changes that don't affect the widget's contents (e.g. its position or
+         *  opacity): a layer cached by the widget itself stays valid. */
+        void invalidate_placement();
+        void invalidate_area(const Rect& r);
+        /** The part of request_layout() that is forwarded to the parents. */
+        void forward_layout_request();
+
         bool is_flag_set(Flags flag) const { return mflags & flag; }
         void set_unset_flag(Flags flag, bool unset_set) {
             if (unset_set)
@@ -720,9 +835,16 @@ class Widget : public IEventListener, public ILayoutElement {
         float mopacity, mfade_opacity;
         int mtimer_skip_ticks_mod;
         LayoutTransition* mlayout_transition;
+        std::unique_ptr<dtl::WidgetLayer> mlayer;
+        std::unique_ptr<dtl::WidgetDrawList> mdraw_list;
+        dtl::MeasureCache mmeasure_cache;
+        mutable Rect mvisual_bounds;
+        mutable bool mvisual_bounds_valid;
 
         static EventFilter* mdefault_filter;
         static const Style* mdefault_style;
+        static bool mmeasure_cache_enabled;
+        static MeasureCacheStats mmeasure_cache_stats;
 };
 
 }
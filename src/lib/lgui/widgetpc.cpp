@@ -57,6 +57,11 @@ void WidgetPC::visit_down(const std::function<void(Widget&)>& f) {
     }
 }
 
+void WidgetPC::visit_children(const std::function<void(const Widget&)>& f) const {
+    for (const Widget* child : mprivate_children)
+        f(*child);
+}
+
 Widget* WidgetPC::get_child_at(PointF p) {
     bool ca_contains = children_area().contains(p);
     // reverse iteration as those at the end are considered to be "on-top"
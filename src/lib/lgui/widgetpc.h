@@ -56,6 +56,7 @@ class WidgetPC : public lgui::Widget {
         ~WidgetPC() override;
 
         void visit_down(const std::function<void(Widget&)>& f) override;
+        void visit_children(const std::function<void(const Widget&)>& f) const override;
         Widget* get_child_at(PointF p) override;
 
     protected:
@@ -63,6 +63,7 @@ namespace lgui {
     {
         if(mchecked != checked) {
             mchecked = checked;
+            invalidate();
             if(mcheckable && mgroup && mchecked)
                 mgroup->_button_checked(this);
             on_checked_changed.emit(checked);
@@ -164,6 +165,7 @@ namespace lgui {
     {
         if (!mdown) {
             mdown = true;
+            invalidate();
             on_down.emit();
         }
     }
@@ -172,6 +174,7 @@ namespace lgui {
     {
         if (mdown) {
             mdown = false;
+            invalidate();
             on_up.emit();
         }
     }
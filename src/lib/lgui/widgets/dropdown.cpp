@@ -59,6 +59,9 @@ DropDown::DropDown()
     mlistbox.on_item_activated.connect([this](int idx, const std::string&) {
         listbox_activated(idx);
     });
+    mlistbox.on_selection_changed.connect([this](int) {
+        invalidate(); // We're drawing the selected item.
+    });
     mlistbox.set_event_filter(&mdrop_down_event_filter);
 }
 
@@ -61,12 +61,12 @@ TextLabel::TextLabel(const std::string& str, const Color& col,
 }
 
 void TextLabel::set_text(const std::string& str) {
-    mtext = str;
+    mtext.set_text(str);
     request_layout();
 }
 
 Size TextLabel::min_size_hint() {
-    return Size(font().text_width(mtext) + 2 * MARGIN_X,
+    return Size(mtext.width(font()) + 2 * MARGIN_X,
                 font().line_height() + 2 * MARGIN_Y);
 }
 
@@ -82,11 +82,11 @@ void TextLabel::draw(const DrawEvent& de) const {
         col = col_mult_alpha(mcol, de.opacity());
 
     if (malign.horz() == Align::HCenter)
-        de.gfx().draw_textc(font(), MARGIN_X + width() / 2, MARGIN_Y, col, mtext);
+        de.gfx().draw_text_run(font(), MARGIN_X + width() / 2 - mtext.width(font()) / 2, MARGIN_Y, col, mtext);
     else if (malign.horz() == Align::Right)
-        de.gfx().draw_textr(font(), width() - MARGIN_X, MARGIN_Y, col, mtext);
+        de.gfx().draw_text_run(font(), width() - MARGIN_X - mtext.width(font()), MARGIN_Y, col, mtext);
     else
-        de.gfx().draw_text(font(), MARGIN_X, MARGIN_Y, col, mtext);
+        de.gfx().draw_text_run(font(), MARGIN_X, MARGIN_Y, col, mtext);
 }
 
 }
@@ -43,6 +43,7 @@
 #include "lgui/widget.h"
 #include <string>
 #include "lgui/platform/font.h"
+#include "lgui/platform/textrun.h"
 #include "lgui/platform/color.h"
 
 namespace lgui {
@@ -62,11 +63,15 @@ class TextLabel : public Widget {
         void set_color(const Color& col) {
             mcol = col;
             mcustom_color = true;
+            invalidate();
+        }
+        void set_align(Align align) {
+            malign = align;
+            invalidate();
         }
-        void set_align(Align align) { malign = align; }
 
         const std::string& text() const {
-            return mtext;
+            return mtext.text();
         }
 
         Size min_size_hint() override;
@@ -76,7 +81,7 @@ class TextLabel : public Widget {
         static const int MARGIN_X = 0, MARGIN_Y = 0;
 
         Color mcol;
-        std::string mtext;
+        TextRun mtext;
         Align malign;
         bool mcustom_color;
 };
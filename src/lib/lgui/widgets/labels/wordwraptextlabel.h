@@ -71,6 +71,7 @@ class WordWrapTextLabel : public Widget {
         void set_color(const Color& col) {
             mcol = col;
             mcustom_color = true;
+            invalidate();
         }
         void set_font(const Font* font) override;
         void set_padding(const Padding& padding);
@@ -38,6 +38,8 @@
 */
 
 #include "abstractlistmodel.h"
+#include <algorithm>
+#include "lgui/platform/error.h"
 
 namespace lgui {
 
@@ -54,34 +56,138 @@ void AbstractListModel::remove_listener(IListModelListener& l) {
     mlisteners.remove(&l);
 }
 
+void AbstractListModel::begin_batch() {
+    if (mbatch_depth++ == 0) {
+        mbatch_ranges.clear();
+        mbatch_invalidated = false;
+    }
+}
+
+void AbstractListModel::end_batch() {
+    ASSERT(mbatch_depth > 0);
+    if (--mbatch_depth > 0)
+        return;
+    if (mbatch_invalidated) {
+        mbatch_invalidated = false;
+        emit_items_invalidated();
+        return;
+    }
+    std::vector<ListModelRange> ranges;
+    ranges.swap(mbatch_ranges);
+    if (!ranges.empty())
+        emit_items_changed(ranges);
+}
+
+void AbstractListModel::batch_items_added(int start_idx, int n) {
+    if (mbatch_invalidated)
+        return;
+    auto it = mbatch_ranges.begin();
+    while (it != mbatch_ranges.end() && it->start + it->n_added < start_idx)
+        ++it;
+    if (it != mbatch_ranges.end() && it->start <= start_idx)
+        it->n_added += n; // inserting into or right next to a pending range
+    else
+        it = mbatch_ranges.insert(it, ListModelRange { start_idx, 0, n });
+    for (++it; it != mbatch_ranges.end(); ++it)
+        it->start += n;
+    check_batch_ranges();
+}
+
+void AbstractListModel::batch_items_removed(int start_idx, int n) {
+    if (mbatch_invalidated)
+        return;
+    int end_idx = start_idx + n;
+    auto it = mbatch_ranges.begin();
+    while (it != mbatch_ranges.end() && it->start + it->n_added < start_idx)
+        ++it;
+    // All pending ranges overlapping or touching the removed one are merged into it: the items between them
+    // have been removed, too.
+    ListModelRange merged { start_idx, n, 0 };
+    auto first = it;
+    for (; it != mbatch_ranges.end() && it->start <= end_idx; ++it) {
+        int overlap = std::min(end_idx, it->start + it->n_added) - std::max(start_idx, it->start);
+        overlap = std::max(overlap, 0);
+        merged.start = std::min(merged.start, it->start);
+        merged.n_removed += it->n_removed - overlap; // items added in this batch don't need to be removed
+        merged.n_added += it->n_added - overlap;
+    }
+    for (auto after = it; after != mbatch_ranges.end(); ++after)
+        after->start -= n;
+    it = mbatch_ranges.erase(first, it);
+    if (merged.n_removed > 0 || merged.n_added > 0)
+        mbatch_ranges.insert(it, merged);
+    check_batch_ranges();
+}
+
+void AbstractListModel::check_batch_ranges() {
+    if (signed(mbatch_ranges.size()) > MAX_BATCH_RANGES) {
+        mbatch_invalidated = true;
+        mbatch_ranges.clear();
+    }
+}
+
 void AbstractListModel::emit_about_to_add_items(int start_idx, int n) {
+    if (mbatch_depth > 0)
+        return; // not sent for batched changes
     for (auto l : mlisteners)
         l->about_to_add_items(start_idx, n);
 }
 
 void AbstractListModel::emit_about_to_remove_items(int start_idx, int n) {
+    if (mbatch_depth > 0)
+        return; // not sent for batched changes
     for (auto l : mlisteners)
         l->about_to_remove_items(start_idx, n);
 }
 
 void AbstractListModel::emit_about_to_invalidate_items() {
+    if (mbatch_depth > 0)
+        return; // not sent for batched changes
     for (auto l : mlisteners)
         l->about_to_invalidate_items();
 }
 
 void AbstractListModel::emit_items_added(int start_idx, int n) {
+    if (mbatch_depth > 0) {
+        batch_items_added(start_idx, n);
+        return;
+    }
     for (auto l : mlisteners)
         l->items_added(start_idx, n);
 }
 
 void AbstractListModel::emit_items_removed(int start_idx, int n) {
+    if (mbatch_depth > 0) {
+        batch_items_removed(start_idx, n);
+        return;
+    }
     for (auto l : mlisteners)
         l->items_removed(start_idx, n);
 }
 
 void AbstractListModel::emit_items_invalidated() {
+    if (mbatch_depth > 0) {
+        mbatch_invalidated = true;
+        mbatch_ranges.clear();
+        return;
+    }
     for (auto l : mlisteners)
         l->items_invalidated();
 }
 
+void AbstractListModel::emit_items_changed(const std::vector<ListModelRange>& ranges) {
+    if (mbatch_depth > 0) {
+        // Each range's start is valid once the ranges before it have been applied.
+        for (const ListModelRange& r : ranges) {
+            if (r.n_removed > 0)
+                batch_items_removed(r.start, r.n_removed);
+            if (r.n_added > 0)
+                batch_items_added(r.start, r.n_added);
+        }
+        return;
+    }
+    for (auto l : mlisteners)
+        l->items_changed(ranges);
+}
+
 }
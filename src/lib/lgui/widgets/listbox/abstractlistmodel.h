@@ -42,6 +42,7 @@
 
 #include "listmodellistener.h"
 #include <forward_list>
+#include <vector>
 
 namespace lgui {
 
@@ -50,6 +51,10 @@ namespace lgui {
  */
 class AbstractListModel {
     public:
+        /** The maximum number of separate ranges a batch may announce before it is announced as an
+         *  invalidation. */
+        static constexpr int MAX_BATCH_RANGES = 64;
+
         virtual ~AbstractListModel();
 
         /** Add a list model listener. */
@@ -58,6 +63,23 @@ class AbstractListModel {
         /** Remove a list model listener. */
         void remove_listener(IListModelListener& l);
 
+        /** Start a batch of changes. Until the matching end_batch(), no notifications are sent to the
+         *  listeners. Batches may be nested. */
+        void begin_batch();
+
+        /** End a batch of changes. When the outermost batch ends, the changes made during the batch are
+         *  announced via IListModelListener::items_changed(), coalesced into as few ranges as possible (e.g.
+         *  appending items one by one or removing consecutive items results in a single range). If there are
+         *  more than MAX_BATCH_RANGES ranges, an invalidation is announced instead.
+         *
+         *  As the model has already changed at this point, no about_to_* notifications are sent for the
+         *  changes made during a batch.
+         */
+        void end_batch();
+
+        /** Return whether a batch of changes is in progress. */
+        bool in_batch() const { return mbatch_depth > 0; }
+
     protected:
         void emit_about_to_add_items(int start_idx, int n);
         void emit_about_to_remove_items(int start_idx, int n);
@@ -65,9 +87,17 @@ class AbstractListModel {
         void emit_items_added(int start_idx, int n);
         void emit_items_removed(int start_idx, int n);
         void emit_items_invalidated();
+        void emit_items_changed(const std::vector<ListModelRange>& ranges);
 
     private:
+        void batch_items_added(int start_idx, int n);
+        void batch_items_removed(int start_idx, int n);
+        void check_batch_ranges();
+
         std::forward_list<IListModelListener*> mlisteners;
+        int mbatch_depth = 0;
+        std::vector<ListModelRange> mbatch_ranges; // sorted, neither overlapping nor touching
+        bool mbatch_invalidated = false;
 };
 
 }
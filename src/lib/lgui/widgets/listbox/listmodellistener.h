@@ -40,9 +40,21 @@
 #ifndef LGUI_LIST_MODEL_LISTENER_H
 #define LGUI_LIST_MODEL_LISTENER_H
 
+#include <vector>
+
 namespace lgui {
 
-/** An interface class to listen to changes of a list model. */
+/** A place in a list model where `n_removed` old items have been replaced by the `n_added` items starting at
+ *  `start`. */
+struct ListModelRange {
+    int start, n_removed, n_added;
+};
+
+/** An interface class to listen to changes of a list model.
+ *
+ *  The about_to_* methods are not called for changes the model makes within a batch (see
+ *  AbstractListModel::begin_batch()), so anything that has to follow a change should be done in items_added(),
+ *  items_removed() and items_invalidated(). */
 class IListModelListener {
     public:
         /** Called to announce that the model is going to insert items. */
@@ -69,6 +81,20 @@ class IListModelListener {
         }
         /** Called to inform that the model has changed completely. */
         virtual void items_invalidated() {}
+        /** Called at the end of a batch to inform about the ranges that have changed, in ascending order. The
+         *  default implementation calls items_removed() and items_added() for each range in turn.
+         *
+         *  When this is called, the model has already reached its final state: while handling one range,
+         *  only the items before it and the items added by it are where they will be. Override this if the
+         *  listener needs to look at other items, too. */
+        virtual void items_changed(const std::vector<ListModelRange>& ranges) {
+            for (const ListModelRange& r : ranges) {
+                if (r.n_removed > 0)
+                    items_removed(r.start, r.n_removed);
+                if (r.n_added > 0)
+                    items_added(r.start, r.n_added);
+            }
+        }
         /** Called to announce that the model is going to be destroyed.
             This has always to be implemented. */
         virtual void model_about_to_die() = 0;
@@ -0,0 +1,307 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "sortfilterlistmodel.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include "lgui/internal/parallel.h"
+
+namespace lgui {
+
+// Don't bother starting threads for less than this many items each.
+static const int MIN_PARALLEL_CHUNK = 4096;
+
+SortFilterListModel::SortFilterListModel(StringListModel* source)
+        : msource(source), mparallel_threshold(32768) {
+    if (msource) {
+        msource->add_listener(*this);
+        rebuild();
+    }
+}
+
+SortFilterListModel::~SortFilterListModel() {
+    if (msource)
+        msource->remove_listener(*this);
+}
+
+void SortFilterListModel::set_source(StringListModel* source) {
+    if (msource == source)
+        return;
+    emit_about_to_invalidate_items();
+    if (msource)
+        msource->remove_listener(*this);
+    msource = source;
+    if (msource)
+        msource->add_listener(*this);
+    rebuild();
+    emit_items_invalidated();
+}
+
+void SortFilterListModel::set_filter(Filter filter) {
+    emit_about_to_invalidate_items();
+    mfilter = std::move(filter);
+    rebuild();
+    emit_items_invalidated();
+}
+
+void SortFilterListModel::refine_filter(Filter filter) {
+    mfilter = std::move(filter);
+    remove_not_passing();
+}
+
+void SortFilterListModel::set_compare(Compare compare) {
+    emit_about_to_invalidate_items();
+    mcompare = std::move(compare);
+    rebuild();
+    emit_items_invalidated();
+}
+
+std::string SortFilterListModel::item_at(int idx) const {
+    return msource->item_at(source_index(idx));
+}
+
+int SortFilterListModel::source_index(int idx) const {
+    ASSERT(is_valid_index(idx));
+    return mmap[idx];
+}
+
+int SortFilterListModel::index_from_source(int source_idx) const {
+    auto it = std::find(mmap.begin(), mmap.end(), source_idx);
+    return it != mmap.end() ? int(it - mmap.begin()) : -1;
+}
+
+bool SortFilterListModel::passes(int source_idx) const {
+    return !mfilter || mfilter(msource->item_at(source_idx));
+}
+
+bool SortFilterListModel::less(int source_idx_a, int source_idx_b) const {
+    // Break ties by the source order: this makes the order total, so sorting is stable and inserting
+    // a single item can use binary search.
+    if (mcompare) {
+        const std::string& a = msource->item_at(source_idx_a), & b = msource->item_at(source_idx_b);
+        if (mcompare(a, b))
+            return true;
+        if (mcompare(b, a))
+            return false;
+    }
+    return source_idx_a < source_idx_b;
+}
+
+void SortFilterListModel::rebuild() {
+    mmap.clear();
+    if (!msource)
+        return;
+    int n = msource->no_items();
+    bool parallel = n >= mparallel_threshold;
+    if (mfilter) {
+        if (parallel) {
+            std::vector<char> pass(n);
+            dtl::parallel_for(n, MIN_PARALLEL_CHUNK, [this, &pass](int begin, int end) {
+                for (int i = begin; i < end; i++)
+                    pass[i] = passes(i);
+            });
+            for (int i = 0; i < n; i++)
+                if (pass[i])
+                    mmap.push_back(i);
+        }
+        else {
+            for (int i = 0; i < n; i++)
+                if (passes(i))
+                    mmap.push_back(i);
+        }
+    }
+    else {
+        mmap.resize(n);
+        std::iota(mmap.begin(), mmap.end(), 0);
+    }
+    if (!mcompare)
+        return; // already in source order
+
+    auto cmp = [this](int a, int b) { return less(a, b); };
+    int m = mmap.size();
+    int chunks = parallel ? std::min(dtl::parallel_threads(), m / MIN_PARALLEL_CHUNK) : 1;
+    if (chunks <= 1) {
+        std::sort(mmap.begin(), mmap.end(), cmp);
+        return;
+    }
+    // Sort chunks in parallel, then merge pairs of neighbouring runs level by level.
+    auto bound = [this, m, chunks](int c) {
+        return mmap.begin() + int(int64_t(m) * std::min(c, chunks) / chunks);
+    };
+    dtl::parallel_for(chunks, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; c++)
+            std::sort(bound(c), bound(c + 1), cmp);
+    });
+    for (int w = 1; w < chunks; w *= 2) {
+        int pairs = (chunks + 2 * w - 1) / (2 * w);
+        dtl::parallel_for(pairs, 1, [&](int begin, int end) {
+            for (int p = begin; p < end; p++)
+                std::inplace_merge(bound(2 * p * w), bound(2 * p * w + w), bound(2 * p * w + 2 * w), cmp);
+        });
+    }
+}
+
+void SortFilterListModel::remove_not_passing() {
+    if (!msource)
+        return;
+    int m = mmap.size();
+    std::vector<char> pass(m);
+    auto check = [this, &pass](int begin, int end) {
+        for (int p = begin; p < end; p++)
+            pass[p] = passes(mmap[p]);
+    };
+    if (m >= mparallel_threshold)
+        dtl::parallel_for(m, MIN_PARALLEL_CHUNK, check);
+    else
+        check(0, m);
+
+    std::vector<int> removed;
+    int out = 0;
+    for (int p = 0; p < m; p++) {
+        if (pass[p])
+            mmap[out++] = mmap[p];
+        else
+            removed.push_back(p);
+    }
+    mmap.resize(out);
+    emit_removed_positions(removed);
+}
+
+void SortFilterListModel::emit_removed_positions(const std::vector<int>& removed) {
+    // Report each run of consecutive positions as one range, from the back, so that the positions are valid
+    // one after another.
+    begin_batch();
+    for (int i = removed.size(); i > 0;) {
+        int end = i--;
+        while (i > 0 && removed[i - 1] == removed[i] - 1)
+            i--;
+        emit_items_removed(removed[i], end - i);
+    }
+    end_batch();
+}
+
+void SortFilterListModel::about_to_invalidate_items() {
+    emit_about_to_invalidate_items();
+}
+
+void SortFilterListModel::items_added(int start_idx, int n) {
+    items_changed({ ListModelRange { start_idx, 0, n } });
+}
+
+void SortFilterListModel::items_removed(int start_idx, int n) {
+    items_changed({ ListModelRange { start_idx, n, 0 } });
+}
+
+void SortFilterListModel::items_changed(const std::vector<ListModelRange>& ranges) {
+    if (ranges.empty())
+        return;
+    // Where each range was in the source before the changes, and by how much the source indices after it
+    // have moved.
+    int nr = ranges.size();
+    std::vector<int> old_start(nr), shift(nr);
+    for (int r = 0, delta = 0; r < nr; r++) {
+        old_start[r] = ranges[r].start - delta;
+        delta += ranges[r].n_added - ranges[r].n_removed;
+        shift[r] = delta;
+    }
+    // Without a sort order, the mapping is in source order and the items before the first range are
+    // unaffected.
+    int first = 0;
+    if (!mcompare)
+        first = std::lower_bound(mmap.begin(), mmap.end(), old_start[0]) - mmap.begin();
+    std::vector<int> removed;
+    int out = first;
+    for (int p = first; p < signed(mmap.size()); p++) {
+        int idx = mmap[p];
+        int r = int(std::upper_bound(old_start.begin(), old_start.end(), idx) - old_start.begin()) - 1;
+        if (r >= 0 && idx < old_start[r] + ranges[r].n_removed)
+            removed.push_back(p);
+        else
+            mmap[out++] = r >= 0 ? idx + shift[r] : idx;
+    }
+    mmap.resize(out);
+
+    std::vector<int> added;
+    for (const ListModelRange& range : ranges)
+        for (int i = range.start; i < range.start + range.n_added; i++)
+            if (passes(i))
+                added.push_back(i);
+    // Without a sort order, less() compares the source indices, which are already ascending.
+    auto cmp = [this](int a, int b) { return less(a, b); };
+    if (mcompare)
+        std::sort(added.begin(), added.end(), cmp);
+    int m = mmap.size(), k = added.size();
+    std::vector<int> pos(k); // position in the mapping each new item is inserted before
+    for (int j = 0; j < k; j++)
+        pos[j] = std::lower_bound(mmap.begin(), mmap.end(), added[j], cmp) - mmap.begin();
+    // Merge in place from the back: the new item j ends up at pos[j] + j.
+    mmap.resize(m + k);
+    for (int j = k - 1, src_end = m; j >= 0; j--) {
+        std::move_backward(mmap.begin() + pos[j], mmap.begin() + src_end, mmap.begin() + src_end + j + 1);
+        mmap[pos[j] + j] = added[j];
+        src_end = pos[j];
+    }
+
+    begin_batch();
+    emit_removed_positions(removed);
+    // New items inserted before the same item form one range. Report in ascending order, so that the
+    // positions are valid one after another.
+    for (int j = 0; j < k;) {
+        int first_j = j++;
+        while (j < k && pos[j] == pos[first_j])
+            j++;
+        emit_items_added(pos[first_j] + first_j, j - first_j);
+    }
+    end_batch();
+}
+
+void SortFilterListModel::items_invalidated() {
+    rebuild();
+    emit_items_invalidated();
+}
+
+void SortFilterListModel::model_about_to_die() {
+    emit_about_to_invalidate_items();
+    msource = nullptr;
+    mmap.clear();
+    emit_items_invalidated();
+}
+
+}
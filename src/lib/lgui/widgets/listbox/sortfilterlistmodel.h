@@ -0,0 +1,120 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_SORTFILTERLISTMODEL_H
+#define LGUI_SORTFILTERLISTMODEL_H
+
+#include <vector>
+#include <functional>
+#include "virtuallistmodel.h"
+#include "stringlistmodel.h"
+
+namespace lgui {
+
+/** A proxy model presenting the items of a StringListModel that pass a filter, optionally sorted. It only
+ *  holds a mapping from its indices to the source model's indices, which is updated incrementally when items
+ *  are added to or removed from the source; listeners are told about the affected items at their positions
+ *  in the proxy. As a VirtualListModel, it is displayed by VirtualListBox.
+ *
+ *  Building the mapping from scratch (when setting the source, filter or sort order) filters and sorts large
+ *  sources in parallel. Filter and compare functions must therefore be safe to call from several threads at
+ *  once, which they are if they don't modify shared state.
+ */
+class SortFilterListModel : public VirtualListModel, public IListModelListener {
+    public:
+        /** Return true if the item should be shown. */
+        using Filter = std::function<bool(const std::string&)>;
+        /** Return true if the first item is to be shown before the second. */
+        using Compare = std::function<bool(const std::string&, const std::string&)>;
+
+        explicit SortFilterListModel(StringListModel* source = nullptr);
+        ~SortFilterListModel() override;
+
+        void set_source(StringListModel* source);
+        StringListModel* source() { return msource; }
+        const StringListModel* source() const { return msource; }
+
+        /** Set the filter. An empty function will let all items pass. */
+        void set_filter(Filter filter);
+        /** Set a filter that is known to let pass at most the items the current filter lets pass, e.g. when
+         *  the user has typed another character into a search field. Only the items currently in the proxy
+         *  are checked, and the ones not passing are reported as removed. */
+        void refine_filter(Filter filter);
+        /** Set the sort order. An empty function will keep the source's order. The sort is stable. */
+        void set_compare(Compare compare);
+
+        int no_items() const override { return mmap.size(); }
+        std::string item_at(int idx) const override;
+
+        /** Return the index of the item at `idx` in the source model. */
+        int source_index(int idx) const;
+        /** Return the index of the source model's item at `source_idx` in the proxy or -1 if it doesn't pass
+         *  the filter. This has to search the mapping. */
+        int index_from_source(int source_idx) const;
+
+        /** Set the number of items from which on the mapping will be built using several threads. The
+         *  default is 32768. */
+        void set_parallel_threshold(int threshold) { mparallel_threshold = threshold; }
+        int parallel_threshold() const { return mparallel_threshold; }
+
+    protected:
+        void about_to_invalidate_items() override;
+        void items_added(int start_idx, int n) override;
+        void items_removed(int start_idx, int n) override;
+        void items_invalidated() override;
+        void items_changed(const std::vector<ListModelRange>& ranges) override;
+        void model_about_to_die() override;
+
+    private:
+        bool passes(int source_idx) const;
+        bool less(int source_idx_a, int source_idx_b) const;
+        void rebuild();
+        void remove_not_passing();
+        void emit_removed_positions(const std::vector<int>& removed);
+
+        StringListModel* msource;
+        Filter mfilter;
+        Compare mcompare;
+        std::vector<int> mmap; // source index of each item
+        int mparallel_threshold;
+};
+
+}
+
+#endif // LGUI_SORTFILTERLISTMODEL_H
@@ -40,6 +40,8 @@
 #ifndef LGUI_STRING_LIST_MODEL_H
 #define LGUI_STRING_LIST_MODEL_H
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 #include <string>
 #include "abstractlistmodel.h"
@@ -99,13 +101,27 @@ class GenListModel : public AbstractListModel {
         void add_items(const std::vector<T>& items) {
             if (!items.empty()) {
                 emit_about_to_add_items(mitems.size(), items.size());
-                for (const auto& it : items) {
-                    mitems.push_back(it);
-                }
+                mitems.insert(mitems.end(), items.begin(), items.end());
                 emit_items_added(mitems.size() - items.size(), items.size());
             }
         }
 
+        /** Add a list of items to a model, moving them instead of copying. If the model is empty, it will
+         *  take over the vector's storage. */
+        void add_items(std::vector<T>&& items) {
+            if (!items.empty()) {
+                int n = items.size();
+                emit_about_to_add_items(mitems.size(), n);
+                if (mitems.empty())
+                    mitems = std::move(items);
+                else
+                    mitems.insert(mitems.end(), std::make_move_iterator(items.begin()),
+                                  std::make_move_iterator(items.end()));
+                items.clear();
+                emit_items_added(mitems.size() - n, n);
+            }
+        }
+
         /** Insert an item into the model. If the index is not valid, the item will be appended to the end.
         */
         void insert_item(const T& item, int idx) {
@@ -118,6 +134,55 @@ class GenListModel : public AbstractListModel {
                 add_item(item);
         }
 
+        /** Insert a list of items into the model before the item at `idx`, notifying the listeners only once.
+         *  If the index is not valid, the items will be appended to the end. */
+        void insert_items(const std::vector<T>& items, int idx) {
+            if (!is_valid_index(idx)) {
+                add_items(items);
+                return;
+            }
+            if (!items.empty()) {
+                emit_about_to_add_items(idx, items.size());
+                mitems.insert(mitems.begin() + idx, items.begin(), items.end());
+                emit_items_added(idx, items.size());
+            }
+        }
+
+        /** Remove `n` consecutive items starting at `start_idx`, notifying the listeners only once. The range
+         *  will be clipped to the valid indices. Return the number of items removed. */
+        int remove_items(int start_idx, int n) {
+            start_idx = std::max(start_idx, 0);
+            n = std::min(n, no_items() - start_idx);
+            if (n <= 0)
+                return 0;
+            emit_about_to_remove_items(start_idx, n);
+            mitems.erase(mitems.begin() + start_idx, mitems.begin() + start_idx + n);
+            emit_items_removed(start_idx, n);
+            return n;
+        }
+
+        /** Replace `n` consecutive items starting at `start_idx` by `items`, which are moved into the model.
+         *  The listeners are told about the removal of the old and the addition of the new items; wrap the
+         *  call in a batch (see AbstractListModel::begin_batch()) to have it coalesced with neighbouring
+         *  changes. The range will be clipped to the valid indices. */
+        void replace_range(int start_idx, int n, std::vector<T>&& items) {
+            start_idx = std::max(0, std::min(start_idx, no_items()));
+            n = std::max(0, std::min(n, no_items() - start_idx));
+            if (n > 0) {
+                emit_about_to_remove_items(start_idx, n);
+                mitems.erase(mitems.begin() + start_idx, mitems.begin() + start_idx + n);
+                emit_items_removed(start_idx, n);
+            }
+            if (!items.empty()) {
+                int m = items.size();
+                emit_about_to_add_items(start_idx, m);
+                mitems.insert(mitems.begin() + start_idx, std::make_move_iterator(items.begin()),
+                              std::make_move_iterator(items.end()));
+                items.clear();
+                emit_items_added(start_idx, m);
+            }
+        }
+
         /** Remove the first ocurrence of an item from the model. */
         void remove_item(const T& item) {
             int idx = index_of(item);
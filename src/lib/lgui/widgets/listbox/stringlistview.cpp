@@ -62,6 +62,11 @@ StringListView::StringListView(StringListModel* model, const Font* font)
         mmodel->add_listener(*this);
 }
 
+StringListView::~StringListView() {
+    if (mmodel)
+        mmodel->remove_listener(*this);
+}
+
 void StringListView::draw(const DrawEvent& de) const {
     if (mmodel) {
         int draw_begin_idx = 0, draw_end_idx = mmodel->no_items();
@@ -79,7 +84,7 @@ void StringListView::draw(const DrawEvent& de) const {
         for (int i = draw_begin_idx; i < draw_end_idx; i++) {
             style().draw_string_list_item(de.gfx(),
                                           StyleArgs(*this, de, rect_for_item(i), false, false,
-                                                    mselected_idx == i), mindent, mmodel->item_at(i));
+                                                    mselected_idx == i), mindent, mitem_runs[i]);
         }
     }
 }
@@ -90,6 +95,7 @@ void StringListView::set_selected_idx(int idx) {
             idx = -1;
         if (mselected_idx != idx) {
             mselected_idx = idx;
+            invalidate();
             on_selection_changed.emit(mselected_idx);
         }
     }
@@ -142,30 +148,21 @@ void StringListView::about_to_add_items(int start_idx, int n) {
     (void) n;
 }
 
-void StringListView::about_to_remove_items(int start_idx, int n) {
-    if (mselected_idx >= start_idx && mselected_idx < start_idx + n) {
-        if (start_idx - 1 >= 0)
-            set_selected_idx(start_idx - 1); // one before
-        else {
-            set_selected_idx(start_idx); // one after
-        }
-    }
-        // keep selection
-    else if (mselected_idx >= start_idx) {
-        set_selected_idx(mselected_idx - n);
-    }
-}
-
 void StringListView::about_to_invalidate_items() {
     set_selected_idx(-1);
 }
 
 void StringListView::items_added(int start_idx, int n) {
     ASSERT(mmodel);
+    mitem_runs.insert(mitem_runs.begin() + start_idx, n, TextRun());
+    mitem_widths.insert(mitem_widths.begin() + start_idx, n, 0);
     for (int i = start_idx; i < start_idx + n; i++) {
-        int iw = style().get_string_list_item_width(font(), mmodel->item_at(i));
-        mmax_width = std::max(iw, mmax_width);
+        mitem_runs[i].set_text(mmodel->item_at(i));
+        int iw = style().get_string_list_item_width(font(), mitem_runs[i]);
+        mitem_widths[i] = iw;
+        mwidth_counts[iw]++;
     }
+    update_max_width();
     // keep selection
     if (mselected_idx >= start_idx) {
         set_selected_idx(mselected_idx + n);
@@ -174,30 +171,51 @@ void StringListView::items_added(int start_idx, int n) {
 }
 
 void StringListView::items_removed(int start_idx, int n) {
-    (void) start_idx;
-    (void) n;
     ASSERT(mmodel);
-    mmax_width = 0;
-    for (int i = 0; i < mmodel->no_items(); i++) {
-        int iw = style().get_string_list_item_width(font(), mmodel->item_at(i));
-        mmax_width = std::max(iw, mmax_width);
+    // Only the widths of the removed items are taken out of the histogram: no re-measuring.
+    for (int i = start_idx; i < start_idx + n; i++) {
+        auto it = mwidth_counts.find(mitem_widths[i]);
+        ASSERT(it != mwidth_counts.end());
+        if (--it->second == 0)
+            mwidth_counts.erase(it);
+    }
+    mitem_runs.erase(mitem_runs.begin() + start_idx, mitem_runs.begin() + start_idx + n);
+    mitem_widths.erase(mitem_widths.begin() + start_idx, mitem_widths.begin() + start_idx + n);
+    update_max_width();
+    // Done here rather than in about_to_remove_items(), which isn't called for batched changes.
+    if (mselected_idx >= start_idx + n) {
+        // keep selection
+        set_selected_idx(mselected_idx - n);
+    }
+    else if (mselected_idx >= start_idx) {
+        if (start_idx - 1 >= 0)
+            set_selected_idx(start_idx - 1); // one before
+        else
+            set_selected_idx(start_idx); // one after
     }
-    // We've mostly already dealt with selection in about_to_be_removed.
-    if (mselected_idx >= mmodel->no_items())
-        mselected_idx = mmodel->no_items() - 1; // will set to -1
     request_layout();
 }
 
 void StringListView::items_invalidated() {
     ASSERT(mmodel);
-    // selection?
+    set_selected_idx(-1);
     mmax_width = 0;
+    mitem_runs.clear();
+    mitem_widths.clear();
+    mwidth_counts.clear();
     items_added(0, mmodel->no_items());
     //request_layout(); // already in items_added
 }
 
 void StringListView::model_about_to_die() {
     mmodel = nullptr;
+    mitem_runs.clear();
+    mitem_widths.clear();
+    mwidth_counts.clear();
+}
+
+void StringListView::update_max_width() {
+    mmax_width = mwidth_counts.empty() ? 0 : mwidth_counts.rbegin()->first;
 }
 
 int StringListView::get_idx_from_pos(const Position& pos) const {
@@ -40,9 +40,11 @@
 #ifndef LGUI_STRINGLISTVIEW_H
 #define LGUI_STRINGLISTVIEW_H
 
+#include <map>
 #include "lgui/widget.h"
 #include "lgui/signal.h"
 #include "stringlistmodel.h"
+#include "lgui/platform/textrun.h"
 
 namespace lgui {
 
@@ -56,6 +58,7 @@ class Font;
 class StringListView : public Widget, public IListModelListener {
     public:
         explicit StringListView(StringListModel* model = nullptr, const Font* font = nullptr);
+        ~StringListView() override;
 
         Signal<int> on_selection_changed;
         Signal<int, const std::string&> on_item_activated;
@@ -122,7 +125,6 @@ class StringListView : public Widget, public IListModelListener {
 
     protected:
         void about_to_add_items(int start_idx, int n) override;
-        void about_to_remove_items(int start_idx, int n) override;
         void about_to_invalidate_items() override;
         void items_added(int start_idx, int n) override;
         void items_removed(int start_idx, int n) override;
@@ -141,8 +143,13 @@ class StringListView : public Widget, public IListModelListener {
         void key_pressed(KeyEvent& event) override;
 
     private:
+        void update_max_width();
+
         Padding mpadding;
         StringListModel* mmodel;
+        std::vector<TextRun> mitem_runs; // kept in sync with the model's items
+        std::vector<int> mitem_widths; // measured width of each item
+        std::map<int, int> mwidth_counts; // width -> number of items that wide; the last key is the max. width
         int mselected_idx, mitem_height, mmax_width,
                 mindent;
         bool mselect_on_hover_activate_on_click,
@@ -0,0 +1,421 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "virtuallistbox.h"
+
+#include <algorithm>
+
+#include "lgui/style/style.h"
+#include "lgui/mouseevent.h"
+#include "lgui/keyevent.h"
+#include "lgui/platform/keycodes.h"
+#include "lgui/platform/graphics.h"
+
+namespace lgui {
+
+// Scroll bars work with ints: positions are scaled down for lists taller than this.
+static const int64_t MAX_SCROLLBAR_RANGE = 1 << 30;
+static const int WANT_HEIGHT_ITEMS = 20;
+static const int WHEEL_SCROLL_ITEMS = 3;
+// The width samples are taken in this many contiguous runs to keep the number of pages fetched low.
+static const int WIDTH_SAMPLE_RUNS = 4;
+
+VirtualListBox::VirtualListBox(VirtualListModel* model, const Font* font)
+        : mvert_scrollbar(Vertical),
+          mmodel(model),
+          mvisible_first(0),
+          mscroll(0),
+          mscrollbar_scale(1),
+          mselected_idx(-1), mitem_height(0), mmax_width(0),
+          mwidth_samples(128),
+          mupdating_scrollbar(false) {
+    mvert_scrollbar.on_scrolled.connect(&VirtualListBox::y_scrolled, *this);
+    mvert_scrollbar.set_outside_children_area(true);
+    mvert_scrollbar.set_invisible();
+    add_private_child(mvert_scrollbar);
+    if (font)
+        Widget::set_font(font);
+    style_changed(); // initialize padding, item height
+    set_focusable(true);
+    if (mmodel) {
+        mmodel->add_listener(*this);
+        sample_widths(0, mmodel->no_items());
+    }
+}
+
+VirtualListBox::~VirtualListBox() {
+    if (mmodel)
+        mmodel->remove_listener(*this);
+}
+
+void VirtualListBox::draw(const DrawEvent& de) const {
+    style().draw_list_box_bg(de.gfx(), StyleArgs(*this, de));
+    if (mmodel && !mvisible_runs.empty()) {
+        de.gfx().push_draw_area(children_area(), true);
+        for (size_t i = 0; i < mvisible_runs.size(); i++) {
+            int idx = mvisible_first + int(i);
+            style().draw_string_list_item(de.gfx(),
+                                          StyleArgs(*this, de, rect_for_item(idx), false, false,
+                                                    mselected_idx == idx), -1, mvisible_runs[i]);
+        }
+        de.gfx().pop_draw_area();
+    }
+    draw_private_children(de, false);
+    style().draw_list_box_fg(de.gfx(), StyleArgs(*this, de));
+}
+
+Rect VirtualListBox::children_area() const {
+    int w = width() - mpadding.horz(),
+            h = height() - mpadding.vert();
+    if (mvert_scrollbar.is_visible())
+        w -= mvert_scrollbar.width();
+    return Rect(mpadding.left(), mpadding.top(), w, h);
+}
+
+void VirtualListBox::set_model(VirtualListModel* model) {
+    if (mmodel != model) {
+        if (mmodel) {
+            about_to_invalidate_items();
+            mmodel->remove_listener(*this);
+        }
+        mmodel = model;
+        if (mmodel)
+            mmodel->add_listener(*this);
+        items_invalidated();
+    }
+}
+
+void VirtualListBox::set_selected_idx(int idx) {
+    if (!mmodel || !mmodel->is_valid_index(idx))
+        idx = -1;
+    if (mselected_idx != idx) {
+        mselected_idx = idx;
+        invalidate();
+        make_visible(idx);
+        on_selection_changed.emit(mselected_idx);
+    }
+}
+
+void VirtualListBox::make_visible(int idx) {
+    if (!mmodel || !mmodel->is_valid_index(idx))
+        return;
+    int64_t top = int64_t(idx) * mitem_height + mlist_padding.top();
+    int64_t bottom = top + mitem_height;
+    int h = children_area().h();
+    if (top < mscroll)
+        scroll_to_offset(top);
+    else if (bottom > mscroll + h)
+        scroll_to_offset(bottom - h);
+}
+
+void VirtualListBox::scroll_to_offset(int64_t offset) {
+    mscroll = std::max<int64_t>(0, std::min(offset, max_scroll()));
+    if (mvert_scrollbar.is_visible()) {
+        mupdating_scrollbar = true;
+        mvert_scrollbar.scroll_to(int(mscroll / mscrollbar_scale));
+        mupdating_scrollbar = false;
+    }
+    update_visible_runs();
+    invalidate();
+}
+
+int VirtualListBox::first_visible_idx() const {
+    if (mitem_height <= 0)
+        return 0;
+    return int(std::max<int64_t>(0, mscroll - mlist_padding.top()) / mitem_height);
+}
+
+void VirtualListBox::set_font(const Font* font) {
+    Widget::set_font(font);
+    style_changed();
+}
+
+Size VirtualListBox::min_size_hint() {
+    return Size(mpadding.horz() + mlist_padding.horz() + mvert_scrollbar.min_size_hint().w(),
+                mpadding.vert() + mlist_padding.vert() + mitem_height);
+}
+
+MeasureResults VirtualListBox::measure(SizeConstraint wc, SizeConstraint hc) {
+    // Don't ask for the height of all items: there may be millions of them.
+    int64_t want_h = std::min(total_height(), int64_t(WANT_HEIGHT_ITEMS) * mitem_height + mlist_padding.vert());
+    int want_w = mmax_width + mlist_padding.horz() + mpadding.horz();
+    if (total_height() > want_h)
+        want_w += mvert_scrollbar.min_size_hint().w();
+    return force_size_constraints(Size(want_w, int(want_h) + mpadding.vert()), wc, hc);
+}
+
+void VirtualListBox::style_changed() {
+    WidgetPC::style_changed();
+    mpadding = style().get_list_box_padding();
+    mlist_padding = style().get_list_padding();
+    mitem_height = style().get_string_list_item_height(font());
+    mvisible_runs.clear();
+    update_scrollbar();
+}
+
+void VirtualListBox::resized(const Size& old_size) {
+    (void) old_size;
+    update_scrollbar();
+}
+
+void VirtualListBox::about_to_invalidate_items() {
+    set_selected_idx(-1);
+}
+
+void VirtualListBox::items_added(int start_idx, int n) {
+    ASSERT(mmodel);
+    sample_widths(start_idx, n);
+    // keep selection
+    if (mselected_idx >= start_idx) {
+        mselected_idx += n;
+        on_selection_changed.emit(mselected_idx);
+    }
+    mvisible_runs.clear();
+    update_scrollbar();
+    request_layout();
+}
+
+void VirtualListBox::items_removed(int start_idx, int n) {
+    ASSERT(mmodel);
+    // The width estimate is kept: it is an estimate anyway.
+    mvisible_runs.clear();
+    update_scrollbar();
+    // Done here rather than in about_to_remove_items(), which isn't called for batched changes.
+    if (mselected_idx >= start_idx + n) // keep selection
+        set_selected_idx(mselected_idx - n);
+    else if (mselected_idx >= start_idx)
+        set_selected_idx(start_idx > 0 ? start_idx - 1 : start_idx); // one before or one after
+    request_layout();
+}
+
+void VirtualListBox::items_invalidated() {
+    set_selected_idx(-1);
+    mmax_width = 0;
+    mscroll = 0;
+    if (mmodel)
+        sample_widths(0, mmodel->no_items());
+    mvisible_runs.clear();
+    update_scrollbar();
+    request_layout();
+}
+
+void VirtualListBox::model_about_to_die() {
+    mmodel = nullptr;
+    mselected_idx = -1;
+    mvisible_runs.clear();
+    update_scrollbar();
+    invalidate();
+}
+
+int64_t VirtualListBox::total_height() const {
+    if (!mmodel)
+        return 0;
+    return int64_t(mmodel->no_items()) * mitem_height + mlist_padding.vert();
+}
+
+int64_t VirtualListBox::max_scroll() const {
+    return std::max<int64_t>(0, total_height() - children_area().h());
+}
+
+int VirtualListBox::get_idx_from_pos(const Position& pos) const {
+    Rect ca = children_area();
+    if (!mmodel || mmodel->no_items() == 0 || mitem_height <= 0 || !ca.contains(pos))
+        return -1;
+    int64_t y = int64_t(pos.y() - ca.y()) + mscroll - mlist_padding.top();
+    int64_t idx = std::max<int64_t>(0, y / mitem_height);
+    return int(std::min<int64_t>(idx, mmodel->no_items() - 1));
+}
+
+Rect VirtualListBox::rect_for_item(int idx) const {
+    // relative to children area; only valid for items near the visible range
+    int y = int(int64_t(idx) * mitem_height + mlist_padding.top() - mscroll);
+    int w = std::max(mmax_width, children_area().w() - mlist_padding.horz());
+    return Rect(mlist_padding.left(), y, w + 1, mitem_height + 1);
+}
+
+void VirtualListBox::sample_widths(int start_idx, int n) {
+    if (!mmodel || n <= 0 || mwidth_samples <= 0)
+        return;
+    int samples = std::min(n, mwidth_samples);
+    int runs = std::min(WIDTH_SAMPLE_RUNS, samples);
+    int per_run = samples / runs;
+    TextRun run;
+    for (int r = 0; r < runs; r++) {
+        // spread the runs evenly, the last one ending at the end of the range
+        int first = start_idx + int(int64_t(n - per_run) * r / std::max(runs - 1, 1));
+        for (int i = first; i < first + per_run; i++) {
+            run.set_text(mmodel->item_at(i));
+            mmax_width = std::max(mmax_width, style().get_string_list_item_width(font(), run));
+        }
+    }
+}
+
+void VirtualListBox::update_visible_runs() {
+    if (!mmodel || mitem_height <= 0) {
+        mvisible_runs.clear();
+        return;
+    }
+    int first = first_visible_idx();
+    int n = std::min(children_area().h() / mitem_height + 2, mmodel->no_items() - first);
+    n = std::max(n, 0);
+    std::vector<TextRun> runs(n);
+    int old_end = mvisible_first + signed(mvisible_runs.size());
+    for (int i = 0; i < n; i++) {
+        int idx = first + i;
+        if (idx >= mvisible_first && idx < old_end)
+            runs[i] = std::move(mvisible_runs[idx - mvisible_first]);
+        else {
+            runs[i].set_text(mmodel->item_at(idx));
+            mmax_width = std::max(mmax_width, style().get_string_list_item_width(font(), runs[i]));
+        }
+    }
+    mvisible_runs.swap(runs);
+    mvisible_first = first;
+}
+
+void VirtualListBox::update_scrollbar() {
+    int64_t total = total_height();
+    int avail_h = height() - mpadding.vert();
+    if (avail_h > 0 && total > avail_h) {
+        mvert_scrollbar.set_visible();
+        mscrollbar_scale = int(std::max<int64_t>(1, (total + MAX_SCROLLBAR_RANGE - 1) / MAX_SCROLLBAR_RANGE));
+        mscroll = std::min(mscroll, max_scroll());
+        mupdating_scrollbar = true;
+        mvert_scrollbar.setup(int(total / mscrollbar_scale), std::max(avail_h / mscrollbar_scale, 1), avail_h,
+                              int(mscroll / mscrollbar_scale), std::max(mitem_height / mscrollbar_scale, 1));
+        mupdating_scrollbar = false;
+        mvert_scrollbar.set_pos(width() - mpadding.right() - mvert_scrollbar.width(), mpadding.top());
+    }
+    else {
+        mvert_scrollbar.set_invisible();
+        mscrollbar_scale = 1;
+        mscroll = 0;
+    }
+    update_visible_runs();
+}
+
+void VirtualListBox::y_scrolled(int new_pos) {
+    if (mupdating_scrollbar)
+        return;
+    int64_t max = max_scroll();
+    // make sure the very end can be reached despite scaling
+    if (new_pos >= int(max / mscrollbar_scale))
+        mscroll = max;
+    else
+        mscroll = int64_t(new_pos) * mscrollbar_scale;
+    update_visible_runs();
+    invalidate();
+}
+
+void VirtualListBox::emit_activated() {
+    on_item_activated.emit(mselected_idx, mmodel->item_at(mselected_idx));
+}
+
+void VirtualListBox::mouse_pressed(MouseEvent& event) {
+    int pressed_idx = get_idx_from_pos(event.pos());
+    if (pressed_idx >= 0) {
+        set_selected_idx(pressed_idx);
+        if (!has_focus())
+            focus();
+    }
+    event.consume();
+}
+
+void VirtualListBox::mouse_dragged(MouseEvent& event) {
+    int dragged_idx = get_idx_from_pos(event.pos());
+    if (dragged_idx >= 0)
+        set_selected_idx(dragged_idx);
+    event.consume();
+}
+
+void VirtualListBox::mouse_wheel_down(MouseEvent& event) {
+    scroll_to_offset(mscroll + WHEEL_SCROLL_ITEMS * mitem_height);
+    event.consume();
+}
+
+void VirtualListBox::mouse_wheel_up(MouseEvent& event) {
+    scroll_to_offset(mscroll - WHEEL_SCROLL_ITEMS * mitem_height);
+    event.consume();
+}
+
+void VirtualListBox::key_char(KeyEvent& event) {
+    if (!mmodel || mitem_height <= 0)
+        return;
+    const int page_items = std::max(children_area().h() / mitem_height, 1);
+    const int last_idx = mmodel->no_items() - 1;
+    int sel = -1;
+    switch (event.key_code()) {
+        case Keycodes::KEY_UP:
+            if (mselected_idx > 0)
+                sel = mselected_idx - 1;
+            break;
+        case Keycodes::KEY_DOWN:
+            if (mselected_idx < last_idx)
+                sel = mselected_idx + 1;
+            break;
+        case Keycodes::KEY_PGUP:
+            sel = std::max(0, mselected_idx - page_items);
+            break;
+        case Keycodes::KEY_PGDN:
+            sel = std::min(last_idx, std::max(mselected_idx, 0) + page_items);
+            break;
+        case Keycodes::KEY_HOME:
+            sel = 0;
+            break;
+        case Keycodes::KEY_END:
+            sel = last_idx;
+            break;
+        default:
+            break;
+    }
+    if (last_idx >= 0 && sel >= 0 && sel <= last_idx) {
+        set_selected_idx(sel);
+        event.consume();
+    }
+}
+
+void VirtualListBox::key_pressed(KeyEvent& event) {
+    if (mmodel && mselected_idx >= 0 &&
+        (event.key_code() == Keycodes::KEY_ENTER || event.key_code() == Keycodes::KEY_ENTER_PAD)) {
+        emit_activated();
+        event.consume();
+    }
+}
+
+}
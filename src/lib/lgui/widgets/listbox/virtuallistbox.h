@@ -0,0 +1,143 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_VIRTUALLISTBOX_H
+#define LGUI_VIRTUALLISTBOX_H
+
+#include <cstdint>
+#include <vector>
+#include "lgui/widgetpc.h"
+#include "lgui/signal.h"
+#include "lgui/platform/textrun.h"
+#include "lgui/widgets/scrollbar.h"
+#include "virtuallistmodel.h"
+
+namespace lgui {
+
+/** A list box for very large lists, displaying a VirtualListModel. Contrary to ListBox, it isn't a
+ *  ScrollArea containing a widget as tall as all of its items: it scrolls by a 64-bit pixel offset itself and
+ *  only requests, shapes and draws the items in view. Its preferred width is estimated from a sample of the
+ *  items (plus the items that have been in view so far) instead of measuring all of them.
+ *  It provides its own vertical scroll bar. There is no horizontal scrolling.
+ */
+class VirtualListBox : public WidgetPC, public IListModelListener {
+    public:
+        explicit VirtualListBox(VirtualListModel* model = nullptr, const Font* font = nullptr);
+        ~VirtualListBox() override;
+
+        Signal<int> on_selection_changed;
+        Signal<int, const std::string&> on_item_activated;
+
+        void draw(const DrawEvent& de) const override;
+        Rect children_area() const override;
+
+        /** Sets the model to use. */
+        void set_model(VirtualListModel* model);
+        /** Return the model in use. */
+        VirtualListModel* model() { return mmodel; }
+        /** Return the model in use. */
+        const VirtualListModel* model() const { return mmodel; }
+
+        int selected_idx() const { return mselected_idx; }
+        /** Select an item and scroll it into view. Pass -1 to select nothing. */
+        void set_selected_idx(int idx);
+
+        /** Scroll so that the item with the index `idx` is completely visible. */
+        void make_visible(int idx);
+
+        /** Return the scroll offset in pixels from the top of the list. */
+        int64_t scroll_offset() const { return mscroll; }
+        /** Scroll to an offset in pixels from the top. The offset will be clipped to the valid range. */
+        void scroll_to_offset(int64_t offset);
+        /** Return the index of the first (at least partially) visible item. */
+        int first_visible_idx() const;
+
+        /** Set the number of items measured to estimate the width of the list when the items change. They
+         *  are sampled from a few places spread across the list. Items scrolled into view are measured in
+         *  addition. The default is 128. */
+        void set_width_samples(int samples) { mwidth_samples = samples; }
+        int width_samples() const { return mwidth_samples; }
+
+        void set_font(const Font* font) override;
+
+        Size min_size_hint() override;
+        MeasureResults measure(SizeConstraint wc, SizeConstraint hc) override;
+
+    protected:
+        void style_changed() override;
+        void resized(const Size& old_size) override;
+
+        void about_to_invalidate_items() override;
+        void items_added(int start_idx, int n) override;
+        void items_removed(int start_idx, int n) override;
+        void items_invalidated() override;
+        void model_about_to_die() override;
+
+        void mouse_pressed(MouseEvent& event) override;
+        void mouse_dragged(MouseEvent& event) override;
+        void mouse_wheel_down(MouseEvent& event) override;
+        void mouse_wheel_up(MouseEvent& event) override;
+        void key_char(KeyEvent& event) override;
+        void key_pressed(KeyEvent& event) override;
+
+    private:
+        int64_t total_height() const;
+        int64_t max_scroll() const;
+        int get_idx_from_pos(const Position& pos) const;
+        Rect rect_for_item(int idx) const;
+        void sample_widths(int start_idx, int n);
+        void update_visible_runs();
+        void update_scrollbar();
+        void y_scrolled(int new_pos);
+        void emit_activated();
+
+        ScrollBar mvert_scrollbar;
+        Padding mpadding, mlist_padding;
+        VirtualListModel* mmodel;
+        std::vector<TextRun> mvisible_runs; // for the items in view, starting at mvisible_first
+        int mvisible_first;
+        int64_t mscroll;
+        int mscrollbar_scale; // pixels per scroll bar unit
+        int mselected_idx, mitem_height, mmax_width, mwidth_samples;
+        bool mupdating_scrollbar;
+};
+
+}
+
+#endif // LGUI_VIRTUALLISTBOX_H
@@ -0,0 +1,134 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "virtuallistmodel.h"
+#include <algorithm>
+#include "lgui/platform/error.h"
+
+namespace lgui {
+
+PagedListModel::PagedListModel(int no_items, PageFetcher fetcher, int page_size, int max_cached_pages)
+        : mfetcher(std::move(fetcher)), mno_items(no_items), mpage_size(page_size),
+          mmax_cached_pages(max_cached_pages), mpages_fetched(0) {
+    ASSERT(page_size > 0);
+    ASSERT(max_cached_pages > 0);
+}
+
+std::string PagedListModel::item_at(int idx) const {
+    ASSERT(is_valid_index(idx));
+    const std::vector<std::string>& p = page(idx / mpage_size);
+    size_t i = idx % mpage_size;
+    return i < p.size() ? p[i] : std::string();
+}
+
+const std::vector<std::string>& PagedListModel::page(int page_idx) const {
+    auto it = mpage_map.find(page_idx);
+    if (it != mpage_map.end()) {
+        mpages.splice(mpages.begin(), mpages, it->second);
+        return it->second->second;
+    }
+    if (signed(mpages.size()) >= mmax_cached_pages) {
+        mpage_map.erase(mpages.back().first);
+        mpages.pop_back();
+    }
+    mpages.emplace_front(page_idx, std::vector<std::string>());
+    mpage_map[page_idx] = mpages.begin();
+    int first = page_idx * mpage_size;
+    std::vector<std::string>& items = mpages.front().second;
+    if (mfetcher) {
+        items.reserve(mpage_size);
+        mfetcher(first, std::min(mpage_size, mno_items - first), items);
+    }
+    mpages_fetched++;
+    return items;
+}
+
+void PagedListModel::drop_pages_from(int page_idx) {
+    for (auto it = mpages.begin(); it != mpages.end();) {
+        if (it->first >= page_idx) {
+            mpage_map.erase(it->first);
+            it = mpages.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+void PagedListModel::set_fetcher(PageFetcher fetcher) {
+    emit_about_to_invalidate_items();
+    mfetcher = std::move(fetcher);
+    drop_pages_from(0);
+    emit_items_invalidated();
+}
+
+void PagedListModel::set_no_items(int no_items) {
+    ASSERT(no_items >= 0);
+    if (no_items > mno_items) {
+        int old = mno_items;
+        emit_about_to_add_items(old, no_items - old);
+        // the formerly last page may have been fetched incompletely
+        drop_pages_from(old / mpage_size);
+        mno_items = no_items;
+        emit_items_added(old, no_items - old);
+    }
+    else if (no_items < mno_items) {
+        int n = mno_items - no_items;
+        emit_about_to_remove_items(no_items, n);
+        drop_pages_from(no_items / mpage_size);
+        mno_items = no_items;
+        emit_items_removed(no_items, n);
+    }
+}
+
+void PagedListModel::invalidate() {
+    emit_about_to_invalidate_items();
+    drop_pages_from(0);
+    emit_items_invalidated();
+}
+
+void PagedListModel::set_max_cached_pages(int max_pages) {
+    ASSERT(max_pages > 0);
+    mmax_cached_pages = max_pages;
+    while (signed(mpages.size()) > mmax_cached_pages) {
+        mpage_map.erase(mpages.back().first);
+        mpages.pop_back();
+    }
+}
+
+}
@@ -0,0 +1,117 @@
+/*   _                _
+*   | |              (_)
+*   | |  __ _  _   _  _
+*   | | / _` || | | || |
+*   | || (_| || |_| || |
+*   |_| \__, | \__,_||_|
+*        __/ |
+*       |___/
+*
+* Copyright (c) 2015-22 frank256
+*
+* License (BSD):
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice, this
+*    list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice, this
+*    list of conditions and the following disclaimer in the documentation and/or
+*    other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LGUI_VIRTUALLISTMODEL_H
+#define LGUI_VIRTUALLISTMODEL_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include "abstractlistmodel.h"
+
+namespace lgui {
+
+/** An abstract list model for very large lists that doesn't have to hold its items: views ask for items by
+ *  index on demand, and only for the items they are about to display (plus a few samples for estimating
+ *  their width). Use it with VirtualListBox. Derived classes report changes to listeners via the emit_*
+ *  methods of AbstractListModel as usual. */
+class VirtualListModel : public AbstractListModel {
+    public:
+        /** Return the number of items. */
+        virtual int no_items() const = 0;
+
+        /** Return the item at `idx`. Only called with valid indices. */
+        virtual std::string item_at(int idx) const = 0;
+
+        /** Return whether the index is valid. */
+        bool is_valid_index(int idx) const {
+            return idx >= 0 && idx < no_items();
+        }
+};
+
+/** A VirtualListModel fetching its items page-wise via a user-provided function. The most recently used pages
+ *  are kept in a cache, so scrolling through the list only fetches every page once while it is in view. */
+class PagedListModel : public VirtualListModel {
+    public:
+        /** A function fetching `n` items starting at index `first` and appending them to `items`. */
+        using PageFetcher = std::function<void(int first, int n, std::vector<std::string>& items)>;
+
+        explicit PagedListModel(int no_items = 0, PageFetcher fetcher = PageFetcher(), int page_size = 256,
+                                int max_cached_pages = 64);
+
+        int no_items() const override { return mno_items; }
+        std::string item_at(int idx) const override;
+
+        /** Set the function used to fetch pages. Clears the cache and invalidates all items. */
+        void set_fetcher(PageFetcher fetcher);
+
+        /** Change the number of items. Growing (e.g. a log that has been appended to) will report the new
+         *  items as added, shrinking will report the items at the end as removed. */
+        void set_no_items(int no_items);
+
+        /** Drop all cached pages and tell listeners all items have changed. */
+        void invalidate();
+
+        int page_size() const { return mpage_size; }
+
+        int max_cached_pages() const { return mmax_cached_pages; }
+        void set_max_cached_pages(int max_pages);
+
+        /** Return the number of pages fetched so far. */
+        int pages_fetched() const { return mpages_fetched; }
+
+    private:
+        using Page = std::pair<int, std::vector<std::string>>;
+
+        const std::vector<std::string>& page(int page_idx) const;
+        void drop_pages_from(int page_idx);
+
+        PageFetcher mfetcher;
+        int mno_items, mpage_size, mmax_cached_pages;
+        // most recently used first
+        mutable std::list<Page> mpages;
+        mutable std::unordered_map<int, std::list<Page>::iterator> mpage_map;
+        mutable int mpages_fetched;
+};
+
+}
+
+#endif // LGUI_VIRTUALLISTMODEL_H
@@ -50,7 +50,7 @@ PushButton::PushButton() {
 
 PushButton::PushButton(const std::string& text)
         : PushButton() {
-    mtext = text;
+    mtext.set_text(text);
 }
 
 void PushButton::draw(const DrawEvent& de) const {
@@ -66,8 +66,8 @@ Size PushButton::min_size_hint() {
 }
 
 void PushButton::set_text(const std::string& text) {
-    if (mtext != text) {
-        mtext = text;
+    if (mtext.text() != text) {
+        mtext.set_text(text);
         request_layout();
     }
 }
@@ -41,6 +41,7 @@
 #define LGUI_PUSHBUTTON_H
 
 #include "abstractbutton.h"
+#include "lgui/platform/textrun.h"
 #include <string>
 
 namespace lgui {
@@ -56,11 +57,11 @@ class PushButton : public AbstractButton {
         MeasureResults measure(SizeConstraint wc, SizeConstraint hc) override;
         Size min_size_hint() override;
 
-        const std::string& text() const { return mtext; }
+        const std::string& text() const { return mtext.text(); }
         void set_text(const std::string& text);
 
     private:
-        std::string mtext;
+        TextRun mtext;
 };
 
 }
@@ -320,7 +320,7 @@ MeasureResults ScrollArea::measure_content(SizeConstraint wc, SizeConstraint hc)
         cwc = SizeConstraint(wc.value() - mpadding.horz(), mode);
         // Do we need a scrollbar in the other direction?
         if (hc.mode() != SizeConstraintMode::NoLimits) {
-            MeasureResults mr = mcontent->measure(cwc, chc);
+            MeasureResults mr = mcontent->measure_cached(cwc, chc);
             // Don't have to care about a horizontal scrollbar here, because it is
             // effectively disabled.
             if (mr.h() > hc.value() - mpadding.vert()) { // Yes: remeasure below
@@ -339,7 +339,7 @@ MeasureResults ScrollArea::measure_content(SizeConstraint wc, SizeConstraint hc)
         chc = SizeConstraint(hc.value() - mpadding.vert(), mode);
         // Do we need a scrollbar in the other direction?
         if (wc.mode() != SizeConstraintMode::NoLimits) {
-            MeasureResults mr = mcontent->measure(cwc, chc);
+            MeasureResults mr = mcontent->measure_cached(cwc, chc);
             // Don't have to care about a vertical scrollbar here, because it is
             // effectively disabled.
             if (mr.w() > wc.value() - mpadding.horz()) // Yes: remeasure below
@@ -349,7 +349,7 @@ MeasureResults ScrollArea::measure_content(SizeConstraint wc, SizeConstraint hc)
         }
     }
 
-    return mcontent->measure(cwc, chc);
+    return mcontent->measure_cached(cwc, chc);
 }
 
 MeasureResults ScrollArea::measure(SizeConstraint wc, SizeConstraint hc) {
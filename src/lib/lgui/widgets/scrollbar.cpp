@@ -83,6 +83,7 @@ void ScrollBar::setup(int total_scroll, int window_wh, int bar_wh, int init_pos,
 }
 
 void ScrollBar::calc_handle() {
+    invalidate();
     double handle_pos = (mscroll_pos / double(mtotal_scroll)) * mbar_wh;
     double handle_len = mwindow_wh / double(mtotal_scroll) * mbar_wh;
     if (handle_len < 1)
@@ -168,6 +168,7 @@ Size Slider::min_size_hint() {
 
 
 void Slider::update_handle() {
+    invalidate();
     int p = roundf(fraction() * total_slider_dist());
     if (morientation == Horizontal)
         mhandle_rect.set_pos(p, 0);
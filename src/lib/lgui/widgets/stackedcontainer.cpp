@@ -61,14 +61,14 @@ MeasureResults StackedContainer::measure(SizeConstraint wc, SizeConstraint hc) {
     if (mlayout_consider_active_only && mactive_widget) {
         const Padding& p = padding();
         return force_size_constraints(
-                mactive_widget->measure(wc.sub(p.horz()), hc.sub(p.vert())).add_padding(padding()),
+                mactive_widget->measure_cached(wc.sub(p.horz()), hc.sub(p.vert())).add_padding(padding()),
                 wc, hc);
     }
     else {
         Size r(0, 0);
         TooSmallAccumulator ts;
         for (Widget* c : (*this)) {
-            Size s = ts.consider(c->measure(wc.adapted_for_child(), hc.adapted_for_child()));
+            Size s = ts.consider(c->measure_cached(wc.adapted_for_child(), hc.adapted_for_child()));
             r.set_w(std::max(r.w(), s.w()));
             r.set_h(std::max(r.h(), s.h()));
         }
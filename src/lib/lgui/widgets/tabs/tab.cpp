@@ -71,7 +71,10 @@ void Tab::set_tab_bar(TabBar* tab_bar) {
 }
 
 void Tab::set_selected(bool sel) {
-    mis_selected = sel;
+    if (mis_selected != sel) {
+        mis_selected = sel;
+        invalidate();
+    }
 }
 
 MeasureResults Tab::measure(SizeConstraint wc, SizeConstraint hc) {
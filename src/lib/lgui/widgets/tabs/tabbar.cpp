@@ -140,6 +140,7 @@ void TabBar::set_selected_tab(int idx) {
         new_tab.set_selected(true);
         mselected_tab = &new_tab;
         mselected_tab_idx = idx;
+        invalidate(); // The selected tab's outline is drawn by us.
         ensure_tab_visible(*mselected_tab);
         on_tab_selected.emit(mselected_tab);
     }
@@ -350,9 +351,11 @@ void TabBar::ensure_tab_visible(const Tab& tab) {
     if (tab.pos_x() < mscrollx) {
         mscrollx = tab.pos_x();
         mno_left_line = true; // (partly) fix glitch
+        invalidate();
     }
     else if (tab.pos_x() + tab.width() > mscrollx + visible_width()) {
         mscrollx = tab.width() + tab.pos_x() - visible_width();
+        invalidate();
     }
     update_scroll_buttons_disabled();
 }
@@ -37,6 +37,8 @@
 * THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
+#include <climits>
 #include "textbox.h"
 
 #include "lgui/platform/clipboard.h"
@@ -44,6 +46,7 @@
 #include "lgui/platform/font.h"
 #include "lgui/platform/utf8.h"
 #include "lgui/platform/graphics.h"
+#include "lgui/textsource.h"
 #include "lgui/mouseevent.h"
 #include "lgui/keyevent.h"
 #include "lgui/style/style.h"
@@ -52,6 +55,10 @@ namespace lgui {
 
 const int MIN_WIDTH_CWH = 6, MIN_HEIGHT_LINES = 3;
 const int WANT_WIDTH_CWH = 60, WANT_HEIGHT_LINES = 20;
+// lines of a TextSource longer than this are cut off for display
+const size_t SOURCE_MAX_LINE_BYTES = 1 << 16;
+// initial size of the window of text searched for a word boundary
+const size_t WORD_BOUNDARY_WINDOW = 1 << 10;
 
 TextBox::TextBox(const std::string& initial_text, const Font* font)
         : mtext(initial_text),
@@ -59,8 +66,11 @@ TextBox::TextBox(const std::string& initial_text, const Font* font)
           mvert_scrollbar(Vertical),
           mscroll(0, 0),
           manchor_rowcol(-1, -1),
-          manchor_tpx(-1, -1), mmax_line_width(0),
+          manchor_tpx(-1, -1),
           mwrap_mode(WrapMode::FittingWords),
+          mrows_wrap_width(0), mrows_dirty(true),
+          msource(nullptr), msource_first_line(0), msource_max_width(0),
+          msource_rows_reach_end(false),
           mread_only(false) {
     mhorz_scrollbar.on_scrolled.connect(&TextBox::x_scrolled, *this);
     mvert_scrollbar.on_scrolled.connect(&TextBox::y_scrolled, *this);
@@ -90,11 +100,25 @@ void TextBox::draw(const DrawEvent& de) const {
     style().draw_text_box_bg(de.gfx(), style_args);
 
     int x = -mscroll.x() + mtext_margins.left();
+
+    if (msource) {
+        int y = signed(msource_first_line) * line_height() - mscroll.y() + mtext_margins.top();
+        for (const std::string& row_text : msource_row_texts) {
+            de.gfx().draw_text_clipped_to_rect(font(), x + offs.x(), y + offs.y(),
+                                               style().text_field_text_color(style_args.state, de.opacity()),
+                                               clip_rect, row_text);
+            y += line_height();
+        }
+        style().draw_text_box_fg(de.gfx(), style_args);
+        draw_private_children(de, false);
+        return;
+    }
+
     int sy = -mscroll.y() + mtext_margins.top();
 
     int start_line = -sy / line_height();
     sy += start_line * line_height();
-    int end_line = std::min(start_line + clip_rect.h() / line_height() + 2, signed(mtext_lines.size()));
+    int end_line = std::min(start_line + clip_rect.h() / line_height() + 2, signed(mrows.size()));
 
     int y = sy;
 
@@ -112,10 +136,13 @@ void TextBox::draw(const DrawEvent& de) const {
             de.gfx().filled_rect(r, style().text_field_selection_color(style_args.state, de.opacity()));
         }
     }
+    size_t row_offs = start_line < end_line ? mrows.byte_offset(start_line) : 0;
     for (int i = start_line; i < end_line; i++) {
+        const dtl::TextRow& row = mrows[i];
         de.gfx().draw_text_clipped_to_rect(font(), x + offs.x(), y + offs.y(),
                                            style().text_field_text_color(style_args.state, de.opacity()), clip_rect,
-                                           mtext_lines[i]);
+                                           mtext.substr(row_offs, row.size));
+        row_offs += row.size + row.split_cwidth;
         y += line_height();
     }
 
@@ -133,29 +160,51 @@ void TextBox::draw(const DrawEvent& de) const {
 }
 
 void TextBox::set_text(const std::string& text) {
-    mtext = text;
+    mtext.assign(text);
+    mrows_dirty = true;
     update_rows();
-    on_text_changed.emit(mtext);
+    emit_text_changed();
+}
+
+void TextBox::set_source(const TextSource* source) {
+    msource = source;
+    mline_index.reset(source);
+    msource_rows.clear();
+    msource_row_texts.clear();
+    msource_first_line = 0;
+    msource_max_width = 0;
+    msource_rows_reach_end = false;
+    select_none();
+    mcaret_rowcol = Point(0, 0);
+    mscroll = Point(0, 0);
+    mtext.clear();
+    mrows.clear();
+    mrows_dirty = true;
+    set_receive_timer_ticks(has_focus() || !mline_index.is_complete());
+    update_rows();
+    update_caret_tpx_location();
 }
 
 void TextBox::set_font(const Font* font) {
     Widget::set_font(font);
-    // react
+    mrows_dirty = true;
+    update_rows();
 }
 
 void TextBox::select_none() {
     manchor_rowcol = manchor_tpx = Point(-1, -1);
     mselection_tpx.clear();
+    invalidate();
 }
 
 void TextBox::select_all() {
-    if (mtext.empty() || mtext_lines.empty()) {
+    if (mtext.empty() || mrows.empty()) {
         select_none();
         return;
     }
     manchor_rowcol = Point(0, 0);
-    mcaret_rowcol = Point(mtext_lines_chrlen.back(),
-                          mtext_lines.size() - 1);
+    mcaret_rowcol = Point(mrows.back().chrlen,
+                          mrows.size() - 1);
     update_caret_tpx_location();
     update_selection();
     scroll_to_caret();
@@ -169,6 +218,7 @@ void TextBox::style_changed() {
     WidgetPC::style_changed();
     // do something
     mcursor_width = style().text_field_cursor_width();
+    mrows_dirty = true;
 
     auto padd = style().text_box_padding();
     mpadding = padd.widget;
@@ -202,7 +252,7 @@ bool TextBox::update_caret_position_from_mouse(Point mp, bool clip_outside_margi
             return false;
     }
     tpx -= mtext_margins.left_top_offs();
-    Rect(0, 0, mmax_line_width + mcursor_width, line_height() * mtext_lines.size())
+    Rect(0, 0, mrows.max_width() + mcursor_width, line_height() * mrows.size())
             .clip_point(tpx);
     Point rc = tpx_to_rowcol(tpx, true);
     if (rc.x() >= 0 && rc.y() >= 0) {
@@ -252,6 +302,13 @@ void TextBox::mouse_wheel_up(MouseEvent& event) {
 
 void TextBox::timer_ticked(const TimerTickEvent& event) {
     mcursor_blink_helper.timer_tick(event);
+    if (msource && !mline_index.is_complete()) {
+        // The source is indexed in the background; the scroll range grows as lines are found.
+        if (mline_index.update())
+            update_rows();
+        if (mline_index.is_complete() && !has_focus())
+            set_receive_timer_ticks(false);
+    }
 }
 
 void TextBox::focus_gained(FocusEvent& event) {
@@ -261,11 +318,16 @@ void TextBox::focus_gained(FocusEvent& event) {
 
 void TextBox::focus_lost(FocusEvent& event) {
     (void) event;
-    set_receive_timer_ticks(false);
+    set_receive_timer_ticks(msource && !mline_index.is_complete());
 }
 
 
 void TextBox::key_char(KeyEvent& event) {
+    if (msource) {
+        if (scroll_source_keyboard(event))
+            event.consume();
+        return;
+    }
     if (!event.repeated() && keyboard_hotkeys(event)) {
         event.consume();
         return;
@@ -304,20 +366,134 @@ void TextBox::key_char(KeyEvent& event) {
     }
 }
 
-void TextBox::do_update_rows() {
-    mtext_lines.clear();
-    mtext_lines_chrlen.clear();
-    mtext_line_split_cwidth.clear();
+int TextBox::wrap_width() const {
     if (mwrap_mode == WrapMode::None)
-        make_rows_newlines(mtext);
+        return 0;
+    return width_available() - mcursor_width - mtext_margins.horz();
+}
+
+void TextBox::make_rows(const std::string& text, int wrap_width) {
+    if (mwrap_mode == WrapMode::None)
+        make_rows_newlines(text);
     else
-        make_rows_wordwrap(mtext, width_available() - mcursor_width - mtext_margins.horz(),
-                           mwrap_mode);
+        make_rows_wordwrap(text, wrap_width, mwrap_mode);
+}
+
+void TextBox::do_update_rows() {
+    if (msource) {
+        update_source_rows();
+        return;
+    }
+    int ww = wrap_width();
+    // Rows are still valid if only the height changed or a scroll bar toggled without affecting the width.
+    if (!mrows_dirty && ww == mrows_wrap_width)
+        return;
+    make_rows(mtext.str(), ww);
+    mrows.assign(mnew_rows);
+    mnew_rows.clear();
+    mrows_wrap_width = ww;
+    mrows_dirty = false;
+}
+
+void TextBox::update_source_rows() {
+    const int lh = line_height();
+    msource_first_line = size_t(std::max(mscroll.y() - mtext_margins.top(), 0) / lh);
+    size_t rows_needed = size_t(std::max(height_available(), 0) / lh + 2);
+    mline_index.index_up_to_line(msource_first_line + rows_needed);
+
+    // Lines aren't wrapped: the scroll range is measured in lines, which only stays true with one row per
+    // line, and wrapping would need all lines above the visible ones to be laid out.
+    msource_row_texts.clear();
+    size_t line = msource_first_line;
+    for (; line < mline_index.line_count() && mnew_rows.size() < rows_needed; line++) {
+        std::string text = mline_index.line_text(line, SOURCE_MAX_LINE_BYTES);
+        add_row(text, 0, text.size(), 1, font().text_width(text));
+        msource_row_texts.push_back(std::move(text));
+    }
+    msource_rows_reach_end = mline_index.is_complete() && line >= mline_index.line_count();
+    for (const dtl::TextRow& row : mnew_rows)
+        msource_max_width = std::max(msource_max_width, row.width);
+    msource_rows.swap(mnew_rows);
+    mnew_rows.clear();
+}
+
+bool TextBox::scroll_source_keyboard(const KeyEvent& ke) {
+    if (!mvert_scrollbar.is_visible())
+        return false;
+    int page = std::max(height_available() - line_height(), line_height());
+    switch (ke.key_code()) {
+        case Keycodes::KEY_UP:
+            mvert_scrollbar.scroll_to(mscroll.y() - line_height());
+            return true;
+        case Keycodes::KEY_DOWN:
+            mvert_scrollbar.scroll_to(mscroll.y() + line_height());
+            return true;
+        case Keycodes::KEY_PGUP:
+            mvert_scrollbar.scroll_to(mscroll.y() - page);
+            return true;
+        case Keycodes::KEY_PGDN:
+            mvert_scrollbar.scroll_to(mscroll.y() + page);
+            return true;
+        case Keycodes::KEY_HOME:
+            mvert_scrollbar.scroll_to_begin();
+            return true;
+        case Keycodes::KEY_END:
+            mvert_scrollbar.scroll_to_end();
+            return true;
+        default:
+            return false;
+    }
+}
+
+void TextBox::emit_text_changed() {
+    // Don't materialize the text for nobody.
+    if (on_text_changed.has_slots())
+        on_text_changed.emit(mtext.str());
+}
+
+void TextBox::rewrap_edited_rows(size_t pos, size_t removed, size_t inserted) {
+    if (mrows_dirty || mrows.empty() || mtext.empty()) {
+        mrows_dirty = true;
+        return;
+    }
+    const size_t npos = std::string::npos;
+
+    // Paragraphs (delimited by '\n') touched by the edit, in terms of the new text.
+    size_t para_start = (pos == 0) ? npos : mtext.rfind('\n', pos - 1);
+    para_start = (para_start == npos) ? 0 : para_start + 1;
+    size_t para_end = mtext.find('\n', pos + inserted);
+    if (para_end == npos)
+        para_end = mtext.size();
+    // The same range ended here in the old text.
+    size_t old_para_end = para_end - inserted + removed;
+
+    // Rows covering the range: the last one is split at the terminating '\n' (or ends the text).
+    size_t row_start;
+    size_t first_row = mrows.row_at_byte_offset(para_start, row_start);
+    if (row_start != para_start || first_row == mrows.size()) {
+        // rows don't match the text: shouldn't happen
+        mrows_dirty = true;
+        return;
+    }
+    size_t last_row = mrows.row_at_byte_offset(old_para_end, row_start);
+    if (last_row == mrows.size()) {
+        mrows_dirty = true;
+        return;
+    }
+
+    std::string paras = mtext.substr(para_start, para_end - para_start);
+    if (paras.empty())
+        add_row(paras, 0, 0, 1, 0);
+    else
+        make_rows(paras, mrows_wrap_width);
+    mrows.replace(first_row, last_row + 1, mnew_rows);
+    mnew_rows.clear();
 }
 
 void TextBox::update_rows(bool second_pass) {
+    invalidate();
     do_update_rows();
-    if (mtext_lines.empty()) {
+    if (!msource && mrows.empty()) {
         mvert_scrollbar.set_invisible();
         mhorz_scrollbar.set_invisible();
         mscroll = Point(0, 0);
@@ -355,9 +531,7 @@ void TextBox::update_rows(bool second_pass) {
 
     if (need_h_scrollb) {
         // need scrollbar?
-        mhorz_scrollbar.setup(text_size.w(),
-                              width_available(), width_available() + mpadding.horz() - mscrollbar_padding.horz(),
-                              mscroll.x(), line_height());
+        setup_horz_scrollbar(text_size.w());
         mhorz_scrollbar.set_visible();
     }
     else {
@@ -382,6 +556,12 @@ void TextBox::update_rows(bool second_pass) {
     position_scrollbars();
 }
 
+void TextBox::setup_horz_scrollbar(int text_width) {
+    mhorz_scrollbar.setup(text_width,
+                          width_available(), width_available() + mpadding.horz() - mscrollbar_padding.horz(),
+                          mscroll.x(), line_height());
+}
+
 int TextBox::width_available() const {
     int cw = width() - mpadding.horz();
     if (mvert_scrollbar.is_visible())
@@ -437,7 +617,7 @@ bool TextBox::move_caret_keyboard(const KeyEvent& ke) {
                 position_caret_keyboard(mcaret_rowcol + Point(-1, 0), PosColMode::Wrap);
             else {
                 size_t caret_offs = rowcol_to_textoffs(mcaret_rowcol);
-                size_t nc = utf8::skip_to_next_word_boundary(mtext, caret_offs, true);
+                size_t nc = word_boundary(caret_offs, true);
                 position_caret_keyboard(texoffs_to_rowcol(nc), PosColMode::Fixed);
             }
             return true;
@@ -446,7 +626,7 @@ bool TextBox::move_caret_keyboard(const KeyEvent& ke) {
                 position_caret_keyboard(mcaret_rowcol + Point(1, 0), PosColMode::Wrap);
             else {
                 size_t caret_offs = rowcol_to_textoffs(mcaret_rowcol);
-                size_t nc = utf8::skip_to_next_word_boundary(mtext, caret_offs, false);
+                size_t nc = word_boundary(caret_offs, false);
                 position_caret_keyboard(texoffs_to_rowcol(nc), PosColMode::Fixed);
             }
             return true;
@@ -464,12 +644,12 @@ bool TextBox::move_caret_keyboard(const KeyEvent& ke) {
                                         PosColMode::Fixed);
             return true;
         case Keycodes::KEY_END:
-            if (!mtext_lines.empty()) {
+            if (!mrows.empty()) {
                 if (ke.modifiers() & KeyModifiers::KEYMOD_CTRL)
-                    position_caret_keyboard(Point(mtext_lines_chrlen.back(), mtext_lines.size() - 1),
+                    position_caret_keyboard(Point(mrows.back().chrlen, mrows.size() - 1),
                                             PosColMode::Fixed);
                 else
-                    position_caret_keyboard(Point(mtext_lines_chrlen[mcaret_rowcol.y()], mcaret_rowcol.y()),
+                    position_caret_keyboard(Point(mrows[mcaret_rowcol.y()].chrlen, mcaret_rowcol.y()),
                                             PosColMode::Fixed);
             }
             return true;
@@ -506,37 +686,37 @@ bool TextBox::keyboard_hotkeys(const KeyEvent& ke) {
 
 void TextBox::position_caret_keyboard(Point nrc, PosColMode pcm) {
     //debug("\nloc-in : %d, %d", nrc.x(), nrc.y());
-    if (!mtext_lines.empty()) {
+    if (!mrows.empty()) {
         if (nrc.y() < 0)
             nrc.set_y(0);
-        else if (nrc.y() >= signed(mtext_lines.size()))
-            nrc.set_y(signed(mtext_lines.size() - 1));
+        else if (nrc.y() >= signed(mrows.size()))
+            nrc.set_y(signed(mrows.size() - 1));
 
         if (pcm == PosColMode::Fixed)
             mcaret_rowcol = clip_row_col(nrc);
         else if (pcm == PosColMode::Search) {
             if (nrc.y() != mcaret_rowcol.y()) {
                 int px = mcaret_tpx.x();
-                int new_col = font().hit_char(mtext_lines[nrc.y()], px).second;
+                int new_col = font().hit_char(row_text(nrc.y()), px).second;
                 nrc.set_x(new_col);
             }
         }
         else { // Wrap
-            bool last_char_access = mtext_line_split_cwidth[nrc.y()];
-            if (nrc.x() >= mtext_lines_chrlen[nrc.y()] + (last_char_access ? 1 : 0)) {
-                if (nrc.y() < signed(mtext_lines.size()) - 1) {
+            bool last_char_access = mrows[nrc.y()].split_cwidth;
+            if (nrc.x() >= mrows[nrc.y()].chrlen + (last_char_access ? 1 : 0)) {
+                if (nrc.y() < signed(mrows.size()) - 1) {
                     nrc.set_y(nrc.y() + 1);
                     nrc.set_x(0);
                 }
                 else // last line: can always access last position
-                    nrc.set_x(mtext_lines_chrlen.back());
+                    nrc.set_x(mrows.back().chrlen);
             }
             else if (nrc.x() < 0) {
                 if (nrc.y() > 0) {
                     nrc.set_y(nrc.y() - 1);
                     // y changed here:
-                    bool last_char_access_ny = mtext_line_split_cwidth[nrc.y()];
-                    nrc.set_x(mtext_lines_chrlen[nrc.y()]
+                    bool last_char_access_ny = mrows[nrc.y()].split_cwidth;
+                    nrc.set_x(mrows[nrc.y()].chrlen
                               - (last_char_access_ny ? 0 : 1));
 
                 }
@@ -559,11 +739,13 @@ void TextBox::position_caret_keyboard(Point nrc, PosColMode pcm) {
 
 void TextBox::update_caret_tpx_location() {
     mcaret_tpx = rowcol_to_tpx(mcaret_rowcol);
+    invalidate();
 }
 
 void TextBox::update_selection() {
     mselection_tpx.clear();
-    if (mtext_lines.empty() || !has_selection() ||
+    invalidate();
+    if (mrows.empty() || !has_selection() ||
         mcaret_rowcol == manchor_rowcol) {
         return;
     }
@@ -581,7 +763,7 @@ void TextBox::update_selection() {
     Point spx = start_tpx;
 
     for (int y = start.y(); y < end.y(); y++) {
-        int epx = text_width(mtext_lines[y]);
+        int epx = mrows[y].width;
         // empty lines symbolised by space
         if (epx <= 0)
             epx = text_width(" ");
@@ -601,13 +783,14 @@ void TextBox::remove_selection() {
         return;
     if (c < a)
         std::swap(a, c);
-    mtext.erase(mtext.begin() + a, mtext.begin() + c);
+    mtext.erase(a, c - a);
     select_none();
+    rewrap_edited_rows(a, c - a, 0);
     update_rows();
     mcaret_rowcol = texoffs_to_rowcol(a);
     update_caret_tpx_location();
     scroll_to_caret();
-    on_text_changed.emit(mtext);
+    emit_text_changed();
 }
 
 bool TextBox::remove_chr(bool backspace) {
@@ -615,16 +798,25 @@ bool TextBox::remove_chr(bool backspace) {
         return false;
     size_t c = rowcol_to_textoffs(mcaret_rowcol);
     if (backspace) {
-        if (!utf8::prev_cp(mtext, c))
+        // a code point takes up to 4 bytes
+        size_t from = c >= 4 ? c - 4 : 0;
+        std::string before = mtext.substr(from, c - from);
+        size_t pos = before.size();
+        if (!utf8::prev_cp(before, pos))
             return false;
+        c = from + pos;
     }
-    bool success = utf8::remove_chr(mtext, c);
+    std::string chr = mtext.substr(c, 4);
+    size_t chr_size = 0;
+    bool success = utf8::next_cp(chr, chr_size);
     if (success) {
+        mtext.erase(c, chr_size);
+        rewrap_edited_rows(c, chr_size, 0);
         update_rows();
         mcaret_rowcol = texoffs_to_rowcol(c);
         update_caret_tpx_location();
         scroll_to_caret();
-        on_text_changed.emit(mtext);
+        emit_text_changed();
     }
     return success;
 }
@@ -635,12 +827,13 @@ int TextBox::insert_string(const std::string& str) {
     size_t caret = rowcol_to_textoffs(mcaret_rowcol);
     int cps = utf8::length_cps(str);
     mtext.insert(caret, str);
-    caret += cps;
+    rewrap_edited_rows(caret, 0, str.size());
+    caret += str.size();
     update_rows();
     mcaret_rowcol = texoffs_to_rowcol(caret);
     update_caret_tpx_location();
     scroll_to_caret();
-    on_text_changed.emit(mtext);
+    emit_text_changed();
     return cps;
 }
 
@@ -712,31 +905,46 @@ bool TextBox::is_move_key(int key) {
 }
 
 
-void TextBox::add_row(const std::string& text, size_t offs, size_t size, int split_c_w) {
-    std::string line = text.substr(offs, size);
-    mtext_lines.emplace_back(line);
-    int w = text_width(mtext_lines.back());
-    mmax_line_width = std::max(mmax_line_width, w);
-    mtext_line_split_cwidth.emplace_back(split_c_w);
-    mtext_lines_chrlen.emplace_back(utf8::length_cps(mtext_lines.back()));
+void TextBox::add_row(const std::string& text, size_t offs, size_t size, int split_c_w, int width) {
+    if (size > text.size() - offs) // will catch npos
+        size = text.size() - offs;
+    int chrlen = utf8::length_cps_substr(text, offs, offs + size);
+    mnew_rows.push_back(dtl::TextRow{size, chrlen, width, uint8_t(split_c_w)});
+}
+
+std::string TextBox::row_text(size_t row) const {
+    return mtext.substr(mrows.byte_offset(row), mrows[row].size);
+}
+
+size_t TextBox::word_boundary(size_t offs, bool backwards) const {
+    // Widen the window as long as the boundary found is just its edge.
+    for (size_t window = WORD_BOUNDARY_WINDOW;; window *= 2) {
+        size_t start = backwards ? offs - std::min(offs, window) : offs;
+        size_t end = backwards ? offs : std::min(offs + window, mtext.size());
+        // don't start in the middle of a code point
+        while (start > 0 && (mtext.at(start) & 0xc0) == 0x80)
+            start--;
+        size_t b = start + utf8::skip_to_next_word_boundary(mtext.substr(start, end - start), offs - start,
+                                                            backwards);
+        if (backwards ? (b > start || start == 0) : (b < end || end == mtext.size()))
+            return b;
+    }
 }
 
 void TextBox::make_rows_newlines(const std::string& text) {
-    mmax_line_width = 0;
     if (text.empty())
         return;
     size_t last_line_start = 0, pos = 0;
     do {
         pos = text.find('\n', last_line_start);
-        add_row(text, last_line_start, (pos == std::string::npos)
-                                       ? pos : pos - last_line_start, 1);
+        size_t size = (pos == std::string::npos) ? pos : pos - last_line_start;
+        add_row(text, last_line_start, size, 1, font().text_width(text, last_line_start, size));
         last_line_start = pos + 1;
     } while (pos != std::string::npos);
 }
 
 void TextBox::make_rows_wordwrap(const std::string& text, int max_width, enum WrapMode wm) {
     const char* whitespace = " \t\r\n";
-    mmax_line_width = 0;
     if (text.empty() || max_width <= 0)
         return;
 
@@ -751,9 +959,18 @@ void TextBox::make_rows_wordwrap(const std::string& text, int max_width, enum Wr
 
     const size_t npos = std::string::npos;
 
+    // the width of the rest of a split word is carried forward: measuring the whole rest again after
+    // each split would be quadratic in the length of the word
+    size_t rest_start = npos;
+    int rest_width = 0;
+
     while (!finished) {
-        int word_width = fnt.text_width(text, last_word,
-                                        (next_word != npos) ? next_word - last_word : npos);
+        int word_width;
+        // only use the carried width while the rest is clearly too wide: its last row is measured exactly
+        if (last_word == rest_start && rest_width > 2 * max_width)
+            word_width = rest_width;
+        else
+            word_width = fnt.text_width(text, last_word, (next_word != npos) ? next_word - last_word : npos);
         if (line_width + word_width > max_width) {
             // line would be too long with this word
             bool word_too_wide = word_width > max_width;
@@ -766,40 +983,42 @@ void TextBox::make_rows_wordwrap(const std::string& text, int max_width, enum Wr
                     word_size = next_word - last_word;
                 else
                     word_size = text.size() - last_word;
-                unsigned int split_idx = 1;
-                for (; split_idx < word_size; split_idx++) {
-                    int part_word_w = fnt.text_width(text, last_word, split_idx);
-                    if (part_word_w + line_width > max_width) {
-                        break;
-                    }
-                }
-                split_idx--;
+                int part_word_w;
+                // never split after the last character: the whole word doesn't fit anyway
+                size_t split_idx = fnt.fitting_prefix(text, last_word, word_size - 1, max_width - line_width,
+                                                      &part_word_w);
 
                 // in case even one character won't fit:
                 // force emitting at least one character to avoid endless loop
-                if (split_idx == 0 && line_start == last_word)
-                    split_idx++;
+                if (split_idx == 0 && line_start == last_word) {
+                    size_t pos = last_word;
+                    utf8::next_cp(text, pos);
+                    split_idx = pos - last_word;
+                    part_word_w = fnt.text_width(text, last_word, split_idx);
+                }
 
-                add_row(text, line_start, last_word + split_idx - line_start, 0);
+                add_row(text, line_start, last_word + split_idx - line_start, 0, line_width + part_word_w);
                 last_word = last_word + split_idx;
+                rest_start = last_word;
+                rest_width = word_width - part_word_w;
             }
             else { // not splitting: always the case for WrapMode::WholeWords
                 if (!word_too_wide || line_start < last_word) {
                     // emit start of line until current word
                     // (always applicable in case of WrapMode::FittingWords)
-                    add_row(text, line_start, last_word - line_start - 1, 1);
+                    add_row(text, line_start, last_word - line_start - 1, 1, line_width - space_width);
                 }
                 else {
                     // (may be applicable for WrapMode::WholeWords only)
                     if (next_word != npos) {
                         // emit whole word on one line
-                        add_row(text, line_start, next_word - line_start, 1);
+                        add_row(text, line_start, next_word - line_start, 1, word_width);
                         last_word = next_word + 1;
                         next_word = text.find_first_of(whitespace, next_word + 1);
                     }
                     else {
                         // emit last line
-                        add_row(text, line_start, next_word, 1);
+                        add_row(text, line_start, next_word, 1, word_width);
                         last_word = next_word;
                         finished = true;
                     }
@@ -810,21 +1029,21 @@ void TextBox::make_rows_wordwrap(const std::string& text, int max_width, enum Wr
         }
         else if (next_word != npos && text[next_word] == '\n') {
             // new line: make new line in any case
-            add_row(text, line_start, next_word - line_start, 1);
+            add_row(text, line_start, next_word - line_start, 1, line_width + word_width);
             last_word = line_start = next_word + 1;
             line_width = 0;
             next_word = text.find_first_of(whitespace, next_word + 1);
         }
         else if (next_word == npos) {
             // finished: add last line
-            add_row(text, line_start, next_word, 1); // will clip npos
+            add_row(text, line_start, next_word, 1, line_width + word_width); // will clip npos
             finished = true;
         }
         else {
             if (wm == Characters &&
                 line_width + word_width + space_width > max_width) {
                 // catch spaces leading to lines being too wide
-                add_row(text, line_start, next_word - line_start, 1);
+                add_row(text, line_start, next_word - line_start, 1, line_width + word_width);
                 last_word = next_word + 1;
                 line_start = last_word;
                 line_width = 0;
@@ -840,7 +1059,7 @@ void TextBox::make_rows_wordwrap(const std::string& text, int max_width, enum Wr
 }
 
 Point TextBox::tpx_to_rowcol(Point p, bool clip_to_text) const {
-    if (mtext_lines.empty())
+    if (mrows.empty())
         return Point(-1, -1); // not hit
 
     int row = p.y() / line_height();
@@ -848,33 +1067,34 @@ Point TextBox::tpx_to_rowcol(Point p, bool clip_to_text) const {
         // hit_char will clip x below
         if (row < 0)
             row = 0;
-        else if (row >= signed(mtext_lines.size()))
-            row = signed(mtext_lines.size() - 1);
+        else if (row >= signed(mrows.size()))
+            row = signed(mrows.size() - 1);
     }
     else {
-        if (row < 0 || row >= signed(mtext_lines.size()) ||
-            p.x() < 0 || p.x() >= mmax_line_width) {
+        if (row < 0 || row >= signed(mrows.size()) ||
+            p.x() < 0 || p.x() >= mrows.max_width()) {
             return Point(-1, -1); // not hit
         }
     }
     std::pair<size_t, size_t> h;
-    h = font().hit_char(mtext_lines.at(row), p.x());
+    h = font().hit_char(row_text(row), p.x());
     int col = h.second;
     return Point(col, row);
 }
 
 Point TextBox::rowcol_to_tpx(Point rc) const {
-    if (mtext_lines.empty())
+    if (mrows.empty())
         return Point(0, 0);
 
     Point rcc = clip_row_col(rc);
     int y = rcc.y() * line_height();
 
+    std::string row = row_text(rcc.y());
     size_t offs = 0;
     for (int i = 0; i < rcc.x(); i++)
-        utf8::next_cp(mtext_lines[rcc.y()], offs);
+        utf8::next_cp(row, offs);
 
-    int x = text_width(mtext_lines[rcc.y()].substr(0, offs));
+    int x = text_width(row.substr(0, offs));
 
     return Point(x, y);
 }
@@ -882,59 +1102,48 @@ Point TextBox::rowcol_to_tpx(Point rc) const {
 size_t TextBox::rowcol_to_textoffs(Point rc) const {
     if (rc.x() == -1 && rc.y() == -1)
         return std::string::npos;
-    if (mtext_lines.empty())
+    if (mrows.empty())
         return 0;
     Point rcc = clip_row_col(rc);
     //debug("\nClipped: %d, %d", rcc.x(), rcc.y());
-    size_t offs = 0;
-    for (int i = 0; i < rcc.y(); i++) {
-        //debug("\nline %d: %d + %d", i, mtext_lines[i].size(), mtext_line_split_cwidth[i]);
-        offs += mtext_lines[i].size() + mtext_line_split_cwidth[i];
-    }
+    size_t offs = mrows.byte_offset(rcc.y());
+    std::string row = mtext.substr(offs, mrows[rcc.y()].size);
     size_t line_offs = 0;
     for (int i = 0; i < rcc.x(); i++) {
-        utf8::next_cp(mtext_lines[rcc.y()], line_offs);
+        utf8::next_cp(row, line_offs);
     }
     return offs + line_offs;
 }
 
 Point TextBox::texoffs_to_rowcol(size_t offs) const {
-    if (mtext_lines.empty() || mtext.empty())
+    if (mrows.empty() || mtext.empty())
         return Point(0, 0);
 
-    int o = (signed) offs; // 2 GB will suffice
-
-    // o converted to signed can be < 0 if offs
-    // was larger than 2 GB
-    if (o < 0 || o >= signed(mtext.size())) {
-        int y = mtext_lines.size() - 1;
-        return Point(mtext_lines_chrlen[y], y);
+    if (offs >= mtext.size()) {
+        int y = mrows.size() - 1;
+        return Point(mrows.back().chrlen, y);
     }
 
-    int row = 0;
-    while (o - signed(mtext_lines[row].size()) - signed(mtext_line_split_cwidth[row]) >= 0
-           && row < signed(mtext_lines.size())) {
-        o -= mtext_lines[row].size() + mtext_line_split_cwidth[row];
-        row++;
-    }
-
-    int x = utf8::length_cps_substr(mtext_lines[row], 0, size_t(o));
+    size_t row_start;
+    size_t row = mrows.row_at_byte_offset(offs, row_start);
+    int x = utf8::length_cps(mtext.substr(row_start, offs - row_start));
 
     return Point(x, row);
 }
 
 Point TextBox::clip_row_col(Point rc) const {
-    if (mtext_lines.empty())
+    if (mrows.empty())
         return Point(0, 0);
 
-    if (rc.y() >= signed(mtext_lines.size()))
-        rc.set_y(signed(mtext_lines.size()) - 1);
+    if (rc.y() >= signed(mrows.size()))
+        rc.set_y(signed(mrows.size()) - 1);
     if (rc.y() < 0)
         rc.set_y(0);
 
-    int split_c = mtext_line_split_cwidth.at(rc.y()) > 0;
-    if (rc.x() >= mtext_lines_chrlen.at(rc.y()) + split_c)
-        rc.set_x(mtext_lines_chrlen.at(rc.y()) + split_c - 1);
+    const dtl::TextRow& row = mrows[rc.y()];
+    int split_c = row.split_cwidth > 0;
+    if (rc.x() >= row.chrlen + split_c)
+        rc.set_x(row.chrlen + split_c - 1);
     if (rc.x() < 0)
         rc.set_x(0);
     return rc;
@@ -943,6 +1152,7 @@ Point TextBox::clip_row_col(Point rc) const {
 void TextBox::set_wrap_mode(TextBox::WrapMode wrap_mode) {
     if (wrap_mode != mwrap_mode) {
         mwrap_mode = wrap_mode;
+        mrows_dirty = true;
         update_rows();
     }
 }
@@ -974,8 +1184,18 @@ int TextBox::text_width(const std::string& str) const {
 }
 
 Size TextBox::text_dims() const {
-    return Size(mmax_line_width + mcursor_width + mtext_margins.horz(),
-                signed(mtext_lines.size()) * line_height() + mtext_margins.vert());
+    if (msource) {
+        const int lh = line_height();
+        uint64_t h;
+        if (msource_first_line == 0 && msource_rows_reach_end)
+            h = msource_rows.size() * lh; // all of the text is visible: exact
+        else
+            h = uint64_t(mline_index.estimated_line_count()) * lh;
+        return Size(msource_max_width + mcursor_width + mtext_margins.horz(),
+                    int(std::min<uint64_t>(h + mtext_margins.vert(), INT_MAX)));
+    }
+    return Size(mrows.max_width() + mcursor_width + mtext_margins.horz(),
+                signed(mrows.size()) * line_height() + mtext_margins.vert());
 }
 
 void TextBox::position_scrollbars() {
@@ -989,10 +1209,19 @@ void TextBox::position_scrollbars() {
 
 void TextBox::x_scrolled(int new_x_pos) {
     mscroll.set_x(new_x_pos);
+    invalidate();
 }
 
 void TextBox::y_scrolled(int new_y_pos) {
     mscroll.set_y(new_y_pos);
+    invalidate();
+    if (msource) {
+        int old_max_width = msource_max_width;
+        update_source_rows();
+        // newly visible lines may be wider
+        if (msource_max_width != old_max_width && mhorz_scrollbar.is_visible())
+            setup_horz_scrollbar(text_dims().w());
+    }
 }
 
 void TextBox::scroll_up() {
@@ -45,9 +45,14 @@
 #include "scrollbar.h"
 #include "../cursorblinkhelper.h"
 #include "../widgetpc.h"
+#include "lgui/internal/piecetable.h"
+#include "lgui/internal/textrowindex.h"
+#include "lgui/internal/lineindex.h"
 
 namespace lgui {
 
+class TextSource;
+
 /** A basic multi-line text editor. */
 class TextBox : public WidgetPC {
     public:
@@ -58,7 +63,10 @@ class TextBox : public WidgetPC {
         void draw(const DrawEvent& de) const override;
 
         void set_text(const std::string& text);
-        const std::string& text() const { return mtext; }
+        /** Return the text. The text is stored in a piece table and only materialized as one string when
+         *  requested (cached until the next edit). `on_text_changed` is only emitted with the text if any slot
+         *  is connected. */
+        const std::string& text() const { return mtext.str(); }
 
         void set_font(const Font* font) override;
 
@@ -69,7 +77,17 @@ class TextBox : public WidgetPC {
         void scroll_down();
 
         void set_read_only(bool read_only);
-        bool is_read_only() const { return mread_only; }
+        bool is_read_only() const { return mread_only || msource; }
+
+        /** Display a large read-only document from `source` instead of the %TextBox's own text. The text is
+         *  not copied: lines are indexed on a background thread and only the lines within the visible window
+         *  are read and drawn, so memory usage stays proportional to the line index. The vertical scroll
+         *  position is measured in whole lines, so lines aren't wrapped in this mode, whatever the wrap mode.
+         *  There is no caret or selection either. The source must stay alive while it is set, and it is read
+         *  from the indexing thread and the GUI thread concurrently. Pass nullptr to return to editing the own
+         *  text, which will be empty. */
+        void set_source(const TextSource* source);
+        const TextSource* source() const { return msource; }
 
         /** Configures how the text is split into lines.
             With the modes `Characters` and `FittingWords`, a horizontal scroll bar will never be needed.
@@ -121,9 +139,24 @@ class TextBox : public WidgetPC {
 
         void make_rows_wordwrap(const std::string& text, int max_width, WrapMode wm);
         void make_rows_newlines(const std::string& text);
+        void make_rows(const std::string& text, int wrap_width);
 
+        int wrap_width() const;
         void do_update_rows();
-        void add_row(const std::string& text, size_t offs, size_t size, int split_c_w);
+        void update_source_rows();
+        bool scroll_source_keyboard(const KeyEvent& ke);
+        void setup_horz_scrollbar(int text_width);
+        void emit_text_changed();
+        /** Re-wrap only the paragraphs touched by an edit of mtext at byte offset `pos`, where `removed`
+         *  bytes have been replaced by `inserted` bytes. Rows of untouched paragraphs are kept. Falls back to
+         *  marking the rows dirty if they aren't up to date anyway. */
+        void rewrap_edited_rows(size_t pos, size_t removed, size_t inserted);
+        void add_row(const std::string& text, size_t offs, size_t size, int split_c_w, int width);
+        /** Return the text of a row of mrows, read from mtext. */
+        std::string row_text(size_t row) const;
+        /** Return the offset of the next (or previous) word boundary from `offs`, searching only a window
+         *  of the text around it. */
+        size_t word_boundary(size_t offs, bool backwards) const;
         bool move_caret_keyboard(const KeyEvent& ke);
         bool keyboard_hotkeys(const KeyEvent& ke);
 
@@ -160,7 +193,7 @@ class TextBox : public WidgetPC {
         void x_scrolled(int new_x_pos);
         void y_scrolled(int new_y_pos);
 
-        std::string mtext;
+        dtl::PieceTable mtext;
 
         ScrollBar mhorz_scrollbar, mvert_scrollbar;
         Padding mpadding, mscrollbar_padding, mtext_margins;
@@ -171,15 +204,22 @@ class TextBox : public WidgetPC {
 
         Point manchor_rowcol, manchor_tpx;
 
-        std::vector<std::string> mtext_lines;
-        std::vector<int> mtext_lines_chrlen; // length of lines in chrs
-        // width of chrs the lines were split at (not part of line)
-        std::vector<uint8_t> mtext_line_split_cwidth;
+        dtl::TextRowIndex mrows;
+        std::vector<dtl::TextRow> mnew_rows; // filled by add_row()
         std::vector<Rect> mselection_tpx;
 
-        int mmax_line_width;
         int mcursor_width;
         WrapMode mwrap_mode;
+        int mrows_wrap_width; // wrap width the rows have been made for
+        bool mrows_dirty;
+
+        const TextSource* msource;
+        dtl::LineIndex mline_index;
+        std::vector<dtl::TextRow> msource_rows; // rows of the visible lines only
+        std::vector<std::string> msource_row_texts; // their text, as that isn't in mtext
+        size_t msource_first_line;
+        int msource_max_width;
+        bool msource_rows_reach_end;
 
         CursorBlinkHelper mcursor_blink_helper;
 
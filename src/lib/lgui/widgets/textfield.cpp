@@ -243,6 +243,7 @@ void TextField::key_pressed(KeyEvent& event) {
 
 // cursor_pos may have changed, the rest needs to be adapted
 void TextField::maybe_scroll(bool deleted_something) {
+    invalidate();
     const int W = width() - mpadding.horz() - mcursor_width;
 
     int old_cursor_x = mcursor_pos_px - mscroll_pos_px;
@@ -534,6 +535,7 @@ void TextField::set_text(const std::string& text, bool sel_all) {
 
 void TextField::select_none() {
     msel_anchor = std::string::npos;
+    invalidate();
 }
 
 void TextField::select_all() {
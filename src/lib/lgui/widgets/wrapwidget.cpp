@@ -105,7 +105,7 @@ MeasureResults WrapWidget::measure(SizeConstraint wc, SizeConstraint hc) {
     if (!mcontent)
         return force_size_constraints(Size(mpadding.horz(), mpadding.vert()), wc, hc);
     else {
-        MeasureResults r = mcontent->measure(wc.sub(mpadding.horz()), hc.sub(mpadding.vert()));
+        MeasureResults r = mcontent->measure_cached(wc.sub(mpadding.horz()), hc.sub(mpadding.vert()));
         return force_size_constraints(mpadding.add(r), wc, hc);
     }
 }
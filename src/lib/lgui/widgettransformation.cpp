@@ -38,6 +38,7 @@
 */
 
 #include "widgettransformation.h"
+#include "widget.h"
 
 namespace lgui {
 
@@ -127,4 +128,9 @@ void WidgetTransformation::alloc() {
     mwt = std::make_unique<dtl::WidgetTransformationInternal>();
 }
 
+void WidgetTransformation::notify_owner() {
+    if (mowner)
+        mowner->_handle_transformation_change();
+}
+
 }
@@ -46,6 +46,8 @@
 
 namespace lgui {
 
+class Widget;
+
 namespace dtl {
 
 class WidgetTransformationInternal {
@@ -105,7 +107,9 @@ class WidgetTransformationInternal {
          /** Set the translation along the X and Y axes. */
         void set_translation(PointF translation) {
             maybe_alloc();
+            notify_owner();
             mwt->set_translation(translation);
+            notify_owner();
         }
 
          /** Return the translation along the X and Y axes. */
@@ -116,7 +120,9 @@ class WidgetTransformationInternal {
          /** Set the translation along the Z axis. */
         void set_translation_z(float translation_z) {
             maybe_alloc();
+            notify_owner();
             mwt->set_translation_z(translation_z);
+            notify_owner();
         }
 
          /** Return the translation along the Z axis. */
@@ -127,7 +133,9 @@ class WidgetTransformationInternal {
          /** Set the pivot (X, Y) for scaling and rotating. */
         void set_pivot(PointF pivot) {
             maybe_alloc();
+            notify_owner();
             mwt->set_pivot(pivot);
+            notify_owner();
         }
 
          /** Return the pivot for scaling and rotating. */
@@ -138,7 +146,9 @@ class WidgetTransformationInternal {
          /** Set the scale factors along the X and Y axes. */
         void set_scale(PointF scale) {
             maybe_alloc();
+            notify_owner();
             mwt->set_scale(scale);
+            notify_owner();
         }
 
          /** Return the scale factors along the X and Y axes. */
@@ -149,7 +159,9 @@ class WidgetTransformationInternal {
          /** Set the rotation around the Z axis (in degrees). */
         void set_rotation(float rotation_z) {
             maybe_alloc();
+            notify_owner();
             mwt->set_rotation(rotation_z);
+            notify_owner();
         }
 
          /** Return the rotation around the Z axis (in degrees). */
@@ -160,7 +172,9 @@ class WidgetTransformationInternal {
          /** Set the rotation around the X axis (in degrees). */
          void set_rotation_x(float rotation_x) {
             maybe_alloc();
+            notify_owner();
             mwt->set_rotation_x(rotation_x);
+            notify_owner();
         }
 
          /** Return the rotation around the X axis (in degrees). */
@@ -171,7 +185,9 @@ class WidgetTransformationInternal {
          /** Set the rotation around the Y axis (in degrees). */
         void set_rotation_y(float rotation_y) {
             maybe_alloc();
+            notify_owner();
             mwt->set_rotation_y(rotation_y);
+            notify_owner();
         }
 
          /** Return the rotation around the Y axis (in degrees). */
@@ -182,7 +198,9 @@ class WidgetTransformationInternal {
          /** Set all properties except the pivot at once. */
         void set_state(const WidgetTransformationState& state) {
             maybe_alloc();
+            notify_owner();
             mwt->set_state(state);
+            notify_owner();
         }
 
         /** Return whether the resulting transformation is the identity transformation. */
@@ -196,6 +214,9 @@ class WidgetTransformationInternal {
             return mwt ? mwt->get_inverse_transform() : Transform::get_identity();
         }
 
+         /** Set the widget to notify about changes. Called by the widget owning the transformation. */
+         void _set_owner(Widget* owner) { mowner = owner; }
+
          /** Reserve memory for transformation effects if necessary. You do not have to call this manually. */
          void maybe_alloc() {
              if (!mwt)
@@ -204,8 +225,11 @@ class WidgetTransformationInternal {
 
      private:
          void alloc();
+         // Called before and after each change, so both the old and the new area get redrawn.
+         void notify_owner();
 
          std::unique_ptr<dtl::WidgetTransformationInternal> mwt;
+         Widget* mowner = nullptr;
 };
 
 }